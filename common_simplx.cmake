@@ -109,6 +109,41 @@ function(simplx_core_add_test test_name source_file dependency)
 
 endfunction()
 
+#---- Add C++20 Unit Test ------------------------------------------------------
+
+function(simplx_core_add_cxx20_test test_name source_file dependency)
+
+	# only added to C++20 builds (e.g. -DCMAKE_CXX_FLAGS=-std=c++20): engine libraries must be compiled with the
+	# same C++ version (noexcept function types are mangled since C++17)
+	string(REGEX MATCH "-std=(c|gnu)\\+\\+(2[0-9a-z])" CXX20_MATCH "${CMAKE_CXX_FLAGS}")
+	if (NOT "${CXX20_MATCH}" STREQUAL "")
+		simplx_core_add_test(${test_name} ${source_file} "${dependency}")
+	endif()
+
+endfunction()
+
+#---- Add Benchmark ------------------------------------------------------------
+
+function(simplx_core_add_bench bench_name source_file dependency)
+
+	# built but not registered with ctest: benchmarks are run by hand, and take too long for a test run
+	add_executable(${bench_name} ${source_file})
+	simplx_core_target_link_libraries(${bench_name} "${dependency}")
+
+endfunction()
+
+#---- Add C++20 Benchmark ------------------------------------------------------
+
+function(simplx_core_add_cxx20_bench bench_name source_file dependency)
+
+	# only added to C++20 builds (see simplx_core_add_cxx20_test())
+	string(REGEX MATCH "-std=(c|gnu)\\+\\+(2[0-9a-z])" CXX20_MATCH "${CMAKE_CXX_FLAGS}")
+	if (NOT "${CXX20_MATCH}" STREQUAL "")
+		simplx_core_add_bench(${bench_name} ${source_file} "${dependency}")
+	endif()
+
+endfunction()
+
 #---- Set Link Dependencies ----------------------------------------------------
 
 function(simplx_core_target_link_libraries test_name dependency)
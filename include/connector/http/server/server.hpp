@@ -87,6 +87,16 @@ template <class _Network, class _HttpServerProcess> class HttpServer : public Tc
      */
     virtual ~HttpServer() { free(m_rootPath); }
 
+    /**
+     * @brief Pre-instantiates idle server processes (bounded by the pool capacity, see setServerProcessPoolCapacity)
+     *
+     * @param serverProcessCount
+     */
+    void reserveServerProcesses(size_t serverProcessCount)
+    {
+        parent::m_serverProcessPool.reserve(serverProcessCount, typename _HttpServerProcess::Parameters(m_rootPath));
+    }
+
     protected:
     /**
      * @brief registers service to start listening
@@ -126,7 +136,7 @@ private:
     {
         typename _HttpServerProcess::Parameters param(m_rootPath);
 
-        const Actor::ActorId &clientActorId = parent::template newUnreferencedActor<_HttpServerProcess>(param);
+        const Actor::ActorId clientActorId = parent::newServerProcess(param);
         parent::m_serverProcesses.insert(clientActorId);
 
         {
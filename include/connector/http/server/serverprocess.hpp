@@ -69,6 +69,20 @@ class HttpServerProcess : public TcpClient<_Network, _SendBufferSize, _ReceiveBu
      */
     ~HttpServerProcess() {}
 
+    /**
+     * @brief resets request parsing state (see TcpClient::recycleTcpClient)
+     * to be called by the onRecycle() of a pooled server process class (see ActorPool)
+     * 
+     */
+    void recycleHttpServerProcess(void) noexcept
+    {
+        parent::recycleTcpClient();
+        m_selfDestructAfterResponseCallback.unregister();
+        clearBuffer();
+        m_responseSentFlag = false;
+        m_bodyLengthToGet  = -1;
+    }
+
     /**
      * @brief Get Path requested by client
      * 
@@ -406,6 +406,36 @@ class TcpClient : public Actor, public IClient<_TNetwork>
      */
     void setMessageHeaderSize(size_t messageHeaderSize) { m_receiver.setHeaderSize(messageHeaderSize); }
 
+    /**
+     * @brief Set Recyclable flag
+     * used when client is spawned by server from its actor pool (see ActorPool)
+     *
+     * @param recyclable true : selfDestroy only disconnects and notifies subscribers, the subscriber then recycles
+     * this client (see ActorPool) instead of destroying it
+     * false : selfDestroy requests actor destruction
+     */
+    void setRecyclable(const bool recyclable) noexcept { m_recyclableFlag = recyclable; }
+
+    /**
+     * @brief resets the client to its freshly constructed state (keeping registered event handlers)
+     * TcpClient does not implement onRecycle() itself: pooling is opt-in, a pooled client class (see ActorPool)
+     * implements onRecycle(), resetting its own state and calling this method
+     *
+     */
+    void recycleTcpClient(void) noexcept
+    {
+        m_destroyCallback.unregister();
+        m_actorToNotifyOnDestroy.clear();
+        m_sender.clearBuffer();
+        m_receiver.reset();
+        m_connectingFlag       = false;
+        m_inSendQueueFlag      = false;
+        m_autoreadFlag         = true;
+        m_messageToReadFlag    = false;
+        m_inConnectQueueFlag   = false;
+        m_recycleRequestedFlag = false;
+    }
+
     friend Receiver<TcpClient, _ReceiveBufferSize>;
     friend _TNetwork;
 
@@ -596,6 +626,7 @@ class TcpClient : public Actor, public IClient<_TNetwork>
      * register to destruction at next callback
      * send notification at all actors subscribed
      * request to destroy
+     * (if recyclable, only disconnect socket and send notification once)
      *
      */
     void selfDestroy(void)
@@ -603,8 +634,26 @@ class TcpClient : public Actor, public IClient<_TNetwork>
 
         if (m_fd != FD_DISCONNECTED)
             disconnect();
+        if (m_recyclableFlag)
+        {
+            if (!m_recycleRequestedFlag)
+            {
+                m_recycleRequestedFlag = true;
+                notifyDestroy();
+            }
+            return;
+        }
         requestDestroy();
         registerCallback(m_destroyCallback);
+        notifyDestroy();
+    }
+
+    /**
+     * @brief send destruction notification at all actors subscribed
+     *
+     */
+    void notifyDestroy(void)
+    {
         for (const ActorId &id : m_actorToNotifyOnDestroy)
         {
             m_pipe.setDestinationActorId(id);
@@ -733,6 +782,9 @@ private:
     bool         m_messageToReadFlag  = false;
     mutable bool m_inConnectQueueFlag = false;
 
+    bool m_recyclableFlag       = false;
+    bool m_recycleRequestedFlag = false;
+
     private:
     fd_t                     m_fd            = FD_DISCONNECTED;
     static constexpr int64_t FD_DISCONNECTED = -1;
@@ -66,6 +66,18 @@ template <typename _TClient, size_t _Capacity> class Receiver
      */
     void clearBuffer(void) noexcept { m_buffer.clear(); }
 
+    /**
+     * @brief empty the buffer and forget any pending overflow message
+     * (the minimum header size is kept)
+     * 
+     */
+    void reset(void) noexcept
+    {
+        m_buffer.clear();
+        m_overflowSize             = 0;
+        m_otherCompleteMessageFlag = false;
+    }
+
     /**
      * @brief process incoming data when the buffer is not empty
      * complete the buffer with the missing part of the data (according to size read in header)
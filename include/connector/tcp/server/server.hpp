@@ -9,6 +9,7 @@
 #pragma once
 
 #include "connector/tcp/server/iserver.hpp"
+#include "pattern/actorpool.h"
 #include <chrono>
 #include <cstdint>
 #include <exception>
@@ -16,6 +17,7 @@
 #include <memory>
 #include <ostream>
 #include <tuple>
+#include <unordered_map>
 #include <unordered_set>
 
 namespace simplx
@@ -35,6 +37,7 @@ using ::std::make_tuple;
 using ::std::ostringstream;
 using ::std::shared_ptr;
 using ::std::tuple;
+using ::std::unordered_map;
 using ::std::unordered_set;
 
 /**
@@ -60,12 +63,16 @@ template <class _TNetwork, class _TServerProcess> class TcpServer : public Actor
      * @throw _TNetwork::EpollCreateException
      */
 #if __GNUC__ < 6
-    TcpServer() noexcept(false) : m_network(newReferencedSingletonActor<_TNetwork>()), m_serverProcesses()
+    TcpServer() noexcept(false)
+        : m_network(newReferencedSingletonActor<_TNetwork>()), m_serverProcesses(), m_serverProcessPool(*this, 0),
+          m_pooledServerProcesses()
     {
         registerEventHandler<typename _TServerProcess::DestroyNotificationEvent>(*this);
     }
 #else
-    TcpServer() noexcept(false) : m_network(newReferencedSingletonActor<_TNetwork>()), m_serverProcesses(getAllocator())
+    TcpServer() noexcept(false)
+        : m_network(newReferencedSingletonActor<_TNetwork>()), m_serverProcesses(getAllocator()),
+          m_serverProcessPool(*this, 0), m_pooledServerProcesses(getAllocator())
     {
         registerEventHandler<typename _TServerProcess::DestroyNotificationEvent>(*this);
     }
@@ -73,13 +80,19 @@ template <class _TNetwork, class _TServerProcess> class TcpServer : public Actor
 
     /**
      * @brief callback called when the DestroyNotificationEvent event is received
-     * remove the ServerProcess from the map of active ServerProcess
+     * remove the ServerProcess from the map of active ServerProcess (giving it back to the pool if pooled)
      * then call the higher level callback onServerProcessDestroy
      *
      * @param e the notification event
      */
     void onEvent(const typename _TServerProcess::DestroyNotificationEvent &e)
     {
+        auto pooled = m_pooledServerProcesses.find(e.getSourceActorId());
+        if (pooled != m_pooledServerProcesses.end())
+        {
+            releaseServerProcess(pooled->second, IsRecyclableActor<_TServerProcess>());
+            m_pooledServerProcesses.erase(pooled);
+        }
         m_serverProcesses.erase(e.getSourceActorId());
         onServerProcessDestroy(e.getSourceActorId());
     }
@@ -151,6 +164,32 @@ template <class _TNetwork, class _TServerProcess> class TcpServer : public Actor
      */
     void setMessageHeaderSize(size_t messageHeaderSize) { m_messageHeaderSize = messageHeaderSize; }
 
+    /**
+     * @brief Sets maximum number of idle server processes kept for reuse by new connections
+     * (0, the default, disables pooling: each connection gets a new server process destroyed on disconnection)
+     * _TServerProcess must implement onRecycle() (see ActorPool)
+     *
+     * @attention a pooled server process keeps its ActorId from one connection to the next: events pushed to it
+     * for a previous connection, and still in flight, are delivered to the server process of the next connection
+     *
+     * @param capacity
+     *
+     * @throw std::bad_alloc
+     */
+    void setServerProcessPoolCapacity(size_t capacity)
+    {
+        static_assert(IsRecyclableActor<_TServerProcess>::value,
+                      "template parameter 2 [_TServerProcess] must implement onRecycle() to be pooled");
+        m_serverProcessPool.setCapacity(capacity);
+    }
+
+    /**
+     * @brief Pre-instantiates idle server processes (bounded by the pool capacity)
+     *
+     * @param serverProcessCount
+     */
+    void reserveServerProcesses(size_t serverProcessCount) { m_serverProcessPool.reserve(serverProcessCount); }
+
     protected:
     friend _TNetwork;
 
@@ -206,7 +245,47 @@ template <class _TNetwork, class _TServerProcess> class TcpServer : public Actor
      */
     virtual const ListenParam &getListenParam(void) const noexcept override { return m_listenParam; }
 
+    /**
+     * @brief instantiate (or take from the pool if enabled) a server process
+     *
+     * @return const ActorId id of the server process
+     */
+    ActorId newServerProcess(void)
+    {
+        if (m_serverProcessPool.getCapacity() == 0)
+            return newUnreferencedActor<_TServerProcess>();
+        return addPooledServerProcess(m_serverProcessPool.acquire());
+    }
+
+    /**
+     * @brief instantiate (or take from the pool if enabled) a server process
+     *
+     * @param init server process constructor parameter (unused if taken from the pool)
+     * @return const ActorId id of the server process
+     */
+    template <class _TServerProcessInit> ActorId newServerProcess(const _TServerProcessInit &init)
+    {
+        if (m_serverProcessPool.getCapacity() == 0)
+            return newUnreferencedActor<_TServerProcess>(init);
+        return addPooledServerProcess(m_serverProcessPool.acquire(init));
+    }
+
     private:
+    ActorId addPooledServerProcess(ActorReference<_TServerProcess> ref)
+    {
+        ref->setRecyclable(true);
+        m_pooledServerProcesses.insert(std::make_pair(ref->getActorId(), ref));
+        return ref->getActorId();
+    }
+
+    void releaseServerProcess(const ActorReference<_TServerProcess> &ref, std::true_type) noexcept
+    {
+        m_serverProcessPool.release(ref);
+    }
+
+    // never pooled (see setServerProcessPoolCapacity)
+    void releaseServerProcess(const ActorReference<_TServerProcess> &, std::false_type) noexcept {}
+
     /**
      * @brief low-level callback triggered upon accepted new client
      *
@@ -217,8 +296,7 @@ template <class _TNetwork, class _TServerProcess> class TcpServer : public Actor
     void onNewConnectionBase(const fd_t fd, const char *serverProcessIp) noexcept override
     {
         (void)serverProcessIp;
-        const ActorId &serverProcessActorId =
-            newUnreferencedActor<_TServerProcess>(); // instantiate actor handling said socket
+        const ActorId serverProcessActorId = newServerProcess(); // instantiate actor handling said socket
         m_serverProcesses.insert(serverProcessActorId);
 
         {
@@ -269,6 +347,14 @@ template <class _TNetwork, class _TServerProcess> class TcpServer : public Actor
     unordered_set<ActorId> m_serverProcesses;
 #else
     unordered_set<ActorId, hash<ActorId>, equal_to<ActorId>, Allocator<ActorId>> m_serverProcesses;
+#endif
+    ActorPool<_TServerProcess> m_serverProcessPool;
+#if __GNUC__ < 6
+    unordered_map<ActorId, ActorReference<_TServerProcess>> m_pooledServerProcesses;
+#else
+    unordered_map<ActorId, ActorReference<_TServerProcess>, hash<ActorId>, equal_to<ActorId>,
+                  Allocator<std::pair<const ActorId, ActorReference<_TServerProcess>>>>
+        m_pooledServerProcesses;
 #endif
     ListenParam m_listenParam;
 
@@ -0,0 +1,190 @@
+/**
+ * @file actorpool.h
+ * @brief per-core pool of recyclable actors
+ * @copyright 2019 Scalewatch (www.scalewatch.com). All rights reserved.
+ * Please see accompanying LICENSE file for licensing terms.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+#include "simplx_core/actor.h"
+
+namespace simplx
+{
+
+/**
+ * @brief Pool of idle actors of type _Actor, ran by the same event-loop (cpu-core) as the owner actor.
+ *
+ * Actors that are repeatedly created and destroyed (e.g. one actor per network connection) pay for their
+ * construction, event-handlers registration and destruction each time. Instead, an ActorPool hands out idle
+ * actors (acquire()) and takes them back once done (release()), only creating new ones when empty.
+ * _Actor must publicly implement <code>void onRecycle() noexcept</code>, which is called by release() and must
+ * return the actor to its freshly constructed state (registered event-handlers may be kept).
+ * <br>Example:
+ * \code
+ * class MyProcess : public simplx::Actor {
+ * public:
+ *     void onRecycle() noexcept;
+ * };
+ * class MyServer : public simplx::Actor {
+ *     simplx::ActorPool<MyProcess> pool;
+ * public:
+ *     MyServer() : pool(*this, 64) { pool.reserve(16); }
+ * };
+ * \endcode
+ * @note Pooled actors are created using Actor::newReferencedActor(): they are destroyed when the pool is destroyed,
+ * unless still referenced elsewhere.
+ * @attention A released actor must not have requested its own destruction (see Actor::requestDestroy()).
+ * @attention A recycled actor keeps its actor-id: events pushed to it before release() and still in flight are
+ * delivered to its next user. Actors whose peers may push such stale events must tell them apart, e.g. by carrying
+ * a generation number (incremented by onRecycle()) in their events.
+ */
+template <class _Actor> class ActorPool
+{
+  public:
+    typedef Actor::ActorReference<_Actor> ActorReference;
+
+    /**
+     * @brief Constructor.
+     * @param powner actor creating the pooled actors, which are ran by the same event-loop
+     * @param capacity maximum idle actor count (0 disables pooling: acquire() always creates a new actor)
+     * @throw std::bad_alloc
+     */
+    inline ActorPool(Actor &powner, size_t pcapacity)
+        : owner(powner), idleActors(powner.getAllocator()), capacity(pcapacity), newCount(0), recycleCount(0)
+    {
+        idleActors.reserve(capacity);
+    }
+    /**
+     * @brief Returns an idle actor, or a new one if none.
+     * @return An actor-reference to the acquired actor.
+     * @throw As Actor::newReferencedActor() if a new actor is created.
+     */
+    inline ActorReference acquire() { return idleActors.empty() ? newActor() : popIdleActor(); }
+    /**
+     * @brief Returns an idle actor, or a new one constructed from actorInit if none.
+     * @param actorInit constructor argument of a new actor
+     * @return An actor-reference to the acquired actor.
+     * @throw As Actor::newReferencedActor(const _ActorInit&) if a new actor is created.
+     */
+    template <class _ActorInit> inline ActorReference acquire(const _ActorInit &actorInit)
+    {
+        return idleActors.empty() ? newActor(actorInit) : popIdleActor();
+    }
+    /**
+     * @brief Recycles an acquired actor (see _Actor::onRecycle()), and keeps it idle if the pool is not full.
+     * The actor must not be used anymore by the caller.
+     * @param actorReference actor-reference returned by acquire()
+     * @return true if kept, false if the pool is full (the actor is destroyed once unreferenced).
+     */
+    inline bool release(ActorReference actorReference) noexcept
+    {
+        assert(actorReference.get() != 0);
+        assert(actorReference->getActorId().isSameCoreAs(owner.getActorId()));
+        if (idleActors.size() >= capacity)
+        {
+            return false;
+        }
+        actorReference->onRecycle();
+        idleActors.push_back(actorReference); // never reallocates (capacity reserved)
+        ++recycleCount;
+        return true;
+    }
+    /**
+     * @brief Creates idle actors up to actorCount (bounded by the capacity).
+     * @throw As Actor::newReferencedActor()
+     */
+    inline void reserve(size_t actorCount)
+    {
+        for (; idleActors.size() < std::min(actorCount, capacity);)
+        {
+            idleActors.push_back(newActor());
+        }
+    }
+    /**
+     * @brief Creates idle actors constructed from actorInit up to actorCount (bounded by the capacity).
+     * @throw As Actor::newReferencedActor(const _ActorInit&)
+     */
+    template <class _ActorInit> inline void reserve(size_t actorCount, const _ActorInit &actorInit)
+    {
+        for (; idleActors.size() < std::min(actorCount, capacity);)
+        {
+            idleActors.push_back(newActor(actorInit));
+        }
+    }
+    /**
+     * @brief Sets the capacity, idle actors in excess being released.
+     * @throw std::bad_alloc
+     */
+    inline void setCapacity(size_t pcapacity)
+    {
+        if (pcapacity > idleActors.capacity())
+        {
+            idleActors.reserve(pcapacity);
+        }
+        else if (pcapacity < idleActors.size())
+        {
+            idleActors.erase(idleActors.begin() + pcapacity, idleActors.end());
+        }
+        capacity = pcapacity;
+    }
+    /** @brief Maximum idle actor count */
+    inline size_t getCapacity() const noexcept { return capacity; }
+    /** @brief Current idle actor count */
+    inline size_t getIdleCount() const noexcept { return idleActors.size(); }
+    /** @brief Actors created by this pool so far */
+    inline uint64_t getNewCount() const noexcept { return newCount; }
+    /** @brief Actors recycled by this pool so far */
+    inline uint64_t getRecycleCount() const noexcept { return recycleCount; }
+
+  private:
+    typedef std::vector<ActorReference, Actor::Allocator<ActorReference>> IdleActorVector;
+
+    Actor &owner;
+    IdleActorVector idleActors; // LIFO for cache warmth, reserved up to capacity
+    size_t capacity;
+    uint64_t newCount;
+    uint64_t recycleCount;
+
+    ActorPool(const ActorPool &);
+    void operator=(const ActorPool &);
+    inline ActorReference popIdleActor() noexcept
+    {
+        ActorReference ret = idleActors.back();
+        idleActors.pop_back();
+        return ret;
+    }
+    inline ActorReference newActor()
+    {
+        ActorReference ret = owner.newReferencedActor<_Actor>();
+        ++newCount;
+        return ret;
+    }
+    template <class _ActorInit> inline ActorReference newActor(const _ActorInit &actorInit)
+    {
+        ActorReference ret = owner.newReferencedActor<_Actor>(actorInit);
+        ++newCount;
+        return ret;
+    }
+};
+
+struct IsRecyclableActorTest
+{
+    template <class T> static char test(decltype(&T::onRecycle));
+    template <class T> static long test(...);
+};
+
+/**
+ * @brief std::true_type if _Actor implements onRecycle() (see ActorPool), std::false_type otherwise.
+ */
+template <class _Actor>
+struct IsRecyclableActor
+    : std::integral_constant<bool, sizeof(IsRecyclableActorTest::test<_Actor>(0)) == sizeof(char)>
+{
+};
+
+} // namespace simplx
@@ -0,0 +1,482 @@
+/**
+ * @file coroutine.h
+ * @brief C++20 coroutine request/response between actors, on top of Actor::Event::Pipe
+ * @copyright 2019 Scalewatch (www.scalewatch.com). All rights reserved.
+ * Please see accompanying LICENSE file for licensing terms.
+ */
+
+#pragma once
+
+#if !defined(__cpp_impl_coroutine) || !__has_include(<coroutine>)
+#error "pattern/coroutine.h requires C++20 coroutines (e.g. -std=c++20)"
+#endif
+
+#include <coroutine>
+#include <exception>
+#include <map>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "simplx_core/engine.h"
+#include "pattern/timer/timerproxy.h"
+
+namespace simplx
+{
+namespace coroutine
+{
+
+typedef uint64_t RequestId; ///< Scalar type matching a response to its request, unique per Requester.
+
+/**
+ * @brief Base-class of the request events pushed using RequestPipe::request().
+ * The request-id must be the first argument of the sub-class constructor.
+ */
+struct RequestEvent : Actor::Event
+{
+    const RequestId requestId;
+    inline RequestEvent(RequestId prequestId) noexcept : requestId(prequestId) {}
+};
+
+/**
+ * @brief Base-class of the response events pushed back to a Requester (see reply()).
+ * The request-id must be the first argument of the sub-class constructor.
+ */
+struct ResponseEvent : Actor::Event
+{
+    const RequestId requestId;
+    inline ResponseEvent(RequestId prequestId) noexcept : requestId(prequestId) {}
+};
+
+/**
+ * @brief Thrown from co_await when the request event could not be delivered.
+ */
+struct UndeliveredException : std::exception
+{
+    virtual const char *what() const noexcept { return "simplx::coroutine::UndeliveredException"; }
+};
+
+/**
+ * @brief Thrown from co_await when no response was received within the timeout (see RequestPipe::setTimeout()).
+ */
+struct TimeoutException : std::exception
+{
+    virtual const char *what() const noexcept { return "simplx::coroutine::TimeoutException"; }
+};
+
+class Requester;
+class RequestPipe;
+
+/**
+ * @brief Return type of the coroutines of a Requester, started using Requester::spawn().
+ * The coroutine must be a member function of a Requester sub-class (or take a Requester as first argument): its
+ * frame is allocated from the event-loop (cpu-core) allocator of that actor.
+ * Destroying a Task which was not spawned destroys its coroutine.
+ */
+class Task
+{
+  public:
+    /**
+     * @brief Non-template base-class of Promise.
+     */
+    class PromiseBase
+    {
+      public:
+        inline std::suspend_always initial_suspend() const noexcept { return std::suspend_always(); }
+        inline std::suspend_never final_suspend() const noexcept { return std::suspend_never(); }
+        inline void return_void() const noexcept {}
+        inline void unhandled_exception() noexcept;
+
+      protected:
+        static const size_t FRAME_HEADER_SIZE = alignof(std::max_align_t); // holds the frame allocator
+
+        inline PromiseBase(Requester &prequester) noexcept : requester(prequester) {}
+        inline static void *allocateFrame(Requester &requester, size_t size); // throw (std::bad_alloc)
+        inline static void deallocateFrame(void *p, size_t size) noexcept;
+
+      private:
+        friend class Requester;
+        Requester &requester;
+    };
+    /**
+     * @brief Promise type of a coroutine of _Requester taking _Args (see std::coroutine_traits<Task, ...>).
+     * Being a class template rather than member templates, its operator new and operator delete match
+     * (see -Wmismatched-new-delete).
+     */
+    template <class _Requester, class... _Args> class Promise : public PromiseBase
+    {
+        static_assert(std::is_base_of<Requester, _Requester>::value, "Task must be a coroutine of a Requester");
+
+      public:
+        inline Promise(_Requester &prequester, _Args &...) noexcept : PromiseBase(prequester) {}
+        inline Task get_return_object() noexcept
+        {
+            return Task(std::coroutine_handle<Promise>::from_promise(*this), *this);
+        }
+        /**
+         * throw (std::bad_alloc)
+         */
+        inline static void *operator new(size_t size, _Requester &requester, _Args &...)
+        {
+            return allocateFrame(requester, size);
+        }
+        inline static void operator delete(void *p, size_t size) noexcept { deallocateFrame(p, size); }
+    };
+
+    inline Task(Task &&other) noexcept
+        : handle(std::exchange(other.handle, nullptr)), promise(std::exchange(other.promise, nullptr))
+    {
+    }
+    inline ~Task() noexcept
+    {
+        if (handle)
+        {
+            handle.destroy();
+        }
+    }
+
+  private:
+    friend class Requester;
+    std::coroutine_handle<> handle;
+    PromiseBase *promise;
+
+    inline Task(std::coroutine_handle<> phandle, PromiseBase &ppromise) noexcept : handle(phandle), promise(&ppromise)
+    {
+    }
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+};
+
+/**
+ * @brief Non-template base-class of RequestAwaiter.
+ */
+class RequestAwaiterBase
+{
+  public:
+    inline bool await_ready() const noexcept { return false; }
+    /**
+     * throw (std::bad_alloc, timer::TimerProxy::NoServiceException)
+     */
+    inline void await_suspend(std::coroutine_handle<> phandle);
+
+  protected:
+    const Actor::Event *response;
+
+    inline RequestAwaiterBase(Requester &prequester, RequestId prequestId, const Time &ptimeout) noexcept
+        : response(0), requester(prequester), requestId(prequestId), timeout(ptimeout), status(PENDING)
+    {
+    }
+    /**
+     * throw (UndeliveredException, TimeoutException)
+     */
+    inline void checkStatus() const;
+
+  private:
+    friend class Requester;
+    enum Status
+    {
+        PENDING,
+        RESPONDED,
+        UNDELIVERED,
+        TIMED_OUT
+    };
+    class Timer : public timer::TimerProxy
+    {
+      public:
+        inline Timer(RequestAwaiterBase &); // throw (std::bad_alloc, timer::TimerProxy::NoServiceException)
+
+      private:
+        RequestAwaiterBase &awaiter;
+        inline void onTimeout(const DateTime &) noexcept override;
+    };
+
+    Requester &requester;
+    const RequestId requestId;
+    const Time timeout;
+    std::coroutine_handle<> handle;
+    Status status;
+    std::optional<Timer> timer;
+
+    RequestAwaiterBase(const RequestAwaiterBase &) = delete;
+    RequestAwaiterBase &operator=(const RequestAwaiterBase &) = delete;
+};
+
+/**
+ * @brief Awaitable returned by RequestPipe::request(), to be immediately co_awaited.
+ * co_await returns the _Response event, which is only valid until the next suspension of the coroutine.
+ */
+template <class _Response> class RequestAwaiter : public RequestAwaiterBase
+{
+  public:
+    /**
+     * throw (UndeliveredException, TimeoutException)
+     */
+    inline const _Response &await_resume() const
+    {
+        checkStatus();
+        return static_cast<const _Response &>(*response);
+    }
+
+  private:
+    friend class RequestPipe;
+
+    inline RequestAwaiter(Requester &prequester, RequestId prequestId, const Time &ptimeout) noexcept
+        : RequestAwaiterBase(prequester, prequestId, ptimeout)
+    {
+    }
+};
+
+/**
+ * @brief Actor issuing requests from coroutines, instead of registering response event-handlers and matching
+ * responses to per-request states by hand.
+ *
+ * Example:
+ * \code
+ * struct Client : simplx::coroutine::Requester {
+ *     Client(const simplx::Actor::ActorId &serverId) { spawn(run(serverId)); }
+ *     simplx::coroutine::Task run(simplx::Actor::ActorId serverId) {
+ *         simplx::coroutine::RequestPipe pipe(*this, serverId);
+ *         const ValueEvent &value = co_await pipe.request<GetEvent, ValueEvent>(key);
+ *         ...
+ *     }
+ * };
+ * \endcode
+ * A coroutine is resumed from the event-handler of the response, within the event-loop running this actor. Any
+ * exception escaping a resumed coroutine is then handled like an exception escaping that event-handler (see
+ * AsyncExceptionHandler).
+ * @attention This class registers the event-handlers of the response events and the undelivered event-handlers
+ * of the request events: sub-classes must not register handlers for them.
+ * Destroying this actor destroys its suspended coroutines.
+ */
+class Requester : public Actor
+{
+  protected:
+    /**
+     * throw (std::bad_alloc)
+     */
+    inline Requester() : lastRequestId(0), awaiterMap(AwaiterMap::key_compare(), getAllocator()), dispatcher(*this)
+    {
+        registerEventHandler<TimeoutEvent>(dispatcher);
+    }
+    virtual ~Requester() noexcept
+    {
+        AwaiterMap awaiters(AwaiterMap::key_compare(), getAllocator());
+        awaiters.swap(awaiterMap);
+        for (AwaiterMap::iterator i = awaiters.begin(), endi = awaiters.end(); i != endi; ++i)
+        {
+            i->second->handle.destroy();
+        }
+    }
+    /**
+     * @brief Starts a coroutine of this actor, which runs until its first co_await.
+     * @param task coroutine to be started.
+     * @throw ? Any exception escaping the coroutine before its first co_await.
+     */
+    inline void spawn(Task &&task)
+    {
+        std::coroutine_handle<> handle = std::exchange(task.handle, nullptr);
+        assert(handle);
+        assert(&task.promise->requester == this);
+        resume(handle);
+    }
+
+  private:
+    friend class Task::PromiseBase;
+    friend class RequestAwaiterBase;
+    friend class RequestPipe;
+    struct TimeoutEvent : Event
+    {
+        const RequestId requestId;
+        inline TimeoutEvent(RequestId prequestId) noexcept : requestId(prequestId) {}
+    };
+    struct Dispatcher
+    {
+        Requester &requester;
+        inline Dispatcher(Requester &prequester) noexcept : requester(prequester) {}
+        template <class _Response> inline void onEvent(const _Response &event)
+        {
+            requester.resume(event.requestId, RequestAwaiterBase::RESPONDED, &event);
+        }
+        inline void onEvent(const TimeoutEvent &event)
+        {
+            requester.resume(event.requestId, RequestAwaiterBase::TIMED_OUT, 0);
+        }
+        template <class _Request> inline void onUndeliveredEvent(const _Request &event)
+        {
+            requester.resume(event.requestId, RequestAwaiterBase::UNDELIVERED, 0);
+        }
+    };
+    typedef std::map<RequestId, RequestAwaiterBase *, std::less<RequestId>,
+                     Allocator<std::pair<const RequestId, RequestAwaiterBase *>>>
+        AwaiterMap;
+
+    RequestId lastRequestId;
+    AwaiterMap awaiterMap;
+    Dispatcher dispatcher;
+    std::exception_ptr exception; // escaped from the last resumed coroutine
+
+    inline void resume(std::coroutine_handle<> handle)
+    {
+        handle.resume();
+        if (exception)
+        {
+            std::rethrow_exception(std::exchange(exception, nullptr));
+        }
+    }
+    inline void resume(RequestId requestId, RequestAwaiterBase::Status status, const Event *response)
+    {
+        AwaiterMap::iterator i = awaiterMap.find(requestId);
+        if (i == awaiterMap.end())
+        {
+            return; // already resumed (e.g. response after time-out)
+        }
+        RequestAwaiterBase &awaiter = *i->second;
+        awaiterMap.erase(i);
+        awaiter.status = status;
+        awaiter.response = response;
+        resume(awaiter.handle);
+    }
+};
+
+/**
+ * @brief Event::Pipe issuing requests awaited by the coroutines of a Requester.
+ * Request events are never delivered directly (see Actor::Event::Pipe::setDirectDeliveryFlag()).
+ */
+class RequestPipe : public Actor::Event::Pipe
+{
+  public:
+    inline RequestPipe(Requester &prequester, const Actor::ActorId &destinationActorId = Actor::ActorId()) noexcept
+        : Pipe(prequester, destinationActorId), requester(prequester)
+    {
+    }
+    /**
+     * @brief Set the time-out of the next requests, after which co_await throws TimeoutException.
+     * A time-out requires the timer service (see timer::TimerActor).
+     * By default Time() is used (no time-out).
+     * @param ptimeout time-out
+     */
+    inline void setTimeout(const Time &ptimeout) noexcept { timeout = ptimeout; }
+    /**
+     * @return time-out of the next requests
+     */
+    inline const Time &getTimeout() const noexcept { return timeout; }
+    /**
+     * @brief Pushes a _Request event, constructed with a new request-id followed by args, to be co_awaited for
+     * the _Response event pushed back with the same request-id (see reply()).
+     * @return awaitable, to be immediately co_awaited.
+     * @throw std::bad_alloc
+     */
+    template <class _Request, class _Response, class... _Args>
+    inline RequestAwaiter<_Response> request(_Args &&... args)
+    {
+        static_assert(std::is_base_of<RequestEvent, _Request>::value, "_Request must derive from RequestEvent");
+        static_assert(std::is_base_of<ResponseEvent, _Response>::value, "_Response must derive from ResponseEvent");
+        if (!requester.isRegisteredEventHandler<_Response>())
+        {
+            requester.registerEventHandler<_Response>(requester.dispatcher);
+        }
+        if (!requester.isRegisteredUndeliveredEventHandler<_Request>())
+        {
+            requester.registerUndeliveredEventHandler<_Request>(requester.dispatcher);
+        }
+        RequestId requestId = ++requester.lastRequestId;
+        bool directDeliveryFlag = isDirectDelivery();
+        setDirectDeliveryFlag(false); // the response must not be received before suspension
+        try
+        {
+            push<_Request>(requestId, std::forward<_Args>(args)...);
+        }
+        catch (...)
+        {
+            setDirectDeliveryFlag(directDeliveryFlag);
+            throw;
+        }
+        setDirectDeliveryFlag(directDeliveryFlag);
+        return RequestAwaiter<_Response>(requester, requestId, timeout);
+    }
+
+  private:
+    Requester &requester;
+    Time timeout;
+};
+
+/**
+ * @brief Pushes a _Response event, constructed with the request-id of request followed by args, back to the
+ * Requester of request.
+ * @throw std::bad_alloc
+ */
+template <class _Response, class... _Args>
+inline void reply(Actor &actor, const RequestEvent &request, _Args &&... args)
+{
+    Actor::Event::Pipe(actor, request.getSourceActorId()).push<_Response>(request.requestId, std::forward<_Args>(args)...);
+}
+
+void Task::PromiseBase::unhandled_exception() noexcept { requester.exception = std::current_exception(); }
+
+void *Task::PromiseBase::allocateFrame(Requester &requester, size_t size)
+{
+    Actor::Allocator<char> allocator(requester.getAllocator());
+    char *frame = allocator.allocate(FRAME_HEADER_SIZE + size);
+    new (frame) Actor::Allocator<char>(allocator);
+    return frame + FRAME_HEADER_SIZE;
+}
+
+void Task::PromiseBase::deallocateFrame(void *p, size_t size) noexcept
+{
+    char *frame = static_cast<char *>(p) - FRAME_HEADER_SIZE;
+    Actor::Allocator<char> allocator(*reinterpret_cast<Actor::Allocator<char> *>(frame));
+    allocator.deallocate(frame, FRAME_HEADER_SIZE + size);
+}
+
+void RequestAwaiterBase::await_suspend(std::coroutine_handle<> phandle)
+{
+    if (timeout != Time())
+    {
+        timer.emplace(*this);
+        timer->set(timeout);
+    }
+    requester.awaiterMap.insert(std::make_pair(requestId, this));
+    handle = phandle;
+}
+
+void RequestAwaiterBase::checkStatus() const
+{
+    assert(status != PENDING);
+    if (status == UNDELIVERED)
+    {
+        throw UndeliveredException();
+    }
+    if (status == TIMED_OUT)
+    {
+        throw TimeoutException();
+    }
+}
+
+RequestAwaiterBase::Timer::Timer(RequestAwaiterBase &pawaiter) : TimerProxy(pawaiter.requester), awaiter(pawaiter) {}
+
+void RequestAwaiterBase::Timer::onTimeout(const DateTime &) noexcept
+{
+    try
+    {
+        Actor::Event::Pipe(awaiter.requester, awaiter.requester.getActorId())
+            .push<Requester::TimeoutEvent>(awaiter.requestId);
+    }
+    catch (std::bad_alloc &)
+    {
+        setNow(); // try again
+    }
+}
+
+} // namespace coroutine
+} // namespace simplx
+
+/**
+ * Task coroutines are member functions of a Requester sub-class, or take a Requester as first argument.
+ */
+namespace std
+{
+template <class _Requester, class... _Args> struct coroutine_traits<simplx::coroutine::Task, _Requester &, _Args...>
+{
+    typedef simplx::coroutine::Task::Promise<_Requester, _Args...> promise_type;
+};
+} // namespace std
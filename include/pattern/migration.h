@@ -0,0 +1,656 @@
+/**
+ * @file migration.h
+ * @brief runtime actor migration between cores, and load balancer
+ * @copyright 2019 Scalewatch (www.scalewatch.com). All rights reserved.
+ * Please see accompanying LICENSE file for licensing terms.
+ */
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "simplx_core/engine.h"
+
+namespace simplx
+{
+namespace migration
+{
+
+/**
+ * @brief Balancer policy (see Balancer and addBalancer()).
+ *
+ * Every period, the balancer samples each core loop usage ratio (delta of CorePerformanceCounters::getLoopUsageCount()
+ * over delta of CorePerformanceCounters::getLoopTotalCount()). When the hottest core usage ratio exceeds the coldest
+ * one by at least loopUsageGap, the heaviest migratable actor (see MigratableBase::setMigrationWeight()) of the
+ * hottest core is migrated to the coldest core, if the hottest core runs at least 2 migratable actors.
+ * By default (period is Time()) the balancer does not sample, and only serves MigratableBase::migrate() requests.
+ */
+struct BalancerPolicy
+{
+    Time period;
+    double loopUsageGap;
+    inline BalancerPolicy() noexcept : loopUsageGap(0) {}
+    inline BalancerPolicy(const Time &pperiod, double ploopUsageGap = .25) noexcept
+        : period(pperiod), loopUsageGap(ploopUsageGap)
+    {
+    }
+};
+
+/**
+ * @brief Service-tag of the Balancer.
+ */
+struct BalancerService : Service
+{
+    inline static const char *name() noexcept { return "simplx::migration::BalancerService"; }
+};
+
+/**
+ * @brief Notification sent by a migrated actor to its subscribers (see MigratableBase::registerMigrationNotification())
+ * once its state was restored on the target core.
+ * Events pushed to the previous actor-id are returned to their sender (see Actor::registerUndeliveredEventHandler())
+ * which can push them again to the new actor-id.
+ * When the migration failed, actorId is previousActorId: the actor was not moved (or was rolled back),
+ * and events returned meanwhile can be pushed again to the same actor-id.
+ */
+struct MigratedEvent : Actor::Event
+{
+    const Actor::ActorId previousActorId;
+    const Actor::ActorId actorId; ///< null if the actor state could not be restored (the actor is lost)
+    inline MigratedEvent(const Actor::ActorId &ppreviousActorId, const Actor::ActorId &pactorId) noexcept
+        : previousActorId(ppreviousActorId), actorId(pactorId)
+    {
+    }
+};
+
+class MigratableBase;
+
+/**
+ * @brief Per-core singleton actor running migrations from and to its core.
+ * Agents register to the Balancer service at construction.
+ */
+class Agent : public Actor
+{
+  public:
+    struct RegisterEvent : Event
+    {
+    };
+    struct SampleRequestEvent : Event
+    {
+    };
+    struct SampleEvent : Event
+    {
+        const uint64_t loopUsageCount;
+        const uint64_t loopTotalCount;
+        const size_t migratableCount;
+        inline SampleEvent(uint64_t ploopUsageCount, uint64_t ploopTotalCount, size_t pmigratableCount) noexcept
+            : loopUsageCount(ploopUsageCount), loopTotalCount(ploopTotalCount), migratableCount(pmigratableCount)
+        {
+        }
+    };
+    /**
+     * Migrates actorId (or the heaviest migratable actor if null) to the core of targetAgentId.
+     */
+    struct MigrateRequestEvent : Event
+    {
+        const ActorId actorId;
+        const ActorId targetAgentId;
+        inline MigrateRequestEvent(const ActorId &pactorId, const ActorId &ptargetAgentId) noexcept
+            : actorId(pactorId), targetAgentId(ptargetAgentId)
+        {
+        }
+    };
+    /**
+     * Serialized actor state, restored by the target agent which deletes it (otherwise returned to the migrating
+     * actor, which still owns it).
+     */
+    struct RestoreEvent : Event
+    {
+        typedef ActorId (*NewActorFunction)(Agent &, void *transit);
+        typedef void (*DeleteTransitFunction)(void *);
+        const NewActorFunction newActor;
+        const DeleteTransitFunction deleteTransit;
+        void *const transit;
+        inline RestoreEvent(NewActorFunction pnewActor, DeleteTransitFunction pdeleteTransit, void *ptransit) noexcept
+            : newActor(pnewActor), deleteTransit(pdeleteTransit), transit(ptransit)
+        {
+        }
+    };
+    struct RestoredEvent : Event
+    {
+        const ActorId actorId;
+        inline RestoredEvent(const ActorId &pactorId) noexcept : actorId(pactorId) {}
+    };
+
+    inline Agent() : migratables(getAllocator()), restoreSubscribers(0), restoreWeight(0)
+    {
+        registerEventHandler<SampleRequestEvent>(*this);
+        registerEventHandler<MigrateRequestEvent>(*this);
+        registerEventHandler<RestoreEvent>(*this);
+        const ActorId &balancerActorId = getEngine().getServiceIndex().getServiceActorId<BalancerService>();
+        if (balancerActorId != null)
+        {
+            Event::Pipe(*this, balancerActorId).push<RegisterEvent>();
+        }
+    }
+    inline void onEvent(const SampleRequestEvent &event)
+    {
+        Event::Pipe(*this, event.getSourceActorId())
+            .push<SampleEvent>(getCorePerformanceCounters().getLoopUsageCount(),
+                               getCorePerformanceCounters().getLoopTotalCount(), migratables.size());
+    }
+    inline void onEvent(const MigrateRequestEvent &event);
+    inline void onEvent(const RestoreEvent &event);
+
+  private:
+    friend class MigratableBase;
+    typedef std::vector<MigratableBase *, Allocator<MigratableBase *>> MigratableVector;
+    typedef std::vector<ActorId> SubscriberVector;
+
+    MigratableVector migratables;
+    const SubscriberVector *restoreSubscribers; // handed over to the actor being restored
+    uint64_t restoreWeight;
+};
+
+/**
+ * @brief Base-class of migratable actors (see Migratable).
+ */
+class MigratableBase : public Actor
+{
+  public:
+    /**
+     * @brief Requests the Balancer service to migrate this actor to coreId.
+     * The migration fails (see MigratedEvent) if coreId is neither part of the addBalancer() core-set nor already
+     * running an agent.
+     * @throw std::bad_alloc
+     */
+    inline void migrate(CoreId coreId)
+    {
+        const ActorId &balancerActorId = getEngine().getServiceIndex().getServiceActorId<BalancerService>();
+        assert(balancerActorId != null);
+        Event::Pipe(*this, balancerActorId).push<MigrateRequestEvent>(coreId);
+    }
+    /**
+     * @brief Subscribes actorId to MigratedEvent. Subscribers are migrated along with the actor.
+     * @throw std::bad_alloc
+     */
+    inline void registerMigrationNotification(const ActorId &actorId) { subscribers.push_back(actorId); }
+    /**
+     * @brief Sets this actor relative load, the balancer migrating the heaviest actor of the hottest core (default 1).
+     * The weight is migrated along with the actor.
+     */
+    inline void setMigrationWeight(uint64_t pweight) noexcept { weight = pweight; }
+    inline uint64_t getMigrationWeight() const noexcept { return weight; }
+    /**
+     * @brief Getter.
+     * @return true from state serialization to destruction or roll back (no event-handler is registered meanwhile).
+     */
+    inline bool isMigrating() const noexcept { return migratingFlag; }
+    inline void onEvent(const Agent::RestoredEvent &event);
+    inline void onUndeliveredEvent(const Agent::RestoreEvent &event);
+
+    /**
+     * Sent to the Balancer service.
+     */
+    struct MigrateRequestEvent : Event
+    {
+        const CoreId coreId;
+        inline MigrateRequestEvent(CoreId pcoreId) noexcept : coreId(pcoreId) {}
+    };
+    /**
+     * Returned by the Balancer service when the migration request fails.
+     */
+    inline void onUndeliveredEvent(const MigrateRequestEvent &event);
+
+  protected:
+    typedef Agent::SubscriberVector SubscriberVector;
+
+    /**
+     * throw (std::bad_alloc)
+     */
+    inline MigratableBase()
+        : agent(newReferencedSingletonActor<Agent>()), weight(1), migratingFlag(false), restoreFallbackFlag(false)
+    {
+        if (agent->restoreSubscribers != 0)
+        {
+            subscribers = *agent->restoreSubscribers;
+            weight = agent->restoreWeight;
+            agent->restoreSubscribers = 0;
+        }
+        agent->migratables.push_back(this);
+        registerUndeliveredEventHandler<MigrateRequestEvent>(*this);
+    }
+    inline virtual ~MigratableBase() noexcept
+    {
+        Agent::MigratableVector &migratables = agent->migratables;
+        for (Agent::MigratableVector::iterator i = migratables.begin(); i != migratables.end(); ++i)
+        {
+            if (*i == this)
+            {
+                migratables.erase(i);
+                break;
+            }
+        }
+    }
+    /**
+     * Serializes this actor state into a new transit, and pushes it to be restored by the target agent.
+     * throw (std::bad_alloc, ...)
+     */
+    virtual void pushRestoreEvent(Event::Pipe &pipe) = 0;
+    /**
+     * Quiesces this actor (unregisters all event-handlers so that events are returned to their sender)
+     * and pushes its serialized state to targetAgentId.
+     * Event-handlers are saved, to be registered again if the state cannot be restored.
+     * throw (std::bad_alloc, ...)
+     */
+    inline void migrateTo(const ActorId &targetAgentId)
+    {
+        if (migratingFlag)
+        {
+            return;
+        }
+        Event::Pipe pipe(*this, targetAgentId);
+        saveEventHandlers(savedEventHandlers);
+        pushRestoreEvent(pipe);
+        migratingFlag = true;
+        unregisterAllEventHandlers();
+        registerEventHandler<Agent::RestoredEvent>(*this);
+        registerUndeliveredEventHandler<Agent::RestoreEvent>(*this);
+    }
+    /**
+     * Constructs the actor being restored, along with its subscribers and weight.
+     * throw (std::bad_alloc, ...)
+     */
+    template <class _Actor, class _State>
+    static ActorId newRestoredActor(Agent &agent, const _State &state, const SubscriberVector &psubscribers,
+                                    uint64_t pweight)
+    {
+        agent.restoreSubscribers = &psubscribers;
+        agent.restoreWeight = pweight;
+        try
+        {
+            ActorId ret = agent.newUnreferencedActor<_Actor>(state);
+            assert(agent.restoreSubscribers == 0);
+            return ret;
+        }
+        catch (...)
+        {
+            agent.restoreSubscribers = 0;
+            throw;
+        }
+    }
+    inline const SubscriberVector &getSubscribers() const noexcept { return subscribers; }
+
+  private:
+    friend class Agent;
+
+    ActorReference<Agent> agent;
+    SubscriberVector subscribers;
+    uint64_t weight;
+    bool migratingFlag;
+    bool restoreFallbackFlag;
+    EventHandlerRegistrations savedEventHandlers; // while migrating
+
+    inline void notifySubscribers(const ActorId &actorId)
+    {
+        Event::Pipe pipe(*this);
+        for (SubscriberVector::const_iterator i = subscribers.begin(), endi = subscribers.end(); i != endi; ++i)
+        {
+            pipe.setDestinationActorId(*i);
+            pipe.push<MigratedEvent>(getActorId(), actorId);
+        }
+    }
+    inline void notifyMigrated(const ActorId &actorId)
+    {
+        notifySubscribers(actorId);
+        requestDestroy();
+    }
+};
+
+/**
+ * @brief Migratable actor.
+ *
+ * _Actor must publicly derive from Migratable<_Actor, _State>, and implement:
+ * - <code>void onMigrationSerialize(_State &) const</code>, called from the source core
+ * - a <code>_Actor(const _State &)</code> constructor, called from the target core to restore the serialized state
+ *
+ * _State must be default-constructible, and must not reference memory allocated by the source actor allocator.
+ * Migration (see MigratableBase::migrate() and Balancer) proceeds as follows:
+ * -# the source actor state is serialized, all its event-handlers are unregistered: from then on, events pushed to
+ * the source actor are returned to their sender (see Actor::registerUndeliveredEventHandler())
+ * -# the target core agent constructs a new actor from the serialized state (if that fails, the source actor
+ * registers its event-handlers again and resumes under its actor-id)
+ * -# the source actor sends MigratedEvent to its subscribers and is destroyed (once unreferenced)
+ */
+template <class _Actor, class _State> class Migratable : public MigratableBase
+{
+  protected:
+    inline Migratable() {}
+
+  private:
+    struct Transit
+    {
+        _State state;
+        SubscriberVector subscribers;
+        uint64_t weight;
+    };
+
+    static ActorId newActor(Agent &agent, void *ptransit)
+    {
+        const Transit &transit = *static_cast<Transit *>(ptransit);
+        return newRestoredActor<_Actor>(agent, transit.state, transit.subscribers, transit.weight);
+    }
+    static void deleteTransit(void *transit) noexcept { delete static_cast<Transit *>(transit); }
+    virtual void pushRestoreEvent(Event::Pipe &pipe)
+    {
+        Transit *transit = new Transit;
+        try
+        {
+            static_cast<const _Actor &>(*this).onMigrationSerialize(transit->state);
+            transit->subscribers = getSubscribers();
+            transit->weight = getMigrationWeight();
+            pipe.push<Agent::RestoreEvent>(&newActor, &deleteTransit, transit);
+        }
+        catch (...)
+        {
+            delete transit;
+            throw;
+        }
+    }
+};
+
+/**
+ * @brief Balancer service (see BalancerPolicy and addBalancer()).
+ * @attention When sampling, the balancer core does not park (see EngineIdlePolicy), as the balancer registers a
+ * performance-neutral callback at every event-loop.
+ */
+class Balancer : public Actor, public Actor::Callback
+{
+  public:
+    /**
+     * @param p The balancer policy, and the cores on which addBalancer() starts an agent.
+     */
+    inline Balancer(const std::pair<BalancerPolicy, Engine::CoreSet> &p)
+        : policy(p.first), agentCoreSet(p.second), agents(getAllocator()), pendingMigrations(getAllocator()),
+          migrationCount(0), failedMigrationCount(0), failedBalanceCount(0), nextSampleTime(HighResolutionTime()())
+    {
+        registerEventHandler<Agent::RegisterEvent>(*this);
+        registerEventHandler<Agent::SampleEvent>(*this);
+        registerEventHandler<MigratableBase::MigrateRequestEvent>(*this);
+        if (policy.period != Time())
+        {
+            registerPerformanceNeutralCallback(*this);
+        }
+    }
+    inline void onEvent(const Agent::RegisterEvent &event)
+    {
+        agents.push_back(AgentEntry(event.getSourceActorId()));
+        PendingMigrationVector tmp(getAllocator());
+        tmp.swap(pendingMigrations);
+        for (PendingMigrationVector::const_iterator i = tmp.begin(), endi = tmp.end(); i != endi; ++i)
+        {
+            migrate(i->first, i->second);
+        }
+    }
+    inline void onEvent(const Agent::SampleEvent &event)
+    {
+        AgentEntry *agent = findAgent(event.getSourceActorId().getCore());
+        if (agent == 0)
+        {
+            return;
+        }
+        if (agent->sampleCount != 0 && event.loopTotalCount != agent->loopTotalCount)
+        {
+            agent->loopUsage = (double)(event.loopUsageCount - agent->loopUsageCount) /
+                               (double)(event.loopTotalCount - agent->loopTotalCount);
+        }
+        agent->loopUsageCount = event.loopUsageCount;
+        agent->loopTotalCount = event.loopTotalCount;
+        agent->migratableCount = event.migratableCount;
+        ++agent->sampleCount;
+    }
+    inline void onEvent(const MigratableBase::MigrateRequestEvent &event)
+    {
+        if (!migrate(event.getSourceActorId(), event.coreId))
+        {
+            ++failedMigrationCount;
+            throw ReturnToSenderException(); // no agent runs or will run on event.coreId
+        }
+    }
+    inline void onCallback() noexcept
+    {
+        const Time now = HighResolutionTime()();
+        if (now >= nextSampleTime)
+        {
+            nextSampleTime = now + policy.period;
+            try
+            {
+                balance();
+                Event::Pipe pipe(*this);
+                for (AgentVector::const_iterator i = agents.begin(), endi = agents.end(); i != endi; ++i)
+                {
+                    pipe.setDestinationActorId(i->agentId);
+                    pipe.push<Agent::SampleRequestEvent>();
+                }
+            }
+            catch (std::exception &)
+            {
+                ++failedBalanceCount; // retried at next period
+            }
+        }
+        registerPerformanceNeutralCallback(*this);
+    }
+    /**
+     * @brief Getter.
+     * @return Migrations requested so far, by MigratableBase::migrate() or by balancing.
+     */
+    inline uint64_t getMigrationCount() const noexcept { return migrationCount; }
+    /**
+     * @brief Getter.
+     * @return MigratableBase::migrate() requests failed so far, because no agent runs or will run on the target core.
+     */
+    inline uint64_t getFailedMigrationCount() const noexcept { return failedMigrationCount; }
+    /**
+     * @brief Getter.
+     * @return Sampling periods whose balancing or sampling requests failed so far (e.g. std::bad_alloc).
+     */
+    inline uint64_t getFailedBalanceCount() const noexcept { return failedBalanceCount; }
+
+  private:
+    struct AgentEntry
+    {
+        ActorId agentId;
+        uint64_t loopUsageCount;
+        uint64_t loopTotalCount;
+        double loopUsage; // < 0 until 2 samples
+        size_t migratableCount;
+        size_t sampleCount;
+        inline AgentEntry(const ActorId &pagentId) noexcept
+            : agentId(pagentId), loopUsageCount(0), loopTotalCount(0), loopUsage(-1), migratableCount(0),
+              sampleCount(0)
+        {
+        }
+    };
+    typedef std::vector<AgentEntry, Allocator<AgentEntry>> AgentVector;
+    typedef std::pair<ActorId, CoreId> PendingMigration;
+    typedef std::vector<PendingMigration, Allocator<PendingMigration>> PendingMigrationVector;
+
+    const BalancerPolicy policy;
+    const Engine::CoreSet agentCoreSet;
+    AgentVector agents;
+    PendingMigrationVector pendingMigrations; // until both agents are registered
+    uint64_t migrationCount;
+    uint64_t failedMigrationCount;
+    uint64_t failedBalanceCount;
+    Time nextSampleTime;
+
+    inline AgentEntry *findAgent(CoreId coreId) noexcept
+    {
+        for (AgentVector::iterator i = agents.begin(), endi = agents.end(); i != endi; ++i)
+        {
+            if (i->agentId.getCore() == coreId)
+            {
+                return &*i;
+            }
+        }
+        return 0;
+    }
+    inline bool isAgentCore(CoreId coreId) const noexcept
+    {
+        for (Engine::CoreSet::NodeId i = 0; i < agentCoreSet.size(); ++i)
+        {
+            if (agentCoreSet.at(i) == coreId)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+    /**
+     * Returns false if no agent runs on coreId, and none will register (coreId is not part of agentCoreSet).
+     * throw (std::bad_alloc)
+     */
+    inline bool migrate(const ActorId &actorId, CoreId coreId)
+    {
+        const AgentEntry *sourceAgent = findAgent(actorId.getCore());
+        const AgentEntry *targetAgent = findAgent(coreId);
+        if (targetAgent == 0 && !isAgentCore(coreId))
+        {
+            return false;
+        }
+        if (sourceAgent == 0 || targetAgent == 0)
+        {
+            pendingMigrations.push_back(PendingMigration(actorId, coreId));
+        }
+        else if (sourceAgent != targetAgent)
+        {
+            Event::Pipe(*this, sourceAgent->agentId).push<Agent::MigrateRequestEvent>(actorId, targetAgent->agentId);
+            ++migrationCount;
+        }
+        return true;
+    }
+    /**
+     * throw (std::bad_alloc)
+     */
+    inline void balance()
+    {
+        AgentEntry *hottest = 0;
+        AgentEntry *coldest = 0;
+        for (AgentVector::iterator i = agents.begin(), endi = agents.end(); i != endi; ++i)
+        {
+            if (i->loopUsage < 0)
+            {
+                continue;
+            }
+            if (hottest == 0 || i->loopUsage > hottest->loopUsage)
+            {
+                hottest = &*i;
+            }
+            if (coldest == 0 || i->loopUsage < coldest->loopUsage)
+            {
+                coldest = &*i;
+            }
+        }
+        if (hottest != 0 && hottest != coldest && hottest->loopUsage - coldest->loopUsage >= policy.loopUsageGap &&
+            hottest->migratableCount >= 2)
+        {
+            Event::Pipe(*this, hottest->agentId).push<Agent::MigrateRequestEvent>(ActorId(), coldest->agentId);
+            ++migrationCount;
+            // let both cores settle before next decision
+            hottest->loopUsage = coldest->loopUsage = -1;
+            hottest->sampleCount = coldest->sampleCount = 0;
+        }
+    }
+};
+
+/**
+ * @brief Starts the Balancer service on balancerCoreId, and an Agent on each core of coreSet.
+ * @throw std::bad_alloc
+ */
+inline void addBalancer(Engine::StartSequence &startSequence, Engine::CoreId balancerCoreId,
+                        const Engine::CoreSet &coreSet, const BalancerPolicy &policy = BalancerPolicy())
+{
+    struct AgentStarter : Actor
+    {
+        ActorReference<Agent> agent;
+        AgentStarter() : agent(newReferencedSingletonActor<Agent>()) {}
+    };
+    startSequence.addServiceActor<BalancerService, Balancer>(balancerCoreId, std::make_pair(policy, coreSet));
+    for (Engine::CoreSet::NodeId i = 0; i < coreSet.size(); ++i)
+    {
+        startSequence.addActor<AgentStarter>(coreSet.at(i));
+    }
+}
+
+void Agent::onEvent(const MigrateRequestEvent &event)
+{
+    MigratableBase *migratable = 0;
+    for (MigratableVector::const_iterator i = migratables.begin(), endi = migratables.end(); i != endi; ++i)
+    {
+        if ((*i)->isMigrating())
+        {
+            continue;
+        }
+        if (event.actorId == null ? (migratable == 0 || (*i)->getMigrationWeight() > migratable->getMigrationWeight())
+                                  : (*i)->getActorId() == event.actorId)
+        {
+            migratable = *i;
+        }
+    }
+    if (migratable != 0 && (event.actorId != null || migratables.size() >= 2))
+    {
+        migratable->migrateTo(event.targetAgentId);
+    }
+}
+
+void Agent::onEvent(const RestoreEvent &event)
+{
+    ActorId actorId;
+    try
+    {
+        actorId = event.newActor(*this, event.transit);
+    }
+    catch (...)
+    {
+        throw ReturnToSenderException(); // transit still owned by sender, which rolls back
+    }
+    event.deleteTransit(event.transit);
+    Event::Pipe(*this, event.getSourceActorId()).push<RestoredEvent>(actorId);
+}
+
+void MigratableBase::onEvent(const Agent::RestoredEvent &event) { notifyMigrated(event.actorId); }
+
+void MigratableBase::onUndeliveredEvent(const Agent::RestoreEvent &event)
+{
+    if (restoreFallbackFlag)
+    {
+        event.deleteTransit(event.transit);
+        notifyMigrated(ActorId());
+        return;
+    }
+    // roll back: this actor resumes under the same actor-id
+    unregisterAllEventHandlers();
+    try
+    {
+        registerEventHandlers(savedEventHandlers);
+    }
+    catch (...)
+    {
+        unregisterAllEventHandlers();
+        registerEventHandler<Agent::RestoredEvent>(*this);
+        registerUndeliveredEventHandler<Agent::RestoreEvent>(*this);
+        restoreFallbackFlag = true; // restore on this core instead, as a new actor
+        Event::Pipe(*this, agent->getActorId())
+            .push<Agent::RestoreEvent>(event.newActor, event.deleteTransit, event.transit);
+        return;
+    }
+    event.deleteTransit(event.transit);
+    savedEventHandlers.clear();
+    migratingFlag = false;
+    notifySubscribers(getActorId());
+}
+
+void MigratableBase::onUndeliveredEvent(const MigrateRequestEvent &) { notifySubscribers(getActorId()); }
+
+} // namespace migration
+} // namespace simplx
@@ -0,0 +1,406 @@
+/**
+ * @file workerpool.h
+ * @brief sharded worker-pool, one worker per core, with load-aware or key-affinity routing
+ * @copyright 2019 Scalewatch (www.scalewatch.com). All rights reserved.
+ * Please see accompanying LICENSE file for licensing terms.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "simplx_core/engine.h"
+
+namespace simplx
+{
+namespace workerpool
+{
+
+/**
+ * @brief Thrown when pushing a job before the dispatcher learnt of all the workers (see Proxy::isReady()).
+ */
+struct NotReadyException : std::exception
+{
+    virtual const char *what() const noexcept { return "simplx::workerpool::NotReadyException"; }
+};
+
+/**
+ * @brief Job pushed by a Proxy to a worker of _Pool (see Worker).
+ */
+template <class _Pool> struct JobEvent : Actor::Event
+{
+    const Actor::ActorId clientId;
+    const size_t workerIndex;
+    const uint64_t inFlightCount; ///< jobs in-flight from the source dispatcher to this worker, this one included
+    const typename _Pool::Job job;
+    inline JobEvent(const Actor::ActorId &pclientId, size_t pworkerIndex, uint64_t pinFlightCount,
+                    const typename _Pool::Job &pjob)
+        : clientId(pclientId), workerIndex(pworkerIndex), inFlightCount(pinFlightCount), job(pjob)
+    {
+    }
+};
+
+/**
+ * @brief Completion of a JobEvent, pushed by the worker to the source dispatcher, which forwards it to the client.
+ * @note exception is allocated using the event-allocator, it is only valid during the event-handler call.
+ */
+template <class _Pool> struct CompletionEvent : Actor::Event
+{
+    const Actor::ActorId clientId;
+    const size_t workerIndex;
+    const uint64_t othersInFlightCount; ///< jobs in-flight to this worker from other dispatchers, as last known
+    const typename _Pool::Result result; ///< default-constructed if onJob() threw an exception
+    const char *const exception;         ///< description of the exception thrown by onJob(), 0 if none
+    template <class _Result>
+    inline CompletionEvent(const Actor::ActorId &pclientId, size_t pworkerIndex, uint64_t pothersInFlightCount,
+                           _Result &&presult, const char *pexception)
+        : clientId(pclientId), workerIndex(pworkerIndex), othersInFlightCount(pothersInFlightCount),
+          result(std::forward<_Result>(presult)), exception(pexception)
+    {
+    }
+};
+
+/**
+ * @brief Service actor of a worker-pool (see addWorkerPool()): publishes the workers, ordered by core-id,
+ * to the per-core dispatchers once all workers registered.
+ */
+class Directory : public Actor
+{
+  public:
+    struct RegisterEvent : Event
+    {
+    };
+    struct SubscribeEvent : Event
+    {
+    };
+    struct WorkerEvent : Event
+    {
+        const size_t workerIndex;
+        const size_t workerCount;
+        const ActorId workerId;
+        inline WorkerEvent(size_t pworkerIndex, size_t pworkerCount, const ActorId &pworkerId) noexcept
+            : workerIndex(pworkerIndex), workerCount(pworkerCount), workerId(pworkerId)
+        {
+        }
+    };
+
+    inline Directory(size_t pworkerCount)
+        : workerCount(pworkerCount), workerIds(getAllocator()), subscriberIds(getAllocator())
+    {
+        registerEventHandler<RegisterEvent>(*this);
+        registerEventHandler<SubscribeEvent>(*this);
+    }
+    inline void onEvent(const RegisterEvent &event)
+    {
+        workerIds.push_back(event.getSourceActorId());
+        if (workerIds.size() == workerCount)
+        {
+            std::sort(workerIds.begin(), workerIds.end(), CoreLess());
+            for (ActorIdVector::const_iterator i = subscriberIds.begin(), endi = subscriberIds.end(); i != endi; ++i)
+            {
+                publish(*i);
+            }
+            subscriberIds.clear();
+        }
+    }
+    inline void onEvent(const SubscribeEvent &event)
+    {
+        if (workerIds.size() == workerCount)
+        {
+            publish(event.getSourceActorId());
+        }
+        else
+        {
+            subscriberIds.push_back(event.getSourceActorId());
+        }
+    }
+
+  private:
+    typedef std::vector<ActorId, Allocator<ActorId>> ActorIdVector;
+    struct CoreLess
+    {
+        inline bool operator()(const ActorId &a, const ActorId &b) const { return a.getCore() < b.getCore(); }
+    };
+
+    const size_t workerCount;
+    ActorIdVector workerIds;
+    ActorIdVector subscriberIds;
+
+    inline void publish(const ActorId &subscriberId)
+    {
+        Event::Pipe pipe(*this, subscriberId);
+        for (size_t i = 0; i < workerCount; ++i)
+        {
+            pipe.push<WorkerEvent>(i, workerCount, workerIds[i]);
+        }
+    }
+};
+
+/**
+ * @brief Base-class of the workers of _Pool.
+ *
+ * _Pool is the worker-pool service-tag (publicly deriving from simplx::Service), and must define the
+ * <code>Job</code> and <code>Result</code> types, which are copied into events: they must be copy-constructible and,
+ * as event destructors are not called, must not own memory (e.g. std::string). Result must also be
+ * default-constructible, for the completion of a job whose onJob() threw an exception.
+ * _Worker must publicly derive from Worker<_Worker, _Pool>, and implement
+ * <code>_Pool::Result onJob(const _Pool::Job &)</code>.
+ * <br>Example:
+ * \code
+ * struct HashPool : simplx::Service { typedef uint64_t Job; typedef uint64_t Result; };
+ * struct HashWorker : simplx::workerpool::Worker<HashWorker, HashPool> {
+ *     uint64_t onJob(uint64_t key) { return std::hash<uint64_t>()(key); }
+ * };
+ * \endcode
+ * Each completion reports the jobs in-flight to this worker from the other dispatchers (as carried by their latest
+ * job, less the completions since), so that each dispatcher accounts for the load the others put on this worker.
+ */
+template <class _Worker, class _Pool> class Worker : public Actor
+{
+  public:
+    inline void onEvent(const JobEvent<_Pool> &event)
+    {
+        const ActorId dispatcherId = event.getSourceActorId();
+        DispatcherEntry &dispatcher = findDispatcher(dispatcherId);
+        totalInFlightCount += event.inFlightCount - dispatcher.inFlightCount;
+        dispatcher.inFlightCount = event.inFlightCount;
+        --dispatcher.inFlightCount;
+        --totalInFlightCount;
+        Event::Pipe pipe(*this, dispatcherId);
+        const uint64_t othersInFlightCount = totalInFlightCount - dispatcher.inFlightCount;
+        try
+        {
+            pipe.push<CompletionEvent<_Pool>>(event.clientId, event.workerIndex, othersInFlightCount,
+                                              static_cast<_Worker &>(*this).onJob(event.job), (const char *)0);
+        }
+        catch (const std::exception &e)
+        { // still completed, so that the dispatcher accounts for the job
+            pipe.push<CompletionEvent<_Pool>>(event.clientId, event.workerIndex, othersInFlightCount,
+                                              typename _Pool::Result(),
+                                              Event::newCString(pipe.getAllocator(), e.what()));
+        }
+        catch (...)
+        {
+            pipe.push<CompletionEvent<_Pool>>(event.clientId, event.workerIndex, othersInFlightCount,
+                                              typename _Pool::Result(), "unknown exception");
+        }
+    }
+
+  protected:
+    /**
+     * throw (std::bad_alloc)
+     */
+    inline Worker() : dispatchers(getAllocator()), totalInFlightCount(0)
+    {
+        registerEventHandler<JobEvent<_Pool>>(*this);
+        const ActorId &directoryId = getEngine().getServiceIndex().template getServiceActorId<_Pool>();
+        assert(directoryId != null);
+        Event::Pipe(*this, directoryId).push<Directory::RegisterEvent>();
+    }
+
+  private:
+    struct DispatcherEntry
+    {
+        ActorId dispatcherId;
+        uint64_t inFlightCount;
+        inline DispatcherEntry(const ActorId &pdispatcherId) noexcept : dispatcherId(pdispatcherId), inFlightCount(0)
+        {
+        }
+    };
+    typedef std::vector<DispatcherEntry, Allocator<DispatcherEntry>> DispatcherVector;
+
+    DispatcherVector dispatchers; // at most one per core
+    uint64_t totalInFlightCount;
+
+    inline DispatcherEntry &findDispatcher(const ActorId &dispatcherId)
+    {
+        for (typename DispatcherVector::iterator i = dispatchers.begin(), endi = dispatchers.end(); i != endi; ++i)
+        {
+            if (i->dispatcherId == dispatcherId)
+            {
+                return *i;
+            }
+        }
+        dispatchers.push_back(DispatcherEntry(dispatcherId));
+        return dispatchers.back();
+    }
+};
+
+/**
+ * @brief Per-core singleton routing the jobs of the local Proxy instances to the workers of _Pool.
+ */
+template <class _Pool> class Dispatcher : public Actor
+{
+  public:
+    /**
+     * throw (std::bad_alloc)
+     */
+    inline Dispatcher() : workers(getAllocator()), readyWorkerCount(0), nextWorkerIndex(0)
+    {
+        registerEventHandler<Directory::WorkerEvent>(*this);
+        registerEventHandler<CompletionEvent<_Pool>>(*this);
+        const ActorId &directoryId = getEngine().getServiceIndex().template getServiceActorId<_Pool>();
+        assert(directoryId != null);
+        Event::Pipe(*this, directoryId).push<Directory::SubscribeEvent>();
+    }
+    inline bool isReady() const noexcept { return readyWorkerCount != 0 && readyWorkerCount == workers.size(); }
+    inline size_t getWorkerCount() const noexcept { return workers.size(); }
+    /**
+     * Pushes job to the least-loaded worker, ties being broken round-robin.
+     * throw (NotReadyException, std::bad_alloc)
+     */
+    inline void push(const ActorId &clientId, const typename _Pool::Job &job)
+    {
+        if (!isReady())
+        {
+            throw NotReadyException();
+        }
+        const size_t workerCount = workers.size();
+        size_t workerIndex = nextWorkerIndex;
+        uint64_t minLoad = workers[workerIndex].getLoad();
+        for (size_t i = 1; i < workerCount && minLoad != 0; ++i)
+        {
+            const size_t j = (nextWorkerIndex + i) % workerCount;
+            const uint64_t load = workers[j].getLoad();
+            if (load < minLoad)
+            {
+                workerIndex = j;
+                minLoad = load;
+            }
+        }
+        nextWorkerIndex = (nextWorkerIndex + 1) % workerCount;
+        pushTo(clientId, workerIndex, job);
+    }
+    /**
+     * Pushes job to the worker key maps to, by consistent hashing (jobs with a same key go to a same worker).
+     * throw (NotReadyException, std::bad_alloc)
+     */
+    inline void push(const ActorId &clientId, uint64_t key, const typename _Pool::Job &job)
+    {
+        if (!isReady())
+        {
+            throw NotReadyException();
+        }
+        pushTo(clientId, jumpHash(key, workers.size()), job);
+    }
+    inline void onEvent(const Directory::WorkerEvent &event)
+    {
+        workers.resize(event.workerCount);
+        workers[event.workerIndex].workerId = event.workerId;
+        ++readyWorkerCount;
+    }
+    inline void onEvent(const CompletionEvent<_Pool> &event)
+    {
+        WorkerEntry &worker = workers[event.workerIndex];
+        assert(worker.localInFlightCount != 0);
+        --worker.localInFlightCount;
+        worker.othersInFlightCount = event.othersInFlightCount;
+        Event::Pipe pipe(*this, event.clientId);
+        pipe.push<CompletionEvent<_Pool>>(
+            event.clientId, event.workerIndex, event.othersInFlightCount, event.result,
+            event.exception == 0 ? (const char *)0 : Event::newCString(pipe.getAllocator(), event.exception));
+    }
+
+  private:
+    struct WorkerEntry
+    {
+        ActorId workerId;
+        uint64_t localInFlightCount;
+        uint64_t othersInFlightCount;
+        inline WorkerEntry() noexcept : localInFlightCount(0), othersInFlightCount(0) {}
+        inline uint64_t getLoad() const noexcept { return localInFlightCount + othersInFlightCount; }
+    };
+    typedef std::vector<WorkerEntry, Allocator<WorkerEntry>> WorkerVector;
+
+    WorkerVector workers;
+    size_t readyWorkerCount;
+    size_t nextWorkerIndex;
+
+    inline void pushTo(const ActorId &clientId, size_t workerIndex, const typename _Pool::Job &job)
+    {
+        WorkerEntry &worker = workers[workerIndex];
+        Event::Pipe(*this, worker.workerId)
+            .push<JobEvent<_Pool>>(clientId, workerIndex, worker.localInFlightCount + 1, job);
+        ++worker.localInFlightCount;
+    }
+    /**
+     * Jump consistent hash (Lamping, Veach): maps key to [0, bucketCount), only moving 1/bucketCount of the keys when
+     * adding a bucket.
+     */
+    static inline size_t jumpHash(uint64_t key, size_t bucketCount) noexcept
+    {
+        int64_t b = -1;
+        for (int64_t j = 0; j < (int64_t)bucketCount;)
+        {
+            b = j;
+            key = key * 2862933555777941757ULL + 1;
+            j = (int64_t)((b + 1) * ((double)(1LL << 31) / (double)((key >> 33) + 1)));
+        }
+        return (size_t)b;
+    }
+};
+
+/**
+ * @brief Client-side access to the workers of _Pool, through the core dispatcher (see Dispatcher).
+ *
+ * Completions are pushed to the client actor as CompletionEvent<_Pool>, for which it must register an event-handler.
+ * <br>Example:
+ * \code
+ * class MyClient : public simplx::Actor {
+ *     simplx::workerpool::Proxy<HashPool> hashPool;
+ * public:
+ *     MyClient() : hashPool(*this) { registerEventHandler<simplx::workerpool::CompletionEvent<HashPool>>(*this); }
+ *     void onEvent(const simplx::workerpool::CompletionEvent<HashPool> &);
+ * };
+ * \endcode
+ * @attention The dispatcher learns of the workers asynchronously: jobs can only be pushed once isReady(),
+ * NotReadyException being thrown otherwise.
+ */
+template <class _Pool> class Proxy
+{
+  public:
+    /**
+     * throw (std::bad_alloc, Actor::ShutdownException)
+     */
+    inline Proxy(Actor &actor)
+        : clientId(actor.getActorId()), dispatcher(actor.newReferencedSingletonActor<Dispatcher<_Pool>>())
+    {
+    }
+    inline bool isReady() const noexcept { return dispatcher->isReady(); }
+    inline size_t getWorkerCount() const noexcept { return dispatcher->getWorkerCount(); }
+    /**
+     * @brief Pushes job to the least-loaded worker (see CompletionEvent::othersInFlightCount).
+     * @throw NotReadyException
+     * @throw std::bad_alloc
+     */
+    inline void push(const typename _Pool::Job &job) { dispatcher->push(clientId, job); }
+    /**
+     * @brief Pushes job to the worker key maps to, which is the same for all the jobs with that key.
+     * @throw NotReadyException
+     * @throw std::bad_alloc
+     */
+    inline void push(uint64_t key, const typename _Pool::Job &job) { dispatcher->push(clientId, key, job); }
+
+  private:
+    const Actor::ActorId clientId;
+    Actor::ActorReference<Dispatcher<_Pool>> dispatcher;
+};
+
+/**
+ * @brief Starts the _Pool worker-pool: the Directory service on directoryCoreId, and a _Worker on each core of coreSet.
+ * @throw std::bad_alloc
+ */
+template <class _Pool, class _Worker>
+inline void addWorkerPool(Engine::StartSequence &startSequence, Engine::CoreId directoryCoreId,
+                          const Engine::CoreSet &coreSet)
+{
+    startSequence.addServiceActor<_Pool, Directory>(directoryCoreId, coreSet.size());
+    for (Engine::CoreSet::NodeId i = 0; i < coreSet.size(); ++i)
+    {
+        startSequence.addActor<_Worker>(coreSet.at(i));
+    }
+}
+
+} // namespace workerpool
+} // namespace simplx
@@ -11,6 +11,7 @@
 #include "simplx_core/engineversion.h"
 #include "simplx_core/initializer.h"
 #include "simplx_core/platform.h"
+#include "simplx_core/typedactor.h"
 
 // internal
 #include "simplx_core/internal/cacheline.h"
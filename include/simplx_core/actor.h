@@ -8,8 +8,14 @@
 #pragma once
 
 #include <vector>
+#include <cstring>
 #include <iostream>
 #include <iomanip>
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
 
 #include "simplx_core/event.h"
 #include "simplx_core/internal/cacheline.h"
@@ -66,6 +72,7 @@ inline void breakThrow(const std::exception &e) noexcept(false)
 }
 
 template <class> class Accessor;
+template <class, class...> class TypedActor;
 
 struct ActorBase
 {
@@ -277,6 +284,9 @@ public:
     struct ShutdownException;
     struct EventTable;
     struct NodeConnection;
+    typedef uint64_t OffloadToken; ///< Scalar type identifying a task submitted using offload(). Valid values start
+                                   ///at 1 (0 is invalid).
+    template <class _Result> struct OffloadEvent;
 
     /**
      * @brief This exception is thrown when attempting multiple calls to
@@ -343,6 +353,31 @@ public:
             }
         }
     };
+
+    /**
+     * @brief This exception is thrown by offload() when the task cannot be submitted.
+     *
+     * This occurs in 2 cases:
+     * -# The queue of the executor is full (see EngineOffloadPolicy::queueSize).
+     * -# The engine has no executor (see Engine::StartSequence::setOffloadPolicy()).
+     */
+    struct OffloadException : std::exception
+    {
+        const bool queueFullFlag;
+        inline OffloadException(bool pqueueFullFlag) noexcept : queueFullFlag(pqueueFullFlag) {}
+
+        virtual const char *what() const noexcept
+        {
+            if (queueFullFlag)
+            {
+                return "simplx::Actor::OffloadException (the executor queue is full)";
+            }
+            else
+            {
+                return "simplx::Actor::OffloadException (the engine has no executor)";
+            }
+        }
+    };
     
     /**
      * @brief Non-template base-class of stl-compliant Actor::Allocator.
@@ -746,20 +781,70 @@ public:
         {
             return nodeId < writtenSizePointerVector.size() ? *writtenSizePointerVector[nodeId] : 0;
         }
+        /**
+         * @brief Getter to the cumulative time the event-loop spent idle without parking
+         * (spinning or pausing, see EngineIdlePolicy).
+         * Only idle stretches which are over (i.e. followed by a busy event-loop iteration or a parking) are accounted.
+         * @return The real-time latest cumulative idle spinning time in nanoseconds.
+         */
+        uint64_t getIdleSpinNanosecond() const noexcept { return idleSpinNanosecond; }
+        /**
+         * @brief Getter to the cumulative time the event-loop thread spent parked (see EngineIdlePolicy).
+         * Comparing this indicator to getIdleSpinNanosecond() tells how much cpu-core time the idle policy saves.
+         * @return The real-time latest cumulative parked time in nanoseconds.
+         */
+        uint64_t getIdleParkNanosecond() const noexcept { return idleParkNanosecond; }
+        /**
+         * @brief Getter to the cumulative count of event-loop thread parkings (see EngineIdlePolicy).
+         * @return The real-time latest cumulative parking count.
+         */
+        uint64_t getIdleParkCount() const noexcept { return idleParkCount; }
+        /**
+         * @brief Getter to the cumulative count of event-loop iterations which left part of the batch received
+         * from another cpu-core (or from itself) to the next iterations (see EngineEventDeliveryBudgetPolicy).
+         * @param nodeId logical cpu-core. If an inconsistent value is passed
+         * (e.g. greater than the actual number of cpu-cores), the returned value is zero.
+         * @return The real-time latest cumulative delivery budget hit count for the cpu-core represented
+         * by the argument nodeId. Or zero if nodeId is inconsistent.
+         */
+        uint64_t getDeliveryBudgetHitCountFrom(NodeId nodeId) const noexcept
+        {
+            return nodeId < deliveryBudgetHitCountVector.size() ? deliveryBudgetHitCountVector[nodeId] : 0;
+        }
+        /**
+         * @brief Getter to the cumulative count of event-handlers promoted to the high-frequency part of their
+         * actor event-table (see EngineEventHandlerPlacementPolicy).
+         * @return The real-time latest cumulative promotion count.
+         */
+        uint64_t getEventHandlerPromotionCount() const noexcept { return eventHandlerPromotionCount; }
+        /**
+         * @brief Getter to the cumulative count of event-handlers demoted to the low-frequency part of their
+         * actor event-table to make room for a promotion (see EngineEventHandlerPlacementPolicy).
+         * @return The real-time latest cumulative demotion count.
+         */
+        uint64_t getEventHandlerDemotionCount() const noexcept { return eventHandlerDemotionCount; }
 
       private:
         friend class AsyncNode;
         friend class AsyncNodesHandle;
         typedef std::vector<const uint64_t *, Allocator<const uint64_t *>> SizePointerVector;
+        typedef std::vector<uint64_t, Allocator<uint64_t>> CountVector;
         SizePointerVector writtenSizePointerVector;
+        CountVector deliveryBudgetHitCountVector;
         uint64_t loopTotalCount;
         uint64_t loopUsageCount;
         uint64_t onEventCount;
         uint64_t onCallbackCount;
+        uint64_t idleSpinNanosecond;
+        uint64_t idleParkNanosecond;
+        uint64_t idleParkCount;
+        uint64_t eventHandlerPromotionCount;
+        uint64_t eventHandlerDemotionCount;
 
         CorePerformanceCounters(const AllocatorBase &allocator, size_t nodeCount)
-            : writtenSizePointerVector(allocator), loopTotalCount(0), loopUsageCount(0), onEventCount(0),
-              onCallbackCount(0)
+            : writtenSizePointerVector(allocator), deliveryBudgetHitCountVector(nodeCount, 0, allocator),
+              loopTotalCount(0), loopUsageCount(0), onEventCount(0), onCallbackCount(0), idleSpinNanosecond(0),
+              idleParkNanosecond(0), idleParkCount(0), eventHandlerPromotionCount(0), eventHandlerDemotionCount(0)
         {
             writtenSizePointerVector.reserve(nodeCount);
         }
@@ -809,6 +894,7 @@ public:
         friend class Actor;
         friend class AsyncNode;
         friend struct AsyncNodeBase;
+        friend class AsyncNodesHandle;
         friend class IRefMapper;
         
         struct Chain : DoubleChain<0u, Chain>
@@ -1524,6 +1610,31 @@ public:
      * @see CorePerformanceCounters
      */
     template <class _Callback> inline void registerPerformanceNeutralCallback(_Callback &callbackHandler) noexcept;
+    /**
+     * @brief Submits a blocking task (e.g. fsync, DNS lookup, file read, compression) to the engine executor, so that
+     * it runs on a thread which is not an event-loop.
+     * The task is a copy of the functor passed as a parameter, of template generic type _Task
+     * which must meet the following conditions:
+     * - publicly implement the method <code>_Result operator()()</code> (e.g. a lambda expression)
+     * - be copy-constructible, the copy being destroyed once completed on the event-loop (cpu-core) running this actor
+     * - _Result is void, or default-constructible and copy-constructible
+     *
+     * Once executed, an OffloadEvent<_Result> holding the returned value and the token returned by this method,
+     * or the description of the exception thrown by the task, is pushed to this actor from its own event-loop
+     * (cpu-core). The completion event is delivered like any other event, and is undelivered when this actor
+     * was destroyed in between.
+     * @note While tasks are in flight, the event-loop (cpu-core) running this actor polls their completion and
+     * never parks (see EngineIdlePolicy).
+     * @attention The task runs concurrently with all the event-loops, it must not access any actor and must not own
+     * memory allocated using an actor or event allocator. Likewise _Result must not own memory, since events are
+     * never destroyed.
+     * @param task functor to be executed.
+     * @return token identifying the task in its completion event.
+     * @throw OffloadException The queue of the executor is full, or the engine has no executor
+     * (see EngineOffloadPolicy).
+     * @throw std::bad_alloc
+     */
+    template <class _Task> OffloadToken offload(const _Task &task);
     /**
      * @brief Marks this actor for later destruction by the runtime. The actual destruction is asynchronous.
      * When eligible for destruction, the onDestroyRequest() method of this actor will be called.
@@ -1629,12 +1740,64 @@ public:
      * can never be called by event-loop.
      */
     void unregisterAllEventHandlers() noexcept;
+    /**
+     * @brief Event-handler registrations of an actor (see saveEventHandlers()).
+     */
+    class EventHandlerRegistrations
+    {
+      public:
+        inline EventHandlerRegistrations() noexcept : typedEventHandler(0) {}
+        inline bool empty() const noexcept { return entries.empty() && typedEventHandler == 0; }
+        inline void clear() noexcept
+        {
+            entries.clear();
+            typedEventHandler = 0;
+        }
+
+      private:
+        friend class Actor;
+        struct Entry
+        {
+            EventId eventId;
+            bool undeliveredFlag;
+            void *eventHandler;
+            bool (*staticEventHandler)(void *, const Event &);
+            inline Entry(EventId peventId, bool pundeliveredFlag, void *peventHandler,
+                         bool (*pstaticEventHandler)(void *, const Event &)) noexcept
+                : eventId(peventId), undeliveredFlag(pundeliveredFlag), eventHandler(peventHandler),
+                  staticEventHandler(pstaticEventHandler)
+            {
+            }
+        };
+        std::vector<Entry> entries;
+        bool (*typedEventHandler)(Actor &, const Event &);
+    };
+    /**
+     * @brief Saves all event-handlers currently registered, so that they can be registered again
+     * (see registerEventHandlers()), typically after a call to unregisterAllEventHandlers().
+     * @param registrations Replaced by this actor current registrations.
+     * @throw std::bad_alloc
+     */
+    void saveEventHandlers(EventHandlerRegistrations &registrations) const;
+    /**
+     * @brief Registers again event-handlers previously saved by saveEventHandlers().
+     * @throw AlreadyRegisterdEventHandlerException If one of the saved events already has an event-handler
+     * (event-handlers saved before it are then registered).
+     * @throw std::bad_alloc
+     */
+    void registerEventHandlers(const EventHandlerRegistrations &registrations);
     /**
      * @brief Getter.
      * @return true if an event-handler was registered using registerEventHandler<_Event, ?>(),
      * regardless of the template second generic type.
      */
     template <class _Event> inline bool isRegisteredEventHandler() const noexcept;
+    /**
+     * @brief Getter.
+     * @return true if the event-handler registered using registerEventHandler<_Event, ?>() currently sits
+     * in the high-frequency part of this actor event-table (see EngineEventHandlerPlacementPolicy).
+     */
+    template <class _Event> inline bool isHighFrequencyEventHandler() const noexcept;
     /**
      * @brief Getter.
      * @return true if an event-handler was registered using registerUndeliveredEventHandler<_Event, ?>(),
@@ -1726,6 +1889,9 @@ public:
     friend class EngineToEngineConnector;
     friend class EngineToEngineSharedMemoryConnector;
     friend class RefMapper;
+    friend class OffloadActor;
+    friend class OffloadExecutor;
+    template <class, class...> friend class TypedActor;
     ENTERPRISE_0X5032
     
     typedef MultiDoubleChainLink<Actor, 2u> super;
@@ -1735,6 +1901,8 @@ public:
     
     template <class _Event, class _EventHandler> struct StaticEventHandler;
     template <class _Callback> struct StaticCallbackHandler;
+    struct OffloadTask;
+    template <class _Task, class _Result> struct OffloadTaskImpl;
     struct Chain : DoubleChain<0u, Chain>
     {
         inline static Actor *getItem(super *link) noexcept { return static_cast<Actor *>(link); }
@@ -1842,9 +2010,12 @@ public:
     bool isRegisteredLowPriorityEventHandler(void *, EventId) const noexcept;
     bool isRegisteredHighPriorityEventHandler(EventId) const noexcept;
     bool isRegisteredEventHandler(EventId) const noexcept;
+    void placeEventHandlers(uint64_t &promotionCount, uint64_t &demotionCount) noexcept;
+    void registerTypedEventHandler(bool (*)(Actor &, const Event &)) noexcept;
     bool isRegisteredUndeliveredEventHandler(EventId) const noexcept;
     void registerCallback(void (*onCallback)(Callback &) noexcept, Callback &) noexcept;
     void registerPerformanceNeutralCallback(void (*onCallback)(Callback &) noexcept, Callback &) noexcept;
+    OffloadToken offload(OffloadTask &); // throw (OffloadException, std::bad_alloc)
     Actor *getSingletonActor(SingletonActorIndex) noexcept;
     void reserveSingletonActor(SingletonActorIndex); // throw (CircularReferenceException)
     void setSingletonActor(SingletonActorIndex, Actor &) noexcept;
@@ -2001,10 +2172,14 @@ using AbsoluteEventVector = vector<AbsoluteEventEntry>;     // , Actor::Allocato
  * - Event::Pipe::push()
  * - Event::BufferedPipe::push()
  * - simplx::EngineToEngineConnectorEventFactory::newEvent()
+ *
+ * The event header (class-id, source and destination actor-ids, route) is a non-virtual base
+ * at a fixed offset within every event, so that header getters do not need any indirection.
+ * The header is constructed by the above factory methods before the Event sub-class constructor is called.
  */
 #pragma pack(push)
 #pragma pack(1)
-class Actor::Event : private MultiForwardChainLink<Event>, virtual private EventBase
+class Actor::Event : private MultiForwardChainLink<Event>, private EventBase
 {
 public:
   
@@ -2014,6 +2189,8 @@ public:
     class Batch;
     class Pipe;
     class BufferedPipe;
+    class MulticastPipe;
+    template <class T> class VarPayload;
     /**
      * @brief Thrown when cluster-event-id is not unique.
      * Another event-based class has the same cluster-event-id
@@ -2059,7 +2236,7 @@ public:
      * @brief Copy constructor.
      * @param other Another event to copy from.
      */
-    inline Event(const Event &) noexcept : EventBase(0, 0, 0, 0), MultiForwardChainLink<Event>()
+    inline Event(const Event &) noexcept : MultiForwardChainLink<Event>(), EventBase(getConstructedHeader())
     {
         assert(sourceActorId.getNodeActorId() != 0);
     }
@@ -2239,8 +2416,7 @@ protected:
     /**
      * @brief Default constructor.
      */
-    inline Event() noexcept
-        : EventBase(0, 0, 0, 0)
+    inline Event() noexcept : EventBase(getConstructedHeader())
     {
         assert(sourceActorId.getNodeActorId() != 0);
     }
@@ -2306,6 +2482,15 @@ private:
     static bool isE2ECapable(const char *, EventId &, EventE2ESerializeFunction &, EventE2EDeserializeFunction &);
     static void toOStream(std::ostream &, const OStreamName &);
     static void toOStream(std::ostream &, const OStreamContent &);
+
+    static thread_local const EventBase *constructedHeader; // header of the event being constructed (see Pipe)
+
+    static inline const EventBase &getConstructedHeader() noexcept
+    {
+        // events can only be instantiated by Pipe::push() and the like
+        assert(constructedHeader != 0);
+        return *constructedHeader;
+    }
 };
 #pragma pack(pop)
 
@@ -2498,6 +2683,7 @@ class Actor::Event::AllocatorBase
     /**
      * @brief Getter.
      * @return the maximum byte count that can be allocated in a single call to allocate().
+     * Allocations larger than Engine::getEventAllocatorPageSizeByte() are served by dedicated large pages.
      * @see Engine::getEventAllocatorPageSizeByte().
      */
     size_t max_size() const noexcept;
@@ -2617,6 +2803,116 @@ template <class T> class Actor::Event::Allocator : public Actor::Event::Allocato
     inline size_type max_size() const noexcept { return AllocatorBase::max_size() / sizeof(T); }
 };
 
+/**
+ * @brief Event base class for a variable-length array of T entries stored inline, right after the event.
+ * _Event must publicly inherit from both Event and VarPayload<T>, and be pushed using Pipe::pushVar(),
+ * which reserves the payload in the same event-page as the event itself. The event bytes are therefore
+ * contiguous, and no heap (nor Event::Allocator) memory is involved.
+ * <br>Example:
+ * \code
+ * struct MyEvent : simplx::Actor::Event, simplx::Actor::Event::VarPayload<char> {
+ *     int key;
+ *     MyEvent(int pkey) noexcept : key(pkey) {}
+ * };
+ * MyEvent &event = pipe.pushVar<MyEvent>(s.size(), 123);
+ * std::memcpy(event.data(), s.data(), s.size());
+ * \endcode
+ * The payload is located relative to the event, so that it remains valid wherever the event is mapped
+ * (e.g. shared-memory event-pages).
+ * @attention The payload is not initialized by Pipe::pushVar(), and T must be a trivial type.
+ * A copy of the event does not carry the payload (the copy has an empty payload).
+ */
+template <class T> class Actor::Event::VarPayload
+{
+  public:
+    static_assert(std::is_trivial<T>::value, "variable-length payload entry-type must be trivial");
+    typedef T payload_type; ///< Entry-type of the payload (see Pipe::pushVar())
+
+    /**
+     * @brief Default constructor (empty payload).
+     */
+    inline VarPayload() noexcept : payloadOffset(0), payloadSize(0) {}
+    /**
+     * @brief Copy constructor (empty payload).
+     */
+    inline VarPayload(const VarPayload &) noexcept : payloadOffset(0), payloadSize(0) {}
+    /**
+     * @brief Assignment operator (payload unchanged).
+     */
+    inline VarPayload &operator=(const VarPayload &) noexcept { return *this; }
+    /**
+     * @brief Getter.
+     * @return A pointer to the first payload entry, or 0 if the payload is empty.
+     */
+    inline T *data() noexcept
+    {
+        return payloadSize == 0 ? 0 : reinterpret_cast<T *>(reinterpret_cast<char *>(this) + payloadOffset);
+    }
+    /**
+     * @brief Getter.
+     * @return A const pointer to the first payload entry, or 0 if the payload is empty.
+     */
+    inline const T *data() const noexcept
+    {
+        return payloadSize == 0 ? 0
+                                : reinterpret_cast<const T *>(reinterpret_cast<const char *>(this) + payloadOffset);
+    }
+    /**
+     * @brief Getter.
+     * @return The payload entry count.
+     */
+    inline size_t size() const noexcept { return payloadSize; }
+    /**
+     * @brief Getter.
+     * @return true if the payload has no entry.
+     */
+    inline bool empty() const noexcept { return payloadSize == 0; }
+    inline T *begin() noexcept { return data(); }
+    inline T *end() noexcept { return data() + payloadSize; }
+    inline const T *begin() const noexcept { return data(); }
+    inline const T *end() const noexcept { return data() + payloadSize; }
+    /**
+     * @brief Appends the payload entry count followed by the payload entries to a serial buffer.
+     * @note Meant to be called by the serialize function of a cluster-enabled event (see Event::isE2ECapable()).
+     * @param serialBuffer serial buffer to append to.
+     */
+    inline void serializePayload(SerialBuffer &serialBuffer) const
+    {
+        const uint32_t count = payloadSize;
+        assert(serialBuffer.getCurrentWriteBufferSize() > sizeof(count) + count * sizeof(T));
+        std::memcpy(serialBuffer.getCurrentWriteBuffer(), &count, sizeof(count));
+        serialBuffer.increaseCurrentWriteBufferSize(sizeof(count));
+        if (count != 0)
+        {
+            std::memcpy(serialBuffer.getCurrentWriteBuffer(), data(), count * sizeof(T));
+            serialBuffer.increaseCurrentWriteBufferSize(count * sizeof(T));
+        }
+    }
+    /**
+     * @brief Reads a payload previously appended by serializePayload().
+     * @note Meant to be called by the deserialize function of a cluster-enabled event (see Event::isE2ECapable()),
+     * before pushing the deserialized event using Pipe::pushVar().
+     * @param[in,out] buffer serialized payload, moved past the payload on return.
+     * @param[out] count payload entry count.
+     * @return A pointer to the (possibly unaligned) serialized payload entries.
+     */
+    static inline const void *deserializePayload(const void *&buffer, size_t &count) noexcept
+    {
+        uint32_t serialCount;
+        std::memcpy(&serialCount, buffer, sizeof(serialCount));
+        count = serialCount;
+        const void *ret = static_cast<const char *>(buffer) + sizeof(serialCount);
+        buffer = static_cast<const char *>(ret) + count * sizeof(T);
+        return ret;
+    }
+
+  private:
+    friend class Pipe;
+
+    uint32_t payloadOffset; // byte offset of the payload from this
+    uint32_t payloadSize;   // entry count
+};
+
 /**
  * @brief Event factory class.
  * It connects 2 actors, one (source) on the current event-loop,
@@ -2650,6 +2946,8 @@ class Actor::Event::Pipe
     inline Pipe(const Pipe &other) noexcept : sourceActor(other.sourceActor),
                                               destinationActorId(other.destinationActorId),
                                               asyncNode(other.asyncNode),
+                                              priorityLaneFlag(other.priorityLaneFlag),
+                                              directDeliveryFlag(other.directDeliveryFlag),
                                               eventFactory(other.eventFactory)
     {
 #ifndef NDEBUG
@@ -2691,6 +2989,43 @@ class Actor::Event::Pipe
      * @param destinationActorId actor-id of the new destination actor.
      */
     void setDestinationActorId(const ActorId &destinationActorId) noexcept;
+    /**
+     * @brief Getter.
+     * @return true if events pushed with this pipe use the priority lane (see setPriorityLaneFlag()).
+     */
+    inline bool isPriorityLane() const noexcept { return priorityLaneFlag; }
+    /**
+     * @brief Selects the lane of the events pushed with this pipe (default is the normal lane).
+     * Events pushed to an event-loop in the priority lane are delivered before those pushed in the normal lane
+     * of the same event-loop pair, order being preserved within each lane. It is meant for a few urgent events
+     * (e.g. cancels) which should not wait behind a backlog of regular events.
+     * @attention There is no ordering between the lanes: an event pushed in the priority lane may be delivered
+     * before an event previously pushed in the normal lane.
+     * @note Only applies to in-process destination actors, other events always use the normal lane.
+     * @param priorityLaneFlag true to use the priority lane.
+     */
+    void setPriorityLaneFlag(bool priorityLaneFlag) noexcept;
+    /**
+     * @brief Getter.
+     * @return true if events pushed with this pipe are delivered directly (see setDirectDeliveryFlag()).
+     */
+    inline bool isDirectDelivery() const noexcept { return directDeliveryFlag; }
+    /**
+     * @brief Selects run-to-completion delivery of the events pushed with this pipe (default is queued delivery).
+     * When the destination actor is on the same event-loop as the source actor, a pushed event is delivered
+     * from within push(), by calling the destination actor event-handler, instead of at the next event-loop
+     * iteration. Undelivered events (including those for which the event-handler threw ReturnToSenderException)
+     * are returned to the source actor, also from within push().
+     * Nested direct deliveries (an event-handler pushing with such a pipe) are bounded by
+     * EngineEventDirectDeliveryPolicy, beyond which events are queued as usual.
+     * @attention A directly delivered event has been handled when push() returns, amending it through
+     * the returned reference has no effect. There is no ordering between directly delivered events and
+     * queued ones.
+     * @note Only applies to in-process destination actors of the same event-loop, other events are always queued.
+     * Not available with BufferedPipe.
+     * @param directDeliveryFlag true to deliver directly.
+     */
+    void setDirectDeliveryFlag(bool directDeliveryFlag) noexcept;
     /**
      * @brief Creates a new instance of the template generic type _Event
      * using its default constructor.
@@ -2713,19 +3048,24 @@ class Actor::Event::Pipe
         _Event *ret = newEvent<_Event>(destinationEventChain);
         destinationEventChain->push_back(ret);
         ENTERPRISE_0X5019(sourceActor.getAsyncNode(), ret, &sourceActor, this);
+        deliverDirectEvent(*destinationEventChain);
         return *ret;
     }
     /**
      * @brief Creates a new instance of the template generic type _Event
      * using its one-argument constructor.
      * _Event must publicly inherit from Event and have a public constructor, possibly variadic.
+     * The arguments are perfectly forwarded to that constructor, so that rvalues are moved in place
+     * (e.g. move-only payloads).
      * The created event is transmitted to pipe's destination actor (see Actor::registerEventHandler()).
      * If the transmission was unsuccessful (e.g. invalid destination actor), the event will
      * be returned to pipe's source actor (see Actor::registerUndeliveredEventHandler()).
      * @attention The newly created event's reference remains valid until the current event-batch
      * is committed (see Batch). Under batch-control, future access to that reference
      * is safe.
-     * @param args parameter(s) to be passed as argument to the constructor of the new event.
+     * @attention Events are never destroyed, their memory is reclaimed along with their event-batch.
+     * Any memory owned by an event must therefore be allocated using Event::Allocator.
+     * @param args parameter(s) to be forwarded as argument to the constructor of the new event.
      * @return A reference to the newly created event.
      * @throw std::bad_alloc
      * @throw ? Any other exception possibly thrown depending on _Event (the template generic type)
@@ -2734,9 +3074,10 @@ class Actor::Event::Pipe
 
 	template<class _Event, class... _Args> inline _Event& push(_Args&&...args) {
 		EventChain* destinationEventChain;
-		_Event* ret = newEvent<_Event>(destinationEventChain, args...);
+		_Event* ret = newEvent<_Event>(destinationEventChain, std::forward<_Args>(args)...);
 		destinationEventChain->push_back(ret);
         ENTERPRISE_0X5020(sourceActor.getAsyncNode(), ret, &sourceActor, this);
+        deliverDirectEvent(*destinationEventChain);
 		return *ret;
 	}
 
@@ -2746,9 +3087,32 @@ class Actor::Event::Pipe
 		_Event* ret = newEvent<_Event>(destinationEventChain, eventInit);
 		destinationEventChain->push_back(ret);
         ENTERPRISE_0X5021(sourceActor.getAsyncNode(), ret, &sourceActor, this);
+        deliverDirectEvent(*destinationEventChain);
 
 		return *ret;
 	}
+    /**
+     * @brief Same as push(), but also reserves a variable-length payload of payloadSize entries
+     * right after the new event, in the same event-page (see VarPayload).
+     * _Event must publicly inherit from both Event and VarPayload<_Event::payload_type>.
+     * The payload is not initialized, it is meant to be filled through the returned reference
+     * (see VarPayload::data()) before the current event-batch is committed.
+     * @param payloadSize payload entry count.
+     * @param args parameter(s) to be forwarded as argument to the constructor of the new event.
+     * @return A reference to the newly created event.
+     * @throw std::bad_alloc
+     * @throw ? Any other exception possibly thrown depending on _Event (the template generic type)
+     * constructor call.
+     */
+    template <class _Event, class... _Args> inline _Event &pushVar(size_t payloadSize, _Args &&... args)
+    {
+        EventChain *destinationEventChain;
+        _Event *ret = newVarEvent<_Event>(destinationEventChain, payloadSize, std::forward<_Args>(args)...);
+        destinationEventChain->push_back(ret);
+        ENTERPRISE_0X5020(sourceActor.getAsyncNode(), ret, &sourceActor, this);
+        deliverDirectEvent(*destinationEventChain);
+        return *ret;
+    }
     /**
      * @brief Allocates an array of T entry-type in the current event-batch dedicated memory.
      * @note equivalent to (with less overhead):
@@ -2777,30 +3141,86 @@ class Actor::Event::Pipe
         return static_cast<T *>((*eventFactory.allocateAndGetIndexFn)(n * sizeof(T), eventFactory.context,
                                                                       eventPageIndex, eventPageOffset));
     }
+    /**
+     * @brief Getter to the flow-control status of the pipe (see EngineEventFlowControlPolicy).
+     * All pipes from the current event-loop to the destination event-loop share the same status.
+     * @return true if events outstanding to the destination event-loop are below flow-control limits.
+     */
+    bool isWritable() const noexcept;
+    /**
+     * @brief Same as push(), unless the pipe is not writable (see isWritable()).
+     * @param args parameter(s) to be passed as argument to the constructor of the new event.
+     * @return A pointer to the newly created event, or 0 if the pipe is not writable.
+     * @throw std::bad_alloc
+     * @throw ? Any other exception possibly thrown depending on _Event (the template generic type)
+     * constructor call.
+     */
+    template <class _Event, class... _Args> inline _Event *tryPush(_Args &&... args)
+    {
+        return isWritable() ? &push<_Event>(std::forward<_Args>(args)...) : 0;
+    }
+    /**
+     * @brief Registers a callback-handler to be called once the pipe is writable (see isWritable()),
+     * i.e. once the destination event-loop has drained enough outstanding events.
+     * The registration is one-shot: onCallback() is called once, at the next event-loop iteration
+     * if the pipe is already writable.
+     * _Callback must publicly inherit from Callback and implement onCallback() (see Actor::registerCallback()).
+     * @param callbackHandler callback-handler to be registered, on behalf of the source actor.
+     */
+    template <class _Callback> inline void registerOnWritableCallback(_Callback &callbackHandler) noexcept
+    {
+        registerOnWritableCallback(StaticCallbackHandler<_Callback>::onCallback, callbackHandler);
+    }
 
   private:
     friend class AllocatorBase;
     friend class Batch;
     friend class BufferedPipe;
+    friend class MulticastPipe;
     friend class EngineToEngineConnectorEventFactory;
     typedef Event::Chain EventChain;
 
         template<class _Event>
-        struct EventWrapper: virtual private EventBase, _Event
+        struct EventWrapper: _Event
         {
             inline
-            EventWrapper(const Pipe& eventPipe, route_offset_type routeOffset)
-                : EventBase(Event::getClassId<_Event>(), eventPipe.sourceActor.getActorId(), eventPipe.destinationActorId, routeOffset)
+            EventWrapper()
             {
             }
 	
             template<class... Args>
             inline
-            EventWrapper(const Pipe& eventPipe, route_offset_type routeOffset, Args&&... args)
-                : EventBase(Event::getClassId<_Event>(), eventPipe.sourceActor.getActorId(), eventPipe.destinationActorId, routeOffset), _Event(args...)
+            EventWrapper(Args&&... args)
+                : _Event(std::forward<Args>(args)...)
             {
             }
         };
+
+    /**
+     * Publishes the header of the event being constructed to Event's base constructor,
+     * so that the header is valid from within the Event sub-class constructor.
+     */
+    class ConstructedHeader
+    {
+      public:
+        inline ConstructedHeader(const EventBase &header) noexcept : previousHeader(Event::constructedHeader)
+        {
+            Event::constructedHeader = &header;
+        }
+        inline ~ConstructedHeader() noexcept { Event::constructedHeader = previousHeader; }
+
+      private:
+        const EventBase *const previousHeader; // an event constructor may itself push events
+    };
+    template <class _Event, class... _Args>
+    static inline _Event *newEventWrapper(void *eventBuffer, const Pipe &eventPipe, route_offset_type routeOffset,
+                                          _Args &&... args)
+    { // throw (std::bad_alloc, ...)
+        const EventBase header(Event::getClassId<_Event>(), eventPipe.sourceActor.getActorId(),
+                               eventPipe.destinationActorId, routeOffset);
+        ConstructedHeader headerScope(header);
+        return new (eventBuffer) EventWrapper<_Event>(std::forward<_Args>(args)...);
+    }
     
     struct EventFactory : AllocatorBase::Factory
     {
@@ -2824,6 +3244,8 @@ class Actor::Event::Pipe
     Actor &sourceActor;
     ActorId destinationActorId;
     AsyncNode &asyncNode;
+    bool priorityLaneFlag;
+    bool directDeliveryFlag;
     EventFactory eventFactory;
 
     Pipe &operator=(const Pipe &);
@@ -2837,7 +3259,20 @@ class Actor::Event::Pipe
             --sourceActor.processOutPipeCount;
         }
     }
+    void registerOnWritableCallback(void (*onCallback)(Callback &) noexcept, Callback &) noexcept;
     void *newInProcessEvent(size_t, EventChain *&, uintptr_t, Event::route_offset_type &);    // throw (std::bad_alloc)
+    void *newInProcessPriorityEvent(size_t, EventChain *&, uintptr_t,
+                                    Event::route_offset_type &); // throw (std::bad_alloc)
+    void *newInProcessDirectEvent(size_t, EventChain *&, uintptr_t,
+                                  Event::route_offset_type &); // throw (std::bad_alloc)
+    void deliverDirectEvents(EventChain &) noexcept;
+    inline void deliverDirectEvent(EventChain &destinationEventChain) noexcept
+    {
+        if (eventFactory.newFn == &Pipe::newInProcessDirectEvent)
+        {
+            deliverDirectEvents(destinationEventChain);
+        }
+    }
     void *newOutOfProcessEvent(size_t, EventChain *&, uintptr_t, Event::route_offset_type &); // throw (std::bad_alloc)
     void *newOutOfProcessEvent(void *, size_t, EventChain *&, uintptr_t,
                                       Event::route_offset_type &); // throw (std::bad_alloc)
@@ -2857,20 +3292,41 @@ class Actor::Event::Pipe
     template <class _Event> inline _Event *newEvent(EventChain *&destinationEventChain)
     { // throw (std::bad_alloc, ...)
         Event::route_offset_type routeOffset = 0;
-        _Event *ret =
-            new ((this->*eventFactory.newFn)(sizeof(EventWrapper<_Event>), destinationEventChain,
-                                             (uintptr_t) static_cast<Event *>((EventWrapper<_Event> *)0), routeOffset))
-                EventWrapper<_Event>(*this, routeOffset);
-        return ret;
+        void *eventBuffer =
+            (this->*eventFactory.newFn)(sizeof(EventWrapper<_Event>), destinationEventChain,
+                                        (uintptr_t) static_cast<Event *>((EventWrapper<_Event> *)0), routeOffset);
+        return newEventWrapper<_Event>(eventBuffer, *this, routeOffset);
     }
 	template<class _Event, class... Args> inline _Event* newEvent(EventChain*& destinationEventChain, Args&&...args) { // throw (std::bad_alloc, ...)
 		Event::route_offset_type routeOffset = 0;
-		_Event* ret = new (
-				(this->*eventFactory.newFn)(sizeof(EventWrapper<_Event> ),
-						destinationEventChain, (uintptr_t)static_cast<Event*>((EventWrapper<_Event>*)0), routeOffset)) EventWrapper<_Event>(*this,
-				routeOffset, args...);
-		return ret;
+		void* eventBuffer = (this->*eventFactory.newFn)(sizeof(EventWrapper<_Event> ),
+				destinationEventChain, (uintptr_t)static_cast<Event*>((EventWrapper<_Event>*)0), routeOffset);
+		return newEventWrapper<_Event>(eventBuffer, *this, routeOffset, std::forward<Args>(args)...);
 	}
+    template <class _Event, class... _Args>
+    inline _Event *newVarEvent(EventChain *&destinationEventChain, size_t payloadSize, _Args &&... args)
+    { // throw (std::bad_alloc, ...)
+        typedef typename _Event::payload_type T;
+        const size_t maxPayloadByteSize =
+            std::numeric_limits<uint32_t>::max() - sizeof(EventWrapper<_Event>) - alignof(T);
+        if (payloadSize > maxPayloadByteSize / sizeof(T))
+        {
+            throw std::bad_alloc();
+        }
+        const size_t payloadByteSize = payloadSize * sizeof(T);
+        Event::route_offset_type routeOffset = 0;
+        // event pages do not align events: over-allocate so that the payload can be aligned
+        char *eventBuffer = static_cast<char *>((this->*eventFactory.newFn)(
+            sizeof(EventWrapper<_Event>) + alignof(T) - 1 + payloadByteSize, destinationEventChain,
+            (uintptr_t) static_cast<Event *>((EventWrapper<_Event> *)0), routeOffset));
+        _Event *ret = newEventWrapper<_Event>(eventBuffer, *this, routeOffset, std::forward<_Args>(args)...);
+        VarPayload<T> &varPayload = *ret;
+        uintptr_t payload = reinterpret_cast<uintptr_t>(eventBuffer + sizeof(EventWrapper<_Event>));
+        payload = (payload + alignof(T) - 1) & ~(uintptr_t)(alignof(T) - 1);
+        varPayload.payloadOffset = (uint32_t)(payload - reinterpret_cast<uintptr_t>(&varPayload));
+        varPayload.payloadSize = (uint32_t)payloadSize;
+        return ret;
+    }
 };
 
 /**
@@ -2942,7 +3398,13 @@ class Actor::Event::BufferedPipe : public Actor::Event::Pipe
      * @brief Copy constructor.
      * @param other another pipe.
      */
-    inline BufferedPipe(const Pipe &pipe) noexcept : Pipe(pipe), batch(*this), destinationEventChain(0) {}
+    inline BufferedPipe(const Pipe &pipe) noexcept : Pipe(pipe), batch(*this), destinationEventChain(0)
+    {
+        if (isDirectDelivery())
+        { // not available (see Pipe::setDirectDeliveryFlag())
+            Pipe::setDirectDeliveryFlag(false);
+        }
+    }
     /**
      * @brief Creates a new instance of the template generic type _Event
      * using its default constructor.
@@ -2980,7 +3442,8 @@ class Actor::Event::BufferedPipe : public Actor::Event::Pipe
     }
     /**
      * @brief Creates a new instance of the template generic type _Event.
-     * _Event must publicly inherit from Event and have a public one-argument constructor.
+     * _Event must publicly inherit from Event and have a public constructor, possibly variadic.
+     * The arguments are perfectly forwarded to that constructor (see Pipe::push()).
      * The created event is stored for later transfer (see flush()) to pipe's destination actor
      * (see Actor::registerEventHandler()).
      * Eventually, if the transmission was unsuccessful (e.g. invalid destination actor),
@@ -2988,7 +3451,7 @@ class Actor::Event::BufferedPipe : public Actor::Event::Pipe
      * @attention The newly created event's reference remains valid until the current event-batch
      * is committed (see Batch). Under batch-control, future access to that reference
      * is safe.
-     * @param eventInit parameter to be passed as argument to the constructor of the new event.
+     * @param args parameter(s) to be forwarded as argument to the constructor of the new event.
      * @return A reference to the newly created event.
      * @throw MixedBatchBufferedEventsException Existing non-flushed/cleared Event
      * that had been pushed in a different event-batch than this push.
@@ -2996,7 +3459,7 @@ class Actor::Event::BufferedPipe : public Actor::Event::Pipe
      * @throw ? Any other exception possibly thrown depending on _Event (the template generic type)
      * constructor call.
      */
-    template <class _Event, class _EventInit> inline _Event &push(const _EventInit &eventInit)
+    template <class _Event, class... _Args> inline _Event &push(_Args &&... args)
     {
         if (batch.isPushCommitted(*this) && !eventChain.empty())
         {
@@ -3006,7 +3469,7 @@ class Actor::Event::BufferedPipe : public Actor::Event::Pipe
 #ifndef NDEBUG
         EventChain *oldDestinationEventChain = destinationEventChain;
 #endif
-        _Event *ret = newEvent<_Event>(destinationEventChain, eventInit);
+        _Event *ret = newEvent<_Event>(destinationEventChain, std::forward<_Args>(args)...);
         assert(oldDestinationEventChain == 0 || oldDestinationEventChain == destinationEventChain);
         eventChain.push_back(ret);
         ENTERPRISE_0X5023(sourceActor.getAsyncNode(), ret, &sourceActor, this);
@@ -3062,10 +3525,125 @@ class Actor::Event::BufferedPipe : public Actor::Event::Pipe
     EventChain *destinationEventChain;
     EventChain eventChain;
 
+    using Pipe::setDirectDeliveryFlag;
     BufferedPipe(const BufferedPipe &);
     BufferedPipe &operator=(const BufferedPipe &);
 };
 
+/**
+ * @brief Event factory class pushing the same event to a set of destination actors.
+ *
+ * Using the push() method, the event is created once per destination event-loop (cpu-core),
+ * which then delivers that single instance to each of its destination actors (see Actor::registerEventHandler()),
+ * rather than once per destination actor as with as many Pipe::push() calls.
+ * Events pushed to an out-of-process destination actor are still created once per destination actor.
+ * <br>Order is the same as with Pipe: events pushed from the source actor to a destination actor,
+ * either with a Pipe or a MulticastPipe, are delivered in the order they were pushed.
+ * If the transmission to a destination actor was unsuccessful (e.g. invalid destination actor),
+ * the event is returned to the source actor for that destination actor only
+ * (see Actor::registerUndeliveredEventHandler()).
+ * @attention As the same event instance is shared between the destination actors of an event-loop,
+ * its getDestinationActorId() is only meaningful during the onEvent() (or onUndeliveredEvent()) call.
+ */
+class Actor::Event::MulticastPipe
+{
+  public:
+    /**
+     * @brief Constructor, with an empty set of destination actors.
+     * @param sourceActor source actor.
+     */
+    MulticastPipe(Actor &sourceActor) noexcept;
+    /**
+     * @brief Getter.
+     * @return actor-id of the source actor.
+     */
+    inline const ActorId &getSourceActorId() const noexcept { return sourceActor.getActorId(); }
+    /**
+     * @brief Adds a destination actor to the set. Has no effect if actorId is null or already in the set.
+     * @param actorId actor-id of the destination actor.
+     * @throw std::bad_alloc
+     */
+    void addDestinationActorId(const ActorId &actorId);
+    /**
+     * @brief Removes a destination actor from the set. Has no effect if actorId is not in the set.
+     * @param actorId actor-id of the destination actor.
+     */
+    void removeDestinationActorId(const ActorId &actorId) noexcept;
+    /**
+     * @brief Removes all destination actors from the set.
+     */
+    void clearDestinationActorIds() noexcept;
+    /**
+     * @brief Getter.
+     * @return the number of destination actors in the set.
+     */
+    inline size_t getDestinationActorIdCount() const noexcept { return destinationActorIds.size(); }
+    /**
+     * @brief Creates new instances of the template generic type _Event,
+     * one per destination event-loop of the set (see class description).
+     * _Event must publicly inherit from Event and have a public constructor, possibly variadic.
+     * @param args parameter(s) to be passed as argument to the constructor of each new event.
+     * @throw std::bad_alloc
+     * @throw ? Any other exception possibly thrown depending on _Event (the template generic type)
+     * constructor call.
+     */
+    template <class _Event, class... _Args> inline void push(const _Args &... args)
+    {
+        for (size_t i = 0, j, endi = destinationActorIds.size(); i != endi; i = j)
+        {
+            Pipe pipe(sourceActor, destinationActorIds[i]);
+            if ((j = getDestinationNodeEnd(i)) == i + 1)
+            {
+                pipe.push<_Event>(args...);
+            }
+            else
+            {
+                pushMulticastEvent(pipe, *Pipe::newEventWrapper<_Event>(
+                                             pipe.allocate<char>(sizeof(Pipe::EventWrapper<_Event>)), pipe, 0, args...),
+                                   i, j);
+            }
+        }
+    }
+
+  private:
+    friend class AsyncNodesHandle;
+    friend class AsyncNode;
+    typedef std::vector<ActorId, Actor::Allocator<ActorId>> DestinationActorIdVector;
+    struct MulticastEvent;
+
+    Actor &sourceActor;
+    DestinationActorIdVector destinationActorIds; // in-process actors first, ordered by event-loop
+
+    MulticastPipe(const MulticastPipe &);
+    MulticastPipe &operator=(const MulticastPipe &);
+    size_t getDestinationNodeEnd(size_t) const noexcept;
+    void pushMulticastEvent(Pipe &, Event &, size_t, size_t); // throw (std::bad_alloc)
+};
+
+/**
+ * @brief Pushed in place of the event of a MulticastPipe, which it references, to an event-loop.
+ * The destination event-loop sets the destination actor-ids to null as the event gets delivered to them,
+ * the others are returned to the source actor (see AsyncNodesHandle::onMulticastEvent()).
+ */
+struct Actor::Event::MulticastPipe::MulticastEvent : Actor::Event
+{
+    Event &event;
+    InProcessActorId *const destinationActorIds;
+    const size_t destinationActorIdCount;
+    inline MulticastEvent(Event &pevent, InProcessActorId *pdestinationActorIds,
+                          size_t pdestinationActorIdCount) noexcept : event(pevent),
+                                                                      destinationActorIds(pdestinationActorIds),
+                                                                      destinationActorIdCount(pdestinationActorIdCount)
+    {
+    }
+    inline Event &getEvent(size_t destinationIndex) noexcept
+    {
+        assert(destinationIndex < destinationActorIdCount);
+        event.destinationActorId = destinationActorIds[destinationIndex];
+        return event;
+    }
+};
+
 template <class _Event, class _EventHandler> struct Actor::StaticEventHandler
 {
     static bool onEvent(void *eventHandler, const Event &event)
@@ -3099,6 +3677,126 @@ template <class _Callback> void Actor::registerPerformanceNeutralCallback(_Callb
     registerPerformanceNeutralCallback(StaticCallbackHandler<_Callback>::onCallback, callback);
 }
 
+/**
+ * @brief Completion event of a task submitted using Actor::offload().
+ * @note exception is allocated using the event-allocator, it is only valid during the event-handler call.
+ */
+template <class _Result> struct Actor::OffloadEvent : Event
+{
+    const OffloadToken token;  ///< Token returned by Actor::offload().
+    const _Result result;      ///< Value returned by the task, default-constructed if the task threw an exception.
+    const char *const exception; ///< Description of the exception thrown by the task, 0 if none.
+    inline OffloadEvent(OffloadToken ptoken, const _Result &presult, const char *pexception)
+        : token(ptoken), result(presult), exception(pexception)
+    {
+    }
+};
+
+/**
+ * @brief Completion event of a task returning void submitted using Actor::offload().
+ * @note exception is allocated using the event-allocator, it is only valid during the event-handler call.
+ */
+template <> struct Actor::OffloadEvent<void> : Event
+{
+    const OffloadToken token;  ///< Token returned by Actor::offload().
+    const char *const exception; ///< Description of the exception thrown by the task, 0 if none.
+    inline OffloadEvent(OffloadToken ptoken, const char *pexception) noexcept : token(ptoken), exception(pexception) {}
+};
+
+struct Actor::OffloadTask
+{
+    ActorId actorId;
+    OffloadToken token;
+    Time submitTime;
+    OffloadTask *next;
+    std::string exception;
+    bool exceptionFlag;
+    inline OffloadTask() noexcept : token(0), next(0), exceptionFlag(false) {}
+    virtual ~OffloadTask() noexcept {}
+    // called from an executor thread
+    virtual void onExecute() noexcept = 0;
+    // called from the event-loop of the actor which submitted the task, the completion event being pushed from
+    // offloadActor
+    virtual void onComplete(Actor &offloadActor) = 0; // throw (std::bad_alloc)
+    inline void setException(const char *what) noexcept
+    {
+        exceptionFlag = true;
+        try
+        {
+            exception = what;
+        }
+        catch (...)
+        {
+        }
+    }
+    inline const char *newException(Event::Pipe &pipe) const // throw (std::bad_alloc)
+    {
+        return exceptionFlag ? Event::newCString(pipe.getAllocator(), exception.c_str()) : 0;
+    }
+};
+
+template <class _Task, class _Result> struct Actor::OffloadTaskImpl : OffloadTask
+{
+    _Task task;
+    _Result result;
+    inline OffloadTaskImpl(const _Task &ptask) : task(ptask), result() {}
+    virtual void onExecute() noexcept
+    {
+        try
+        {
+            result = task();
+        }
+        catch (const std::exception &e)
+        {
+            setException(e.what());
+        }
+        catch (...)
+        {
+            setException("?");
+        }
+    }
+    virtual void onComplete(Actor &offloadActor)
+    {
+        Event::Pipe pipe(offloadActor, actorId);
+        pipe.push<OffloadEvent<_Result>>(token, result, newException(pipe));
+    }
+};
+
+template <class _Task> struct Actor::OffloadTaskImpl<_Task, void> : OffloadTask
+{
+    _Task task;
+    inline OffloadTaskImpl(const _Task &ptask) : task(ptask) {}
+    virtual void onExecute() noexcept
+    {
+        try
+        {
+            task();
+        }
+        catch (const std::exception &e)
+        {
+            setException(e.what());
+        }
+        catch (...)
+        {
+            setException("?");
+        }
+    }
+    virtual void onComplete(Actor &offloadActor)
+    {
+        Event::Pipe pipe(offloadActor, actorId);
+        pipe.push<OffloadEvent<void>>(token, newException(pipe));
+    }
+};
+
+template <class _Task> Actor::OffloadToken Actor::offload(const _Task &task)
+{
+    typedef typename std::decay<decltype(std::declval<_Task &>()())>::type Result;
+    std::unique_ptr<OffloadTask> offloadTask(new OffloadTaskImpl<_Task, Result>(task));
+    OffloadToken ret = offload(*offloadTask);
+    offloadTask.release();
+    return ret;
+}
+
 template <class _Event, class _EventHandler>
 void Actor::registerEventHandler(_EventHandler &eventHandler)
 {
@@ -3137,6 +3835,11 @@ template <class _Event> bool Actor::isRegisteredEventHandler() const noexcept
     return isRegisteredEventHandler(Event::getClassId<_Event>());
 }
 
+template <class _Event> bool Actor::isHighFrequencyEventHandler() const noexcept
+{
+    return isRegisteredHighPriorityEventHandler(Event::getClassId<_Event>());
+}
+
 template <class _Event> bool Actor::isRegisteredUndeliveredEventHandler() const noexcept
 {
     return isRegisteredUndeliveredEventHandler(Event::getClassId<_Event>());
@@ -50,12 +50,13 @@ namespace simplx
 class Engine;
 class AsyncNodeManager;
 class EngineCustomEventLoopFactory;
+class OffloadExecutor;
 class EngineToEngineConnector;
 
 /**
  * @brief Asynchronous exception handler that contains a Mutex that is locked for screen output.
- * onEventException() and onUnreachableException() can be specialized by inheritance. These
- * methods are called by the engine under mutex-lock.
+ * onEventException(), onUnreachableException() and onCallbackException() can be specialized by inheritance.
+ * These methods are called by the engine under mutex-lock.
  * In case of specialization, use Engine::StartSequence::setExceptionHandler() method
  * to set the reference of an external exception-handler.
  * <br><b>The external exception-handler instance must outlive the engine instance.</b>
@@ -68,6 +69,8 @@ public:
     
     virtual void onEventException(Actor *, const std::type_info &asyncActorTypeInfo, const char *onXXX_FunctionName, const Actor::Event &, const char *whatException) noexcept;
     virtual void onUnreachableException(Actor &, const std::type_info &asyncActorTypeInfo, const Actor::ActorId::RouteIdComparable &, const char *whatException) noexcept;
+    // exception caught by an engine actor outside of an event-handler (e.g. pushing offload() completion events)
+    virtual void onCallbackException(Actor *, const std::type_info &asyncActorTypeInfo, const char *onXXX_FunctionName, const char *whatException) noexcept;
     
     // wrappers to lock mutex & redirect to above
     void onEventExceptionSynchronous(Actor *asyncActor, const std::type_info &asyncActorTypeInfo, const char *onXXX_FunctionName, const Actor::Event &event, const char *whatException) noexcept
@@ -82,12 +85,298 @@ public:
     
         onUnreachableException(asyncActor, asyncActorTypeInfo, routeIdComparable, whatException);
     }
+    void onCallbackExceptionSynchronous(Actor *asyncActor, const std::type_info &asyncActorTypeInfo, const char *onXXX_FunctionName, const char *whatException) noexcept
+    {
+        Mutex::Lock lock(m_Mutex);
+    
+        onCallbackException(asyncActor, asyncActorTypeInfo, onXXX_FunctionName, whatException);
+    }
 
 private:
 
     Mutex   m_Mutex;
 };
 
+/**
+ * @brief Idle policy of the default event-loop, applied once an event-loop iteration had nothing to process
+ * (no event, no callback).
+ * The idle event-loop keeps spinning for spinLoopCount iterations, then executes a cpu pause instruction
+ * (see cpuPause()) at each of the next pauseLoopCount iterations, and then parks its thread until a peer
+ * event-loop writes to it, or parkTimeOut expires.
+ * An event-loop with pending performance-neutral callbacks (e.g. timers) or pending writes never parks.
+ * The default policy keeps spinning, as do red-zone event-loops whatever the policy.
+ * @see Engine::StartSequence::setIdlePolicy()
+ * @see Actor::CorePerformanceCounters::getIdleParkNanosecond()
+ */
+struct EngineIdlePolicy
+{
+    uint64_t spinLoopCount;
+    uint64_t pauseLoopCount;
+    Time parkTimeOut;
+    /** @brief Default constructor (pure spinning) */
+    inline EngineIdlePolicy() noexcept
+        : spinLoopCount(std::numeric_limits<uint64_t>::max()), pauseLoopCount(std::numeric_limits<uint64_t>::max()),
+          parkTimeOut(Time::Millisecond(100))
+    {
+    }
+    /**
+     * @brief Constructor
+     * @param pspinLoopCount idle iterations before pausing
+     * @param ppauseLoopCount idle pausing iterations before parking
+     * @param pparkTimeOut maximum parking duration, which bounds the latency of a peer event-loop
+     * stop detection
+     */
+    inline EngineIdlePolicy(uint64_t pspinLoopCount, uint64_t ppauseLoopCount,
+                            const Time &pparkTimeOut = Time::Millisecond(100)) noexcept
+        : spinLoopCount(pspinLoopCount), pauseLoopCount(ppauseLoopCount), parkTimeOut(pparkTimeOut)
+    {
+    }
+    /**
+     * @return true if the policy never lets the event-loop park.
+     */
+    inline bool isSpinning() const noexcept
+    {
+        return spinLoopCount == std::numeric_limits<uint64_t>::max() ||
+               pauseLoopCount == std::numeric_limits<uint64_t>::max();
+    }
+};
+
+/**
+ * @brief Trimming policy of the free event pages, which accumulate per writer/reader pair of event-loops
+ * after bursts of events.
+ * Once an event-loop has gone idleLoopCount iterations without work nor event writes, or before it parks
+ * (see EngineIdlePolicy), the free pages of each of its pairs in excess of freePageHighWatermark are released
+ * to the system. Trimmed pages are kept for reuse, their memory being faulted back on next use.
+ * Huge page backed event pages (see Engine::StartSequence::setEventAllocatorHugePageFlag()) are never trimmed.
+ * The default policy never trims.
+ * @see Engine::StartSequence::setEventPageTrimPolicy()
+ * @see Engine::getEventPageCount()
+ */
+struct EngineEventPageTrimPolicy
+{
+    size_t freePageHighWatermark;
+    uint64_t idleLoopCount;
+    /** @brief Default constructor (no trimming) */
+    inline EngineEventPageTrimPolicy() noexcept
+        : freePageHighWatermark(std::numeric_limits<size_t>::max()), idleLoopCount(1000)
+    {
+    }
+    /**
+     * @brief Constructor
+     * @param pfreePageHighWatermark free pages kept per writer/reader pair
+     * @param pidleLoopCount idle iterations before trimming
+     */
+    inline EngineEventPageTrimPolicy(size_t pfreePageHighWatermark, uint64_t pidleLoopCount = 1000) noexcept
+        : freePageHighWatermark(pfreePageHighWatermark), idleLoopCount(pidleLoopCount)
+    {
+    }
+};
+
+/**
+ * @brief Flow-control policy of the events pushed from an event-loop to another (or to itself).
+ * Events pushed by a writer event-loop for a reader event-loop are outstanding until the reader has processed
+ * the batch holding them. Once outstanding events reach maxOutstandingEventCount, or their size (including
+ * memory allocated with Event::Allocator) reaches maxOutstandingByteSize, the pipes of that pair of event-loops
+ * stop being writable until the reader drains the batch.
+ * Writability is only advisory: Event::Pipe::push() never fails on flow-control, whereas Event::Pipe::tryPush()
+ * does, and Event::Pipe::registerOnWritableCallback() notifies when pushing is allowed again.
+ * The default policy never limits.
+ * @see Engine::StartSequence::setEventFlowControlPolicy()
+ */
+struct EngineEventFlowControlPolicy
+{
+    uint64_t maxOutstandingEventCount;
+    uint64_t maxOutstandingByteSize;
+    /** @brief Default constructor (no limit) */
+    inline EngineEventFlowControlPolicy() noexcept
+        : maxOutstandingEventCount(std::numeric_limits<uint64_t>::max()),
+          maxOutstandingByteSize(std::numeric_limits<uint64_t>::max())
+    {
+    }
+    /**
+     * @brief Constructor
+     * @param pmaxOutstandingEventCount outstanding events per writer/reader pair
+     * @param pmaxOutstandingByteSize outstanding bytes per writer/reader pair
+     */
+    inline EngineEventFlowControlPolicy(
+        uint64_t pmaxOutstandingEventCount,
+        uint64_t pmaxOutstandingByteSize = std::numeric_limits<uint64_t>::max()) noexcept
+        : maxOutstandingEventCount(pmaxOutstandingEventCount),
+          maxOutstandingByteSize(pmaxOutstandingByteSize)
+    {
+    }
+};
+
+/**
+ * @brief Delivery budget policy of an event-loop, bounding the time spent delivering in-process events.
+ * At each iteration, an event-loop delivers at most maxEventCount events, or for at most maxTSCTickCount
+ * time-stamp counter ticks (see getTSC()), out of the batches received from all peer event-loops and from itself
+ * together. The first event of each batch is delivered regardless, so that every batch makes progress.
+ * The remainder of a batch is delivered at the next iterations, in order, leaving room for callbacks,
+ * timers and other peers in-between. The peer event-loop cannot write a new batch until then.
+ * The default policy has no budget, nor has a maxEventCount of 0.
+ * @see Engine::StartSequence::setEventDeliveryBudgetPolicy()
+ * @see Actor::CorePerformanceCounters::getDeliveryBudgetHitCountFrom()
+ */
+struct EngineEventDeliveryBudgetPolicy
+{
+    uint64_t maxEventCount;
+    uint64_t maxTSCTickCount;
+    /** @brief Default constructor (no budget) */
+    inline EngineEventDeliveryBudgetPolicy() noexcept
+        : maxEventCount(std::numeric_limits<uint64_t>::max()), maxTSCTickCount(std::numeric_limits<uint64_t>::max())
+    {
+    }
+    /**
+     * @brief Constructor
+     * @param pmaxEventCount events delivered per iteration (0 for no limit)
+     * @param pmaxTSCTickCount time-stamp counter ticks spent delivering per iteration
+     */
+    inline EngineEventDeliveryBudgetPolicy(
+        uint64_t pmaxEventCount, uint64_t pmaxTSCTickCount = std::numeric_limits<uint64_t>::max()) noexcept
+        : maxEventCount(pmaxEventCount),
+          maxTSCTickCount(pmaxTSCTickCount)
+    {
+    }
+};
+
+/**
+ * @brief Placement policy of the actors' event-handlers between the high-frequency part of an actor event-table
+ * (a few handlers, looked up at once within the cache lines of the table) and its low-frequency part.
+ * By default, the first handlers registered go to the high-frequency part. With this policy, each event-loop
+ * counts dispatches per actor and event, and once it has dispatched eventCount events since the previous
+ * placement, it promotes the hottest handlers of each actor to the high-frequency part, demoting the coldest
+ * ones (a low-frequency handler is promoted in place of a high-frequency one dispatched less than half as often).
+ * Placement takes place between two event-loop iterations, and never changes which handler gets an event.
+ * The default policy never moves handlers.
+ * @see Engine::StartSequence::setEventHandlerPlacementPolicy()
+ * @see Actor::CorePerformanceCounters::getEventHandlerPromotionCount()
+ * @see Actor::isHighFrequencyEventHandler()
+ */
+struct EngineEventHandlerPlacementPolicy
+{
+    uint64_t eventCount;
+    /** @brief Default constructor (no placement) */
+    inline EngineEventHandlerPlacementPolicy() noexcept : eventCount(std::numeric_limits<uint64_t>::max()) {}
+    /**
+     * @brief Constructor
+     * @param peventCount events dispatched by an event-loop between two placements
+     */
+    inline EngineEventHandlerPlacementPolicy(uint64_t peventCount) noexcept : eventCount(peventCount) {}
+};
+
+/**
+ * @brief Direct delivery policy of the events pushed to an actor of the same event-loop
+ * (see Actor::Event::Pipe::setDirectDeliveryFlag()).
+ * Such events are delivered from within the push, by calling the destination event-handler,
+ * instead of being queued until the next event-loop iteration. As an event-handler can itself push
+ * directly delivered events, nested direct deliveries are bounded by maxDepth: beyond it, pushed events
+ * are queued as usual.
+ * The default policy (maxDepth 0) queues all events.
+ * @see Engine::StartSequence::setEventDirectDeliveryPolicy()
+ */
+struct EngineEventDirectDeliveryPolicy
+{
+    size_t maxDepth;
+    /** @brief Default constructor (no direct delivery) */
+    inline EngineEventDirectDeliveryPolicy() noexcept : maxDepth(0) {}
+    /**
+     * @brief Constructor
+     * @param pmaxDepth nested direct deliveries per event-loop
+     */
+    inline EngineEventDirectDeliveryPolicy(size_t pmaxDepth) noexcept : maxDepth(pmaxDepth) {}
+};
+
+/**
+ * @brief Software prefetch policy of the events read by an event-loop.
+ * Dispatching an event reads the event, then its destination actor event-table, then the destination actor, each
+ * read being a dependent cache miss when the event-loop handles many actors. With this policy, the event-loop
+ * prefetches the event distance events ahead of the dispatched one, the event-table of the event distance / 2 events
+ * ahead and the actor of the event distance / 4 events ahead, so that they are in cache when dispatched.
+ * The best distance depends on the event-handlers duration: the longer they run, the shorter the distance.
+ * The default policy does not prefetch.
+ * @see Engine::StartSequence::setEventPrefetchPolicy()
+ */
+struct EngineEventPrefetchPolicy
+{
+    size_t distance;
+    /** @brief Default constructor (no prefetch) */
+    inline EngineEventPrefetchPolicy() noexcept : distance(0) {}
+    /**
+     * @brief Constructor
+     * @param pdistance events ahead of the dispatched one to be prefetched
+     */
+    inline EngineEventPrefetchPolicy(size_t pdistance) noexcept : distance(pdistance) {}
+};
+
+/**
+ * @brief Dispatch order policy of the batches of events read by an event-loop.
+ * By default, events are dispatched in arrival order. With this policy, a batch of at least minEventCount
+ * events is first stably grouped by destination actor, groups being dispatched in the order of their first event,
+ * so that consecutive dispatches run the same event-handlers on the same actor (instruction and data cache
+ * locality). Events to the same destination actor are never reordered, so that the order of the events from a
+ * source actor to a destination actor is preserved.
+ * Each lane is grouped separately (see Actor::Event::Pipe::setPriorityLaneFlag()), and multicast events
+ * (see Actor::Event::MulticastPipe) are not moved, events being only grouped between two of them.
+ * The default policy never groups.
+ * @see Engine::StartSequence::setEventGroupingPolicy()
+ */
+struct EngineEventGroupingPolicy
+{
+    size_t minEventCount;
+    /** @brief Default constructor (no grouping) */
+    inline EngineEventGroupingPolicy() noexcept : minEventCount(std::numeric_limits<size_t>::max()) {}
+    /**
+     * @brief Constructor
+     * @param pminEventCount events in a batch (per lane) for it to be grouped
+     */
+    inline EngineEventGroupingPolicy(size_t pminEventCount) noexcept : minEventCount(pminEventCount) {}
+};
+
+/**
+ * @brief Policy of the executor running blocking tasks off the event-loops (see Actor::offload()).
+ * The executor is a pool of threadCount threads that are not event-loops, fed with a bounded FIFO queue of
+ * queueSize tasks shared by all the cores. A task submitted while the queue is full is rejected (see
+ * Actor::OffloadException).
+ * The default policy has no executor.
+ * @see Engine::StartSequence::setOffloadPolicy()
+ * @see Engine::getOffloadCounters()
+ */
+struct EngineOffloadPolicy
+{
+    size_t threadCount;
+    size_t queueSize;
+    /** @brief Default constructor (no executor) */
+    inline EngineOffloadPolicy() noexcept : threadCount(0), queueSize(0) {}
+    /**
+     * @brief Constructor
+     * @param pthreadCount executor threads
+     * @param pqueueSize tasks waiting for an executor thread before submissions are rejected
+     */
+    inline EngineOffloadPolicy(size_t pthreadCount, size_t pqueueSize = 1024) noexcept
+        : threadCount(pthreadCount), queueSize(pqueueSize)
+    {
+    }
+};
+
+/**
+ * @brief Policies of the engine event-loops and of its blocking task executor, each defaulting to its own default
+ * policy.
+ * @see Engine::StartSequence::getPolicy()
+ */
+struct EnginePolicy
+{
+    EngineIdlePolicy idlePolicy;
+    EngineEventPageTrimPolicy eventPageTrimPolicy;
+    EngineEventFlowControlPolicy eventFlowControlPolicy;
+    EngineEventDeliveryBudgetPolicy eventDeliveryBudgetPolicy;
+    EngineEventHandlerPlacementPolicy eventHandlerPlacementPolicy;
+    EngineEventDirectDeliveryPolicy eventDirectDeliveryPolicy;
+    EngineEventGroupingPolicy eventGroupingPolicy;
+    EngineEventPrefetchPolicy eventPrefetchPolicy;
+    EngineOffloadPolicy offloadPolicy;
+};
+
 /**
  * @brief Base-class to event-loop.
  */
@@ -437,6 +726,59 @@ public:
         FullCoreSet();
     };
 
+    /**
+     * @brief NUMA placement of the memory shared by a writer/reader pair of event-loops (see getNumaPlacement()).
+     * Each event-loop memory (write-cache, event pages, reader flags) is placed on its own cpu-core NUMA node,
+     * when the CoreSet spans several NUMA nodes.
+     * A NUMA node is -1 when unknown (e.g. no NUMA support from the system).
+     */
+    struct NumaPlacement
+    {
+        int writerCoreNumaNode;     ///< NUMA node of the writer cpu-core.
+        int readerCoreNumaNode;     ///< NUMA node of the reader cpu-core.
+        int writerSharedNumaNode;   ///< Where the writer handle (write-cache) actually lives.
+        int readerSharedNumaNode;   ///< Where the reader handle (write-locked flags) actually lives.
+        size_t eventPageCount;      ///< Count of event pages allocated by the writer for the reader.
+        size_t writerEventPageCount; ///< Count of those event pages actually living on writerCoreNumaNode.
+        inline NumaPlacement() noexcept
+            : writerCoreNumaNode(-1), readerCoreNumaNode(-1), writerSharedNumaNode(-1), readerSharedNumaNode(-1),
+              eventPageCount(0), writerEventPageCount(0)
+        {
+        }
+    };
+
+    /**
+     * @brief Event pages allocated by a writer event-loop for a reader event-loop (see getEventPageCount()).
+     * Free and trimmed counts are updated by the writer event-loop once per idle period
+     * (see EngineEventPageTrimPolicy).
+     */
+    struct EventPageCount
+    {
+        size_t usedPageCount;    ///< Pages holding events not yet acknowledged by the reader.
+        size_t freePageCount;    ///< Pages ready for reuse.
+        size_t trimmedPageCount; ///< Free pages whose memory was released to the system.
+        inline EventPageCount() noexcept : usedPageCount(0), freePageCount(0), trimmedPageCount(0) {}
+    };
+
+    /**
+     * @brief Counters of the blocking task executor (see getOffloadCounters() and EngineOffloadPolicy).
+     * Times are cumulated over all the executed tasks.
+     */
+    struct OffloadCounters
+    {
+        uint64_t submitCount;      ///< Tasks accepted in the queue.
+        uint64_t rejectCount;      ///< Tasks rejected, the queue being full.
+        uint64_t executeCount;     ///< Tasks executed.
+        size_t queueSize;          ///< Tasks currently waiting for an executor thread.
+        size_t queueHighWatermark; ///< Maximum queueSize reached.
+        Time queueWaitTime;        ///< Time spent by the executed tasks waiting in the queue.
+        Time executeTime;          ///< Time spent by the executor threads executing tasks.
+        inline OffloadCounters() noexcept
+            : submitCount(0), rejectCount(0), executeCount(0), queueSize(0), queueHighWatermark(0)
+        {
+        }
+    };
+
     /**
      * @brief Service Actor registry.
      * Any Actor can be declared as a Service from the StartSequence using the addService() method.
@@ -631,6 +973,111 @@ public:
          * @return true if the core is set in the red-zone. false otherwise.
          */
         bool isRedZoneCore(CoreId) const noexcept;
+        /**
+         * @brief Set the idle policy of the blue-zone cores event-loops.
+         * Red-zone cores event-loops keep spinning.
+         * By default EngineIdlePolicy() is used (pure spinning).
+         * @param Idle policy to be set
+         */
+        void setIdlePolicy(const EngineIdlePolicy &) noexcept;
+        /**
+         * @brief Get the idle policy of the blue-zone cores event-loops
+         * @return idle policy
+         */
+        const EngineIdlePolicy &getIdlePolicy() const noexcept;
+        /**
+         * @brief Set the trimming policy of the free event pages.
+         * By default EngineEventPageTrimPolicy() is used (no trimming).
+         * @param Trimming policy to be set
+         */
+        void setEventPageTrimPolicy(const EngineEventPageTrimPolicy &) noexcept;
+        /**
+         * @brief Get the trimming policy of the free event pages
+         * @return trimming policy
+         */
+        const EngineEventPageTrimPolicy &getEventPageTrimPolicy() const noexcept;
+        /**
+         * @brief Set the flow-control policy of the events pushed between event-loops.
+         * By default EngineEventFlowControlPolicy() is used (no limit).
+         * @param Flow-control policy to be set
+         */
+        void setEventFlowControlPolicy(const EngineEventFlowControlPolicy &) noexcept;
+        /**
+         * @brief Get the flow-control policy of the events pushed between event-loops
+         * @return flow-control policy
+         */
+        const EngineEventFlowControlPolicy &getEventFlowControlPolicy() const noexcept;
+        /**
+         * @brief Set the delivery budget policy of the event-loops.
+         * By default EngineEventDeliveryBudgetPolicy() is used (no budget).
+         * @param Delivery budget policy to be set
+         */
+        void setEventDeliveryBudgetPolicy(const EngineEventDeliveryBudgetPolicy &) noexcept;
+        /**
+         * @brief Get the delivery budget policy of the event-loops
+         * @return delivery budget policy
+         */
+        const EngineEventDeliveryBudgetPolicy &getEventDeliveryBudgetPolicy() const noexcept;
+        /**
+         * @brief Set the placement policy of the actors' event-handlers.
+         * By default EngineEventHandlerPlacementPolicy() is used (no placement).
+         * @param Placement policy to be set
+         */
+        void setEventHandlerPlacementPolicy(const EngineEventHandlerPlacementPolicy &) noexcept;
+        /**
+         * @brief Get the placement policy of the actors' event-handlers
+         * @return placement policy
+         */
+        const EngineEventHandlerPlacementPolicy &getEventHandlerPlacementPolicy() const noexcept;
+        /**
+         * @brief Set the direct delivery policy of the event-loops.
+         * By default EngineEventDirectDeliveryPolicy() is used (no direct delivery).
+         * @param Direct delivery policy to be set
+         */
+        void setEventDirectDeliveryPolicy(const EngineEventDirectDeliveryPolicy &) noexcept;
+        /**
+         * @brief Get the direct delivery policy of the event-loops
+         * @return direct delivery policy
+         */
+        const EngineEventDirectDeliveryPolicy &getEventDirectDeliveryPolicy() const noexcept;
+        /**
+         * @brief Set the dispatch order policy of the event-loops.
+         * By default EngineEventGroupingPolicy() is used (no grouping).
+         * @param Dispatch order policy to be set
+         */
+        void setEventGroupingPolicy(const EngineEventGroupingPolicy &) noexcept;
+        /**
+         * @brief Get the dispatch order policy of the event-loops
+         * @return dispatch order policy
+         */
+        const EngineEventGroupingPolicy &getEventGroupingPolicy() const noexcept;
+        /**
+         * @brief Set the software prefetch policy of the event-loops.
+         * By default EngineEventPrefetchPolicy() is used (no prefetch).
+         * @param Software prefetch policy to be set
+         */
+        void setEventPrefetchPolicy(const EngineEventPrefetchPolicy &) noexcept;
+        /**
+         * @brief Get the software prefetch policy of the event-loops
+         * @return software prefetch policy
+         */
+        const EngineEventPrefetchPolicy &getEventPrefetchPolicy() const noexcept;
+        /**
+         * @brief Set the policy of the blocking task executor (see Actor::offload()).
+         * By default EngineOffloadPolicy() is used (no executor).
+         * @param Blocking task executor policy to be set
+         */
+        void setOffloadPolicy(const EngineOffloadPolicy &) noexcept;
+        /**
+         * @brief Get the policy of the blocking task executor
+         * @return blocking task executor policy
+         */
+        const EngineOffloadPolicy &getOffloadPolicy() const noexcept;
+        /**
+         * @brief Get all the policies set above at once
+         * @return engine policies
+         */
+        const EnginePolicy &getPolicy() const noexcept;
         /**
          * @brief Add _Actor to the StartSequence. This Actor will be instantiated on Engine start.
          * @param coreId on which the Actor is to be started.
@@ -687,10 +1134,29 @@ public:
         void setEngineCustomEventLoopFactory(EngineCustomEventLoopFactory &) noexcept;
         /**
          * @brief Set the default maximum Event page size that is used by the Event Allocator.
+         * Larger Events are allocated in dedicated pages, spanning several page sizes, which are recycled
+         * with their Event batch.
          * By default DEFAULT_EVENT_ALLOCATOR_PAGE_SIZE is used.
          * @param size in bytes
          */
         void setEventAllocatorPageSizeByte(size_t) noexcept;
+        /**
+         * @brief Back all Event pages with 2 MB huge pages, carved into Event pages by a per-core slab.
+         * Reserved hugetlbfs pages are used if available, transparent huge pages otherwise.
+         * This lowers TLB misses when many cores exchange Events with a large Event page size.
+         * By default Event pages are individually allocated.
+         * @param true to enable huge pages
+         */
+        void setEventAllocatorHugePageFlag(bool) noexcept;
+        /**
+         * @brief Execute the start-sequence in parallel, each core constructing its own actors from its own thread.
+         * Actors of a given core are still constructed in start-sequence order, and each service actor is still
+         * constructed after all the actors preceding it in the start-sequence (and before all the actors following
+         * it). However actors of different cores between two service actors are constructed concurrently.
+         * By default the start-sequence is executed from the thread constructing the Engine, one actor at a time.
+         * @param true to enable parallel start
+         */
+        void setParallelStartFlag(bool) noexcept;
         /**
          * @brief Set the default thread stack size that will be used by the threads created by Simplx.
          * @param size in bytes
@@ -722,6 +1188,16 @@ public:
          * @return size in bytes
          */
         size_t getEventAllocatorPageSizeByte() const noexcept;
+        /**
+         * @brief Get whether Event pages are backed by huge pages.
+         * @return true if enabled
+         */
+        bool getEventAllocatorHugePageFlag() const noexcept;
+        /**
+         * @brief Get whether the start-sequence is executed in parallel.
+         * @return true if enabled
+         */
+        bool getParallelStartFlag() const noexcept;
         /**
          * @brief Get the current thread stack size in bytes.
          * @return size in bytes.
@@ -812,10 +1288,13 @@ public:
 
         RedZoneCoreIdList redZoneCoreIdList;
         ThreadRealTimeParam redZoneParam;
+        EnginePolicy policy;
         AsyncExceptionHandler *asyncExceptionHandler;
         EngineCustomCoreActorFactory *engineCustomCoreActorFactory;
         EngineCustomEventLoopFactory *engineCustomEventLoopFactory;
         size_t eventAllocatorPageSizeByte;
+        bool eventAllocatorHugePageFlag;
+        bool parallelStartFlag;
         size_t threadStackSizeByte;
         std::string engineName;
         std::string engineSuffix;
@@ -874,6 +1353,29 @@ public:
      * @return EventAllocatorPageSize
      */
     size_t getEventAllocatorPageSizeByte() const noexcept;
+    /**
+     * @brief Report where the memory shared by a writer/reader pair of cpu-cores actually lives.
+     * @note This method is thread-safe, though event pages concurrently allocated by the writer may be missed.
+     * @param writerCoreId cpu-core pushing the events
+     * @param readerCoreId cpu-core receiving the events
+     * @return NUMA placement of the pair
+     * @throws CoreSet::UndefinedCoreException
+     */
+    NumaPlacement getNumaPlacement(CoreId writerCoreId, CoreId readerCoreId) const;
+    /**
+     * @brief Get the event page counts of a writer/reader pair of event-loops.
+     * @param writerCoreId core of the writer event-loop
+     * @param readerCoreId core of the reader event-loop
+     * @return event page counts of the pair
+     * @throws CoreSet::UndefinedCoreException
+     */
+    EventPageCount getEventPageCount(CoreId writerCoreId, CoreId readerCoreId) const;
+    /**
+     * @brief Get the counters of the blocking task executor (see Actor::offload()).
+     * @note This method is thread-safe.
+     * @return executor counters, all zero if the engine has no executor (see EngineOffloadPolicy)
+     */
+    OffloadCounters getOffloadCounters() const noexcept;
     /**
      * @brief Start a new Actor on a given CoreId
      * @attention This method is used to start a new event-loop after engine's start.
@@ -933,9 +1435,11 @@ public:
     const std::string engineSuffix;
     const size_t threadStackSizeByte;
     const ThreadRealTimeParam redZoneParam;
+    const EnginePolicy policy;
     CacheLineAlignedObject<unsigned> regularActorsCoreCount;
     std::unique_ptr<EngineCustomCoreActorFactory> defaultCoreActorFactory;
     std::unique_ptr<EngineCustomEventLoopFactory> defaultEventLoopFactory;
+    std::unique_ptr<OffloadExecutor> offloadExecutor;
     std::unique_ptr<AsyncNodeManager> nodeManager;
     ServiceIndex serviceIndex;
     EngineCustomCoreActorFactory &customCoreActorFactory;
@@ -107,6 +107,7 @@ template <typename T> class CacheLineAlignedArray
         return reinterpret_cast<const T &>(alignedPtr[i * ALIGNED_T_SZ]);
     }
     inline size_t size() const noexcept { return sz; }
+    inline size_t byteSize() const noexcept { return (size_t)sz * ALIGNED_T_SZ; }
 
   private:
     static const int ALIGNED_T_SZ = CACHE_LINE_SIZE * (((int)sizeof(T) + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE);
@@ -137,36 +138,277 @@ template <typename T> struct CacheLineAlignedObject : private CacheLineAlignedBu
     inline const T *operator->() const noexcept { return cast<const T *>(); }
 };
 
+/**
+ * Memory of its own pages (page aligned, size rounded up to whole pages), which can be placed on a NUMA node (see
+ * memorySetNumaNode()) without affecting neighbouring heap objects.
+ */
+class PageAlignedBuffer
+{
+  public:
+    /**
+     * throw (std::bad_alloc)
+     */
+    inline PageAlignedBuffer(size_t sz)
+        : byteSz(pageAlignedSize(sz)), ptr(static_cast<char *>(alignMalloc(systemPageSize(), byteSz)))
+    {
+    }
+    inline ~PageAlignedBuffer() noexcept { alignFree(byteSz, ptr); }
+    template <class T> inline T cast() noexcept { return reinterpret_cast<T>(ptr); }
+    template <class T> inline T cast() const noexcept { return reinterpret_cast<T>(ptr); }
+    inline size_t pageAlignedByteSize() const noexcept { return byteSz; }
+    inline void setNumaNode(int numaNode) noexcept { memorySetNumaNode(ptr, byteSz, numaNode); }
+    inline static size_t pageAlignedSize(size_t sz) noexcept
+    {
+        return systemPageSize() * ((sz + systemPageSize() - 1) / systemPageSize());
+    }
+
+  private:
+    const size_t byteSz;
+    char *const ptr;
+
+    PageAlignedBuffer(const PageAlignedBuffer &);
+    PageAlignedBuffer &operator=(const PageAlignedBuffer &);
+};
+
+/**
+ * Same as CacheLineAlignedArray, in pages of its own (see PageAlignedBuffer).
+ */
+template <typename T> class PageAlignedArray : private PageAlignedBuffer
+{
+  public:
+    inline explicit PageAlignedArray(size_t n)
+        : // throw (std::bad_alloc, ...)
+          PageAlignedBuffer(n * ALIGNED_T_SZ), sz((assert(n <= std::numeric_limits<uint32_t>::max()), (uint32_t)n))
+    {
+        for (size_t i = 0; i < sz; ++i)
+        {
+            new (cast<char *>() + i * ALIGNED_T_SZ) T();
+        }
+    }
+    template <class _Init>
+    inline explicit PageAlignedArray(size_t n, const _Init &init)
+        : // throw (std::bad_alloc, ...)
+          PageAlignedBuffer(n * ALIGNED_T_SZ), sz((assert(n <= std::numeric_limits<uint32_t>::max()), (uint32_t)n))
+    {
+        for (size_t i = 0; i < sz; ++i)
+        {
+            new (cast<char *>() + i * ALIGNED_T_SZ) T(init);
+        }
+    }
+    inline ~PageAlignedArray() noexcept
+    {
+        for (size_t i = 0; i < sz; ++i)
+        {
+            (*this)[i].~T();
+        }
+    }
+    inline T &operator[](size_t i) noexcept
+    {
+        assert(i < sz);
+        return reinterpret_cast<T &>(cast<char *>()[i * ALIGNED_T_SZ]);
+    }
+    inline const T &operator[](size_t i) const noexcept
+    {
+        assert(i < sz);
+        return reinterpret_cast<const T &>(cast<const char *>()[i * ALIGNED_T_SZ]);
+    }
+    inline size_t size() const noexcept { return sz; }
+    inline size_t byteSize() const noexcept { return (size_t)sz * ALIGNED_T_SZ; }
+    using PageAlignedBuffer::setNumaNode;
+
+  private:
+    static const int ALIGNED_T_SZ = CACHE_LINE_SIZE * (((int)sizeof(T) + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE);
+    const uint32_t sz;
+};
+
+/**
+ * Same as CacheLineAlignedObject, in pages of its own (see PageAlignedBuffer).
+ */
+template <typename T> struct PageAlignedObject : private PageAlignedBuffer
+{
+    template <class _Init>
+    inline PageAlignedObject(const _Init &init)
+        : // throw (std::bad_alloc, ...)
+          PageAlignedBuffer(sizeof(T))
+    {
+        new (cast<T *>()) T(init);
+    }
+    inline ~PageAlignedObject() { cast<T *>()->~T(); }
+    inline T &operator*() noexcept { return *cast<T *>(); }
+    inline const T &operator*() const noexcept { return *cast<const T *>(); }
+    inline T *operator->() noexcept { return cast<T *>(); }
+    inline const T *operator->() const noexcept { return cast<const T *>(); }
+    using PageAlignedBuffer::setNumaNode;
+};
+
+
+/**
+ * Carves cache-line aligned buffers out of huge page backed memory regions (see memoryHugePageMap()),
+ * so that buffers allocated together share few TLB entries. Buffers are only released with the slab.
+ */
+class CacheLineAlignedHugePageSlab
+{
+  public:
+    inline CacheLineAlignedHugePageSlab() noexcept : regionHead(0), regionNext(0), regionEnd(0), numaNode(-1)
+    {
+        assert((unsigned)CACHE_LINE_SIZE >= sizeof(Region));
+    }
+    inline ~CacheLineAlignedHugePageSlab() noexcept { clear(); }
+    /**
+     * Unmaps all regions: buffers previously allocated must not be used anymore.
+     */
+    inline void clear() noexcept
+    {
+        for (Region *region = regionHead; region != 0;)
+        {
+            Region *nextRegion = region->next;
+            memoryHugePageUnmap(region, region->size);
+            region = nextRegion;
+        }
+        regionHead = 0;
+        regionNext = regionEnd = 0;
+    }
+    /**
+     * throw (std::bad_alloc)
+     */
+    inline void *allocate(size_t sz)
+    {
+        sz = CACHE_LINE_SIZE * ((sz + CACHE_LINE_SIZE - 1) / CACHE_LINE_SIZE);
+        if ((size_t)(regionEnd - regionNext) < sz)
+        {
+            newRegion(sz);
+        }
+        assert((size_t)(regionEnd - regionNext) >= sz);
+        void *ret = regionNext;
+        regionNext += sz;
+        return ret;
+    }
+    /**
+     * Places the regions already mapped, and those to come, on the given NUMA node (-1 for no explicit placement).
+     */
+    inline void setNumaNode(int pnumaNode) noexcept
+    {
+        numaNode = pnumaNode;
+        for (Region *region = regionHead; region != 0; region = region->next)
+        {
+            memorySetNumaNode(region, region->size, numaNode);
+        }
+    }
+    inline size_t getRegionCount() const noexcept
+    {
+        size_t ret = 0;
+        for (Region *region = regionHead; region != 0; region = region->next, ++ret)
+        {
+        }
+        return ret;
+    }
+
+  private:
+    struct Region
+    {
+        Region *next;
+        size_t size;
+    };
+
+    Region *regionHead;
+    char *regionNext;
+    char *regionEnd;
+    int numaNode;
+
+    /**
+     * throw (std::bad_alloc)
+     */
+    inline void newRegion(size_t sz)
+    {
+        // the remainder of the current region is lost, which is little as buffers are usually of the same size
+        size_t regionSize = HUGE_PAGE_SIZE * ((CACHE_LINE_SIZE + sz + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE);
+        Region *region = static_cast<Region *>(memoryHugePageMap(regionSize));
+        memorySetNumaNode(region, regionSize, numaNode);
+        region->next = regionHead;
+        region->size = regionSize;
+        regionHead = region;
+        regionNext = reinterpret_cast<char *>(region) + CACHE_LINE_SIZE;
+        regionEnd = reinterpret_cast<char *>(region) + regionSize;
+    }
+};
+
+/**
+ * When given a slab, buffers are carved out of the slab instead of being individually allocated,
+ * and are released with the slab.
+ * Otherwise buffers are allocated in pages of their own (see PageAlignedBuffer), so that they can be placed on a
+ * NUMA node.
+ */
 class CacheLineAlignedBufferContainer
 {
   public:
-    inline CacheLineAlignedBufferContainer() noexcept : head(0) { assert((unsigned)CACHE_LINE_SIZE >= sizeof(void *)); }
+    inline explicit CacheLineAlignedBufferContainer(CacheLineAlignedHugePageSlab *pslab = 0) noexcept
+        : head(0), slab(pslab)
+    {
+        assert((unsigned)CACHE_LINE_SIZE >= sizeof(Link));
+    }
     inline ~CacheLineAlignedBufferContainer() noexcept
     {
-        for (void *p = head; p != 0;)
+        for (Link *link = head; slab == 0 && link != 0;)
         {
-            void *nextp = *static_cast<void **>(CacheLineAlignedBuffer::cacheLineAlignedPointer(p));
-            std::free(p);
-            p = nextp;
+            Link *nextLink = link->next;
+            alignFree(link->size, link);
+            link = nextLink;
         }
     }
     /**
+     * Buffers allocated in pages of their own are placed on numaNode (-1 for no explicit placement).
      * throw (std::bad_alloc)
      */
-    inline void *insert(size_t sz)
+    inline void *insert(size_t sz, int numaNode = -1)
     {
-        void *p = std::malloc(CacheLineAlignedBuffer::cacheLineAlignedSize(sz + CACHE_LINE_SIZE));
-        if (p == 0)
+        Link *link;
+        if (slab == 0)
         {
-            throw std::bad_alloc();
+            sz = PageAlignedBuffer::pageAlignedSize(sz + CACHE_LINE_SIZE);
+            link = static_cast<Link *>(alignMalloc(systemPageSize(), sz));
+            memorySetNumaNode(link, sz, numaNode);
+        }
+        else
+        {
+            sz += CACHE_LINE_SIZE;
+            link = static_cast<Link *>(slab->allocate(sz));
+        }
+        link->next = head;
+        link->size = sz;
+        head = link;
+        return reinterpret_cast<char *>(link) + CACHE_LINE_SIZE;
+    }
+    inline CacheLineAlignedHugePageSlab *getSlab() const noexcept { return slab; }
+    /**
+     * Places the buffers allocated in pages of their own on the given NUMA node (-1 for no explicit placement).
+     */
+    inline void setNumaNode(int numaNode) noexcept
+    {
+        for (Link *link = head; slab == 0 && link != 0; link = link->next)
+        {
+            memorySetNumaNode(link, link->size, numaNode);
+        }
+    }
+    /**
+     * Calls op(void *) with each buffer returned by insert(), latest first.
+     */
+    template <class _Operator> inline void foreach(_Operator &op) const noexcept
+    {
+        for (Link *link = head; link != 0; link = link->next)
+        {
+            op(reinterpret_cast<char *>(link) + CACHE_LINE_SIZE);
         }
-        *static_cast<void **>(CacheLineAlignedBuffer::cacheLineAlignedPointer(p)) = head;
-        head = p;
-        return static_cast<char *>(CacheLineAlignedBuffer::cacheLineAlignedPointer(p)) + CACHE_LINE_SIZE;
     }
 
   private:
-    void *head;
+    struct Link
+    {
+        Link *next;
+        size_t size;
+    };
+
+    Link *head;
+    CacheLineAlignedHugePageSlab *const slab;
 };
 
 template <class _Allocator> class CacheLineAlignedAllocator
@@ -69,5 +69,36 @@ template <typename T> inline unsigned lowestBit(const T &pv) noexcept
     }
     return ret;
 }
+#if defined(__GNUC__)
+/**
+ * @brief Returns the lowest order bit (find-first-set)
+ * @param value to check
+ */
+inline unsigned lowestBit(const unsigned long long &pv) noexcept
+{
+    return pv == 0 ? 0 : (unsigned)__builtin_ctzll(pv);
+}
+/**
+ * @brief Returns the lowest order bit (find-first-set)
+ * @param value to check
+ */
+inline unsigned lowestBit(const unsigned long &pv) noexcept { return pv == 0 ? 0 : (unsigned)__builtin_ctzl(pv); }
+#endif
+
+/**
+ * @brief Hints the processor to fetch the cache line of the given address for reading.
+ * Never faults, whatever the address. No effect if unsupported.
+ * @param address to fetch
+ */
+inline void prefetch(const void *address) noexcept
+{
+#if defined(__GNUC__)
+    __builtin_prefetch(address, 0, 3);
+#elif defined(__SSE2__)
+    _mm_prefetch(static_cast<const char *>(address), _MM_HINT_T0);
+#else
+    (void)address;
+#endif
+}
 
 } // namespace
\ No newline at end of file
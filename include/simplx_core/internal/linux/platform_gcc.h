@@ -71,6 +71,8 @@ inline void alignFree(size_t, void *);
 template <typename _Type> inline bool atomicCompareAndSwap(_Type *ptr, _Type oldval, _Type newval);
 template <typename _Type> inline _Type atomicAddAndFetch(_Type *ptr, unsigned delta);
 template <typename _Type> inline _Type atomicSubAndFetch(_Type *ptr, unsigned delta);
+template <typename _Type> inline _Type atomicFetchAndOr(_Type *ptr, _Type mask);
+template <typename _Type> inline _Type atomicFetchAndAnd(_Type *ptr, _Type mask);
 
 // time
 inline DateTime timeGetEpoch();
@@ -106,6 +108,16 @@ inline void mutexSignalNotify(signal_t &);
 // CPUs
 typedef std::bitset<1024> cpuset_type;
 size_t cpuGetCount();
+int cpuGetNumaNode(unsigned) noexcept;
+inline void cpuPause() noexcept;
+// NUMA memory
+void memorySetNumaNode(void *, size_t, int numaNode) noexcept;
+int memoryGetNumaNode(const void *) noexcept;
+// huge pages
+static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+void *memoryHugePageMap(size_t); // throw (std::bad_alloc)
+void memoryHugePageUnmap(void *, size_t) noexcept;
+void memoryRelease(void *, size_t) noexcept;
 // thread
 struct ThreadRealTimeParam
 {
@@ -120,6 +132,8 @@ void threadSetAffinity(unsigned);
 void threadSetRealTime(bool, const ThreadRealTimeParam &);
 inline void threadYield() noexcept;
 void threadSleep(const Time &delay = Time());
+void threadPark(int &parkWord, int parkedValue, const Time &timeOut) noexcept;
+void threadUnpark(int &parkWord) noexcept;
 inline thread_t threadCurrent();
 inline bool threadEqual(const thread_t &, const thread_t &);
 
@@ -169,6 +183,10 @@ template <typename _Type> _Type atomicSubAndFetch(_Type *ptr, unsigned delta)
     return __sync_sub_and_fetch(ptr, (_Type)delta);
 }
 
+template <typename _Type> _Type atomicFetchAndOr(_Type *ptr, _Type mask) { return __sync_fetch_and_or(ptr, mask); }
+
+template <typename _Type> _Type atomicFetchAndAnd(_Type *ptr, _Type mask) { return __sync_fetch_and_and(ptr, mask); }
+
 inline
 uint64_t getTSC()
 {
@@ -234,6 +252,15 @@ void mutexSignalNotify(signal_t &handle)
     }
 }
 
+void cpuPause() noexcept
+{
+#if defined(__i386__) || defined(__amd64__) || defined(__x86_64__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ volatile("yield" ::: "memory");
+#endif
+}
+
 /**
  * Linux implementation cannot fail
  * cf: http://man7.org/linux/man-pages/man2/sched_yield.2.html
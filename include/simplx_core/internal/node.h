@@ -8,6 +8,7 @@
 #pragma once
 
 #include <csignal>
+#include <exception>
 #include <iostream>
 #include <map>
 #include <set>
@@ -35,6 +36,7 @@ using std::string;
 // forward declarations
 class EngineToEngineConnector;
 class AsyncNode;
+class AsyncNodeAllocator;
 
 #pragma pack(push)
 #pragma pack(1)
@@ -47,23 +49,73 @@ struct Actor::EventTable
         bool (*staticEventHandler)(void *, const Event &);
         inline RegisteredEvent() noexcept;
     };
+    struct RegisteredEventHandler
+    {
+        void *eventHandler;
+        bool (*staticEventHandler)(void *, const Event &);
+    };
+    /**
+     * Open addressing hash index of lfEvent, by event-id (see indexLowFrequencyEvents()).
+     * As event-ids are allocated from 0 up, it is collision-free for most actors.
+     */
+    struct LowFrequencyEventIndex
+    {
+        size_t mask;      // slot count - 1, slot count being a power of 2
+        uint16_t slot[1]; // lfEvent index + 1, or 0 if unused (actually mask + 1 slots)
+        static inline size_t byteSize(size_t mask) noexcept
+        {
+            return sizeof(LowFrequencyEventIndex) + mask * sizeof(uint16_t);
+        }
+    };
+    // hfEventId is scanned at once (see findHighFrequencyEvent()), entries past HIGH_FREQUENCY_CALLBACK_ARRAY_SIZE
+    // are always MAX_EVENT_ID_COUNT
+    static const int HIGH_FREQUENCY_EVENT_ID_ARRAY_SIZE = 16 / sizeof(EventId);
     static const int HIGH_FREQUENCY_CALLBACK_ARRAY_SIZE =
-        (3 * CACHE_LINE_SIZE - sizeof(NodeActorId) - 5 * sizeof(void *) - sizeof(size_t)) / sizeof(RegisteredEvent);
+        (3 * CACHE_LINE_SIZE - sizeof(NodeActorId) - HIGH_FREQUENCY_EVENT_ID_ARRAY_SIZE * sizeof(EventId) -
+         6 * sizeof(void *) - sizeof(size_t)) /
+        sizeof(RegisteredEventHandler);
     static const int LOW_FREQUENCY_ARRAY_ALIGNEMENT = 5;
+    static const size_t LOW_FREQUENCY_INDEX_MIN_EVENT_COUNT = 8; // below, lfEvent is scanned
+    /**
+     * Dispatch counts of hfEvent and lfEvent since last Actor::placeEventHandlers(), only allocated and counted
+     * while the event-handler placement policy is enabled (see AsyncNode::eventDispatchCountFlag).
+     * lfEvent entries past lfCount are not counted until resizeDispatchCount() succeeds.
+     */
+    struct DispatchCount
+    {
+        size_t lfCount;
+        uint64_t hf[HIGH_FREQUENCY_CALLBACK_ARRAY_SIZE];
+        uint64_t lf[1];  // (actually lfCount entries)
+        static inline size_t byteSize(size_t lfCount) noexcept
+        {
+            return sizeof(DispatchCount) + lfCount * sizeof(uint64_t);
+        }
+    };
     NodeActorId nodeActorId;
-    RegisteredEvent hfEvent[HIGH_FREQUENCY_CALLBACK_ARRAY_SIZE];
+    EventId hfEventId[HIGH_FREQUENCY_EVENT_ID_ARRAY_SIZE];
+    RegisteredEventHandler hfEvent[HIGH_FREQUENCY_CALLBACK_ARRAY_SIZE];
     Actor *asyncActor;
     RegisteredEvent *lfEvent;
+    LowFrequencyEventIndex *lfEventIndex;
     RegisteredEvent *undeliveredEvent;
     size_t undeliveredEventCount;
     EventTable *nextUnused;
     void *const deallocatePointer;
+    // past the 3 cache lines looked up by onEvent()
+    bool (*typedEventHandler)(Actor &, const Event &); // (see TypedActor)
+    DispatchCount *dispatchCount;
     const Actor * getActor() const {return asyncActor;}
     EventTable(void *) noexcept;
     ~EventTable() noexcept;
-    inline bool onEvent(const Event &event, uint64_t &) const;
-    bool onLowFrequencyEvent(const Event &event, uint64_t &) const;
+    inline int findHighFrequencyEvent(EventId) const noexcept;
+    inline bool onEvent(const Event &event, uint64_t &, bool dispatchCountFlag) const;
+    bool onLowFrequencyEvent(const Event &event, uint64_t &, bool dispatchCountFlag) const;
     void onUndeliveredEvent(const Event &event) const;
+    void indexLowFrequencyEvents(AsyncNodeAllocator &) noexcept;
+    void releaseLowFrequencyEventIndex(AsyncNodeAllocator &) noexcept;
+    void resizeDispatchCount(AsyncNodeAllocator &) noexcept;
+    void resetDispatchCount() noexcept;
+    void releaseDispatchCount(AsyncNodeAllocator &) noexcept;
     static size_t lfRegisteredEventArraySize(RegisteredEvent *) noexcept;
     static bool onUnregisteredEvent(void *, const Event &);
 #ifndef NDEBUG
@@ -95,13 +147,16 @@ class AsyncNodesHandle
     static const int MAX_SIZE = Actor::MAX_NODE_COUNT;
     const size_t size;
     const size_t eventAllocatorPageSize;
+    const bool eventAllocatorHugePageFlag;
     typedef Actor::NodeId NodeId;
     typedef Engine::CoreSet CoreSet;
     typedef Actor::ActorId::RouteId::NodeConnectionId NodeConnectionId;
+    typedef NodeBitSet<MAX_SIZE> Doorbell; // one bit per writer node with a pending write-locked batch
 
     struct NodeHandle;
     struct WriterSharedHandle;
     typedef Actor::Event::Chain EventChain;
+    typedef Actor::Event::MulticastPipe::MulticastEvent MulticastEvent;
 
 #pragma pack(push)
 #pragma pack(1)
@@ -119,7 +174,8 @@ class AsyncNodesHandle
         struct EventAllocatorPage : MultiForwardChainLink<EventAllocatorPage>
         {
             const uint32_t index;
-            inline EventAllocatorPage(uint32_t pindex) noexcept : index(pindex)
+            const size_t size; // eventAllocatorPageSize, or a multiple of it for large event pages
+            inline EventAllocatorPage(uint32_t pindex, size_t psize) noexcept : index(pindex), size(psize)
             {
                 CRITICAL_ASSERT(sizeof(EventAllocatorPage) <= (unsigned)CACHE_LINE_SIZE);
                 CRITICAL_ASSERT((uintptr_t) this % CACHE_LINE_SIZE == 0);
@@ -136,6 +192,8 @@ class AsyncNodesHandle
             bool checkUndeliveredEventsFlag; // the reader has undelivered events as a writer
             NodeId writerNodeId;
             EventAllocatorPageChain usedEventAllocatorPageChain;
+            EventAllocatorPageChain usedLargeEventAllocatorPageChain;
+            EventChain toBeDeliveredPriorityEventChain; // delivered before toBeDeliveredEventChain
             EventChain toBeDeliveredEventChain;
             EventChain toBeRoutedEventChain;
             EventChain toBeUndeliveredRoutedEventChain;
@@ -157,6 +215,13 @@ class AsyncNodesHandle
             uint8_t batchIdIncrement;
             uint64_t batchId;
             uint64_t totalWrittenByteSize;
+            uint64_t totalWrittenEventCount;
+            uint64_t batchWrittenByteSize; // totals as of last write, acknowledged once the reader drains the batch
+            uint64_t batchWrittenEventCount;
+            uint64_t acknowledgedWrittenByteSize;
+            uint64_t acknowledgedWrittenEventCount;
+            Actor::Callback::Chain writableCallbackChain; // see Actor::Event::Pipe::registerOnWritableCallback()
+            EventChain toBeDeliveredPriorityEventChain;   // see Actor::Event::Pipe::setPriorityLaneFlag()
             EventChain toBeDeliveredEventChain;
             EventChain toBeRoutedEventChain;
             EventChain toBeUndeliveredRoutedEventChain;
@@ -165,10 +230,21 @@ class AsyncNodesHandle
             size_t frontUsedEventAllocatorPageChainOffset;
             EventAllocatorPageChain usedEventAllocatorPageChain;
             EventAllocatorPageChain freeEventAllocatorPageChain;
+            EventAllocatorPageChain usedLargeEventAllocatorPageChain; // one event per page (larger than page size)
+            EventAllocatorPageChain freeLargeEventAllocatorPageChain;
+            EventAllocatorPageChain trimmedEventAllocatorPageChain; // free pages released to the system
+            EventAllocatorPageChain trimmedLargeEventAllocatorPageChain;
             CacheLineAlignedBufferContainer eventAllocatorPageAllocator;
             uint32_t nextEventAllocatorPageIndex;
-            WriteCache(size_t peventAllocatorPageSize);               // throw (std::bad_alloc)
+            size_t freeEventAllocatorPageCount;    // as of last trimEventPages()
+            size_t trimmedEventAllocatorPageCount;
+            int numaNode; // of the writer, where event pages are placed (-1 if no explicit placement)
+            WriteCache(size_t peventAllocatorPageSize,
+                       CacheLineAlignedHugePageSlab *eventPageSlab); // throw (std::bad_alloc)
+            void setNumaNode(int) noexcept;
             inline void newEventPage();                               // throw (std::bad_alloc)
+            EventAllocatorPage &newLargeEventPage(size_t);            // throw (std::bad_alloc)
+            void trimEventPages(size_t freePageHighWatermark) noexcept;
             void *allocateEvent(size_t);                       // throw (std::bad_alloc)
             void *allocateEvent(size_t, uint32_t &, size_t &); // throw (std::bad_alloc)
         };
@@ -178,7 +254,146 @@ class AsyncNodesHandle
         ReadWriteLocked readWriteLocked;
         char cacheLinePadding2[SIMPLX_CACHE_LINE_PADDING(sizeof(ReadWriteLocked))];
 
-        Shared(size_t eventAllocatorPageSize); // throw (std::bad_alloc)
+        Shared(size_t eventAllocatorPageSize, CacheLineAlignedHugePageSlab *eventPageSlab); // throw (std::bad_alloc)
+    };
+    /**
+     * Remaining delivery budget of an event-loop iteration, shared by the local batch and the batches of all peers
+     * (see EngineEventDeliveryBudgetPolicy). The first event of each batch is always delivered, so that no batch
+     * starves behind the ones read before it.
+     */
+    struct EventDeliveryBudget
+    {
+        uint64_t eventCount;
+        uint64_t endTSC;
+        bool batchDeliveredEventFlag;
+        inline EventDeliveryBudget() noexcept
+            : eventCount(std::numeric_limits<uint64_t>::max()), endTSC(std::numeric_limits<uint64_t>::max()),
+              batchDeliveredEventFlag(false)
+        {
+        }
+        inline void reset(const EngineEventDeliveryBudgetPolicy &policy) noexcept
+        {
+            eventCount = policy.maxEventCount == 0 ? std::numeric_limits<uint64_t>::max() : policy.maxEventCount;
+            endTSC = policy.maxTSCTickCount == std::numeric_limits<uint64_t>::max()
+                         ? std::numeric_limits<uint64_t>::max()
+                         : getTSC() + policy.maxTSCTickCount;
+        }
+        inline void newBatch() noexcept { batchDeliveredEventFlag = false; }
+        inline bool isExhausted() noexcept
+        {
+            if (batchDeliveredEventFlag &&
+                (eventCount == 0 || (endTSC != std::numeric_limits<uint64_t>::max() && getTSC() >= endTSC)))
+            {
+                return true;
+            }
+            batchDeliveredEventFlag = true;
+            eventCount -= (eventCount != 0);
+            return false;
+        }
+    };
+    /**
+     * Software prefetch pipeline of a to-be-delivered event chain (see EngineEventPrefetchPolicy), stepped before each
+     * dispatch. Each stage follows the chain at its own distance ahead of the dispatched event, where the data read by
+     * the stage was prefetched by the previous stage.
+     */
+    struct EventPrefetch
+    {
+        EventChain::iterator eventIterator;      // distance ahead: prefetches the event
+        EventChain::iterator eventTableIterator; // distance / 2 ahead: prefetches the event-table
+        EventChain::iterator actorIterator;      // distance / 4 ahead: prefetches the actor
+        const EventChain::iterator endIterator;
+        inline EventPrefetch(const EngineEventPrefetchPolicy &eventPrefetchPolicy, EventChain &eventChain) noexcept
+            : eventIterator(eventChain.begin()), eventTableIterator(eventIterator), actorIterator(eventIterator),
+              endIterator(eventChain.end())
+        {
+            prime(eventIterator, eventPrefetchPolicy.distance, &EventPrefetch::prefetchEvent);
+            prime(eventTableIterator, eventPrefetchPolicy.distance / 2, &EventPrefetch::prefetchEventTable);
+            prime(actorIterator, eventPrefetchPolicy.distance / 4, &EventPrefetch::prefetchActor);
+        }
+        inline void operator()() noexcept
+        {
+            if (eventIterator != endIterator && ++eventIterator != endIterator)
+            {
+                prefetchEvent(*eventIterator);
+            }
+            if (eventTableIterator != endIterator && ++eventTableIterator != endIterator)
+            {
+                prefetchEventTable(*eventTableIterator);
+            }
+            if (actorIterator != endIterator && ++actorIterator != endIterator)
+            {
+                prefetchActor(*actorIterator);
+            }
+        }
+
+      private:
+        inline void prime(EventChain::iterator &iterator, size_t distance,
+                          void (*prefetchFn)(const Actor::Event &)) noexcept
+        {
+            if (distance == 0)
+            { // stage disabled
+                iterator = endIterator;
+                return;
+            }
+            for (size_t i = 0; i < distance && iterator != endIterator && ++iterator != endIterator; ++i)
+            {
+                (*prefetchFn)(*iterator);
+            }
+        }
+        static inline void prefetchEvent(const Actor::Event &event) noexcept { prefetch(&event); }
+        static inline void prefetchEventTable(const Actor::Event &event) noexcept
+        { // the 3 cache lines looked up by Actor::EventTable::onEvent()
+            const char *eventTable = reinterpret_cast<const char *>(event.getDestinationInProcessActorId().eventTable);
+            prefetch(eventTable);
+            prefetch(eventTable + CACHE_LINE_SIZE);
+            prefetch(eventTable + 2 * CACHE_LINE_SIZE);
+        }
+        static inline void prefetchActor(const Actor::Event &event) noexcept
+        {
+            prefetch(event.getDestinationInProcessActorId().eventTable->asyncActor);
+        }
+    };
+    /**
+     * Stably groups a batch of to-be-delivered events by destination actor (see EngineEventGroupingPolicy).
+     */
+    struct EventGrouping
+    {
+        struct Group
+        {
+            const Actor::EventTable *eventTable;
+            size_t segment; // delimited by multicast events, which are not moved
+            uint32_t eventCount;
+            uint32_t offset; // in the grouped batch
+            inline Group(const Actor::EventTable *peventTable, size_t psegment) noexcept
+                : eventTable(peventTable), segment(psegment), eventCount(0), offset(0)
+            {
+            }
+        };
+        typedef std::vector<Actor::Event *, Actor::Allocator<Actor::Event *>> EventVector;
+        typedef std::vector<uint32_t, Actor::Allocator<uint32_t>> IndexVector;
+        typedef std::vector<Group, Actor::Allocator<Group>> GroupVector;
+        static const uint32_t NO_GROUP = std::numeric_limits<uint32_t>::max();
+
+        const size_t minEventCount;
+        const Actor::EventId multicastEventClassId;
+        EventVector events;         // batch, in arrival order
+        IndexVector eventGroups;    // group of each event
+        GroupVector groups;         // in creation (dispatch) order
+        IndexVector groupHashTable; // (event-table, segment) -> group
+        EventVector groupedEvents;  // batch, in dispatch order
+
+        EventGrouping(const EngineEventGroupingPolicy &, Actor::EventId multicastEventClassId,
+                      const Actor::AllocatorBase &) noexcept;
+        inline void operator()(EventChain &eventChain) noexcept
+        {
+            if (minEventCount != std::numeric_limits<size_t>::max())
+            {
+                group(eventChain);
+            }
+        }
+
+      private:
+        void group(EventChain &) noexcept;
     };
     struct ReaderSharedHandle
     {
@@ -222,10 +437,15 @@ class AsyncNodesHandle
         }
         inline bool getIsWriteLocked() noexcept { return cl2.isWriteLocked; }
         inline void setIsWriteLocked(bool isWriteLocked) noexcept { cl2.isWriteLocked = isWriteLocked; }
-        void    read(void) noexcept;
+        bool read(void) noexcept;
         bool returnToSender(const Actor::Event &) noexcept;
         static void dispatchUnreachableNodes(Actor::OnUnreachableChain &, Shared::UnreachableNodeConnectionChain &,
                                              NodeId, AsyncExceptionHandler &) noexcept;
+        static bool dispatchMulticastEvent(MulticastEvent &, uint64_t &, bool dispatchCountFlag,
+                                           AsyncExceptionHandler &) noexcept;
+
+      private:
+        bool readToBeDeliveredEvents(EventChain &, EventDeliveryBudget &) noexcept;
     };
     struct WriterSharedHandle
     {
@@ -234,7 +454,10 @@ class AsyncNodesHandle
             bool *isWriterActive;
             bool *isWriteLocked;
             NodeHandle *writerNodeHandle;
-            inline CacheLine1() noexcept : isWriterActive(0), isWriteLocked(0), writerNodeHandle(0) {}
+            NodeHandle *readerNodeHandle;
+            inline CacheLine1() noexcept : isWriterActive(0), isWriteLocked(0), writerNodeHandle(0), readerNodeHandle(0)
+            {
+            }
         } cl1;
 
         char cacheLinePadding[SIMPLX_CACHE_LINE_PADDING(sizeof(CacheLine1))];
@@ -247,13 +470,13 @@ class AsyncNodesHandle
             /**
              * throw (std::bad_alloc)
              */
-            inline CacheLine2(size_t eventAllocatorPageSize)
-                : readerCAS(0), isReaderActive(false), shared(eventAllocatorPageSize)
+            inline CacheLine2(const std::pair<size_t, CacheLineAlignedHugePageSlab *> &init)
+                : readerCAS(0), isReaderActive(false), shared(init.first, init.second)
             {
             }
         } cl2;
 
-        WriterSharedHandle(size_t eventAllocatorPageSize); // throw (std::bad_alloc)
+        WriterSharedHandle(const std::pair<size_t, CacheLineAlignedHugePageSlab *> &); // throw (std::bad_alloc)
         void init(NodeId writerNodeId, NodeHandle &readerNodeHandle, NodeHandle &writerNodeHandle,
                   ReaderSharedHandle &) noexcept;
         inline bool getIsWriterActive() noexcept
@@ -279,6 +502,15 @@ class AsyncNodesHandle
             assert(cl1.isWriteLocked != 0);
             *cl1.isWriteLocked = isWriteLocked;
         }
+        /**
+         * Must be called after setIsWriteLocked(true) for the reader to process the write.
+         */
+        inline void ringReaderDoorbell(NodeId writerNodeId) noexcept
+        {
+            assert(cl1.readerNodeHandle != 0);
+            cl1.readerNodeHandle->doorbell.atomicSet(writerNodeId);
+            cl1.readerNodeHandle->unpark(); // doorbell atomicSet() is a full memory barrier (see AsyncNode::park())
+        }
         inline Shared &getReferenceToShared() noexcept { return cl2.shared; }
         bool write() noexcept;
         void writeFailed() noexcept;
@@ -291,10 +523,15 @@ class AsyncNodesHandle
 #pragma pack(pop)
     struct NodeHandle
     {
-        CacheLineAlignedArray<ReaderSharedHandle> readerSharedHandles;
-        CacheLineAlignedArray<WriterSharedHandle> writerSharedHandles;
+        Doorbell doorbell; // rung by peer writers (see WriterSharedHandle::ringReaderDoorbell())
+        int parkFlag;      // 1 while the node thread is parked (same cache line as doorbell, see AsyncNode::park())
+        char doorbellCacheLinePadding[SIMPLX_CACHE_LINE_PADDING(sizeof(Doorbell) + sizeof(int))];
+        CacheLineAlignedHugePageSlab eventPageSlab; // of the write-caches, if huge pages are enabled
+        PageAlignedArray<ReaderSharedHandle> readerSharedHandles; // in pages of their own for NUMA placement
+        PageAlignedArray<WriterSharedHandle> writerSharedHandles;
         AsyncNode *node;
         Actor::NodeActorId nextHanlerId;
+        int numaNode; // -1 if no explicit placement (see setNumaNode())
         bool stopFlag;
         bool shutdownFlag;
         bool interruptFlag;
@@ -306,6 +543,7 @@ class AsyncNodesHandle
 
         NodeHandle(const std::pair<AsyncNodesHandle *, const CoreSet *> &); // throw (std::bad_alloc)
         ~NodeHandle() noexcept;
+        void setNumaNode(int) noexcept;
         inline ReaderSharedHandle &getReaderSharedHandle(NodeId writerNodeId) noexcept
         {
             assert(writerNodeId < readerSharedHandles.size());
@@ -316,6 +554,17 @@ class AsyncNodesHandle
             assert(readerNodeId < writerSharedHandles.size());
             return writerSharedHandles[readerNodeId];
         }
+        /**
+         * Wakes-up the node thread if parked. Must be called after any change the parked node has to see
+         * (doorbell, interruptFlag), with a memory barrier in-between.
+         */
+        inline void unpark() noexcept
+        {
+            if (parkFlag != 0 && atomicCompareAndSwap(&parkFlag, 1, 0))
+            {
+                threadUnpark(parkFlag);
+            }
+        }
         template <class _Operator> inline void foreachRead(NodeId readerNodeId, _Operator &op) noexcept
         {
             assert(readerNodeId < readerSharedHandles.size());
@@ -341,9 +590,41 @@ class AsyncNodesHandle
                 op(writerSharedHandles[i], (NodeId)i);
             }
         }
+        /**
+         * Same as foreachRead(), restricted to the writers which rang the doorbell since the previous call,
+         * so that idle peers cost nothing.
+         */
+        template <class _Operator> inline void foreachPendingRead(NodeId readerNodeId, _Operator &op) noexcept
+        {
+            assert(readerNodeId < readerSharedHandles.size());
+            (void)readerNodeId;
+            for (size_t w = 0, endw = Doorbell::wordCount(readerSharedHandles.size()); w < endw; ++w)
+            {
+                for (Doorbell::word_type bits = doorbell.atomicFetchAndResetWord(w); bits != 0; bits &= bits - 1)
+                {
+                    size_t i = Doorbell::index(w, bits);
+                    assert(i != readerNodeId);
+                    op(readerSharedHandles[i], (NodeId)i);
+                }
+            }
+        }
     };
 
-    AsyncNodesHandle(const std::pair<size_t, const CoreSet *> &); // throw (std::bad_alloc)
+    struct Init
+    {
+        size_t eventAllocatorPageSize;
+        const CoreSet *coreSet;
+        bool eventAllocatorHugePageFlag;
+        inline Init(size_t peventAllocatorPageSize, const CoreSet &pcoreSet, bool peventAllocatorHugePageFlag) noexcept
+            : eventAllocatorPageSize(peventAllocatorPageSize), coreSet(&pcoreSet),
+              eventAllocatorHugePageFlag(peventAllocatorHugePageFlag)
+        {
+        }
+    };
+
+    AsyncNodesHandle(const Init &); // throw (std::bad_alloc)
+    Engine::NumaPlacement getNumaPlacement(NodeId writerNodeId, NodeId readerNodeId) noexcept;
+    Engine::EventPageCount getEventPageCount(NodeId writerNodeId, NodeId readerNodeId) noexcept;
     inline NodeHandle &getNodeHandle(NodeId nodeId) noexcept
     {
         assert(nodeId < size);
@@ -381,7 +662,7 @@ class AsyncNodesHandle
         {
             assert(ptr == 0);
             delete ptr;
-            ptr = new CacheLineAlignedObject<NodeHandle>(std::make_pair(&nodesHandler, &coreSet));
+            ptr = new PageAlignedObject<NodeHandle>(std::make_pair(&nodesHandler, &coreSet));
         }
         inline NodeHandle &operator*() noexcept
         {
@@ -396,16 +677,16 @@ class AsyncNodesHandle
         inline NodeHandle *operator->() noexcept
         {
             assert(ptr != 0);
-            return ptr->CacheLineAlignedObject<NodeHandle>::operator->();
+            return ptr->PageAlignedObject<NodeHandle>::operator->();
         }
         inline const NodeHandle *operator->() const noexcept
         {
             assert(ptr != 0);
-            return ptr->CacheLineAlignedObject<NodeHandle>::operator->();
+            return ptr->PageAlignedObject<NodeHandle>::operator->();
         }
 
       private:
-        CacheLineAlignedObject<NodeHandle> *ptr;
+        PageAlignedObject<NodeHandle> *ptr;
         CacheLineAlignedNodeHandleAutoPointer(const CacheLineAlignedNodeHandleAutoPointer &) noexcept;
         CacheLineAlignedNodeHandleAutoPointer &operator=(const CacheLineAlignedNodeHandleAutoPointer &);
     };
@@ -611,12 +892,21 @@ class AsyncNodeManager : private std::unique_ptr<AsyncExceptionHandler>, public
     typedef Actor::CoreId CoreId;
     typedef Engine::CoreSet CoreSet;
 
-    AsyncNodeManager(size_t eventAllocatorPageSize,
-                     const CoreSet & = Engine::FullCoreSet()); // throw (std::bad_alloc)
+    AsyncNodeManager(size_t eventAllocatorPageSize, const CoreSet & = Engine::FullCoreSet(),
+                     bool eventAllocatorHugePageFlag = false); // throw (std::bad_alloc)
     AsyncNodeManager(AsyncExceptionHandler &pexceptionHandler, size_t eventAllocatorPageSize,
-                     const CoreSet & = Engine::FullCoreSet()); // throw (std::bad_alloc)
+                     const CoreSet & = Engine::FullCoreSet(),
+                     bool eventAllocatorHugePageFlag = false); // throw (std::bad_alloc)
     inline const CoreSet &getCoreSet() const noexcept { return coreSet; }
     inline size_t getEventAllocatorPageSize() const noexcept { return nodesHandle.eventAllocatorPageSize; }
+    inline Engine::NumaPlacement getNumaPlacement(NodeId writerNodeId, NodeId readerNodeId) noexcept
+    {
+        return nodesHandle.getNumaPlacement(writerNodeId, readerNodeId);
+    }
+    inline Engine::EventPageCount getEventPageCount(NodeId writerNodeId, NodeId readerNodeId) noexcept
+    {
+        return nodesHandle.getEventPageCount(writerNodeId, readerNodeId);
+    }
 
   private:
     friend class Engine;
@@ -811,6 +1101,14 @@ class AsyncNode : private AsyncNodeBase, public AsyncNodeManager::Node
           private:
             std::unique_ptr<std::string> message;
         };
+        /**
+         * Work executed from within the thread before it runs its node (e.g. node construction), see execute().
+         */
+        struct Task
+        {
+            virtual ~Task() noexcept {}
+            virtual void onExecute() = 0; // throw (...)
+        };
         /**
          * throw (Exception)
          */
@@ -818,6 +1116,16 @@ class AsyncNode : private AsyncNodeBase, public AsyncNodeManager::Node
                void *pstartHookArg, StopHook pstopHook);
         ~Thread() noexcept;
         void run(CacheLineAlignedObject<AsyncNode> &) noexcept;
+        /**
+         * Posts task to be executed from within the thread, without waiting for completion (see waitExecuted()).
+         * Must be called before run(), and at most one task can be pending.
+         */
+        void execute(Task &) noexcept;
+        /**
+         * Waits for completion of the task posted by execute().
+         * throw (...) the exception raised by the task, if any
+         */
+        void waitExecuted();
         inline std::pair<StartHook, void *> getStartHook() const noexcept
         {
             return std::make_pair(startHook, startHookArg);
@@ -838,7 +1146,10 @@ class AsyncNode : private AsyncNodeBase, public AsyncNodeManager::Node
         const StopHook stopHook;
         std::string inThreadExceptionWhat;
         CacheLineAlignedObject<AsyncNode> **inThreadNode;
+        Task *inThreadTask;
+        std::exception_ptr inThreadTaskException;
 
+        void executeInThreadTask() noexcept;
         static void inThread(void *);
     };
     struct Init
@@ -846,11 +1157,16 @@ class AsyncNode : private AsyncNodeBase, public AsyncNodeManager::Node
         AsyncNodeManager &nodeManager;
         CoreId coreId;
         EngineCustomEventLoopFactory &customEventLoopFactory;
+        const EnginePolicy &policy;
+        bool redZoneFlag; // red-zone event-loops keep spinning whatever the idle policy (see EngineIdlePolicy)
         inline Init(AsyncNodeManager &pnodeManager, CoreId pcoreId,
-                    EngineCustomEventLoopFactory &pcustomEventLoopFactory) noexcept
+                    EngineCustomEventLoopFactory &pcustomEventLoopFactory,
+                    const EnginePolicy &ppolicy = EnginePolicy(), bool predZoneFlag = false) noexcept
             : nodeManager(pnodeManager),
               coreId(pcoreId),
-              customEventLoopFactory(pcustomEventLoopFactory)
+              customEventLoopFactory(pcustomEventLoopFactory),
+              policy(ppolicy),
+              redZoneFlag(predZoneFlag)
         {
         }
     };
@@ -909,7 +1225,9 @@ class AsyncNode : private AsyncNodeBase, public AsyncNodeManager::Node
 #endif
         synchronizeUsageCount();
         synchronizeAsyncActorCallbacks();
+        eventDeliveryBudget.reset(eventDeliveryBudgetPolicy);
         synchronizeLocalEvents();
+        synchronizeWritableCallbacks();
         AsyncNodeManager::Node::synchronizePreBarrier();
     }
     inline void synchronizePostBarrier() noexcept
@@ -920,8 +1238,57 @@ class AsyncNode : private AsyncNodeBase, public AsyncNodeManager::Node
 #endif
         AsyncNodeManager::Node::synchronizePostBarrier();
         synchronizeDestroyAsyncActors();
+        if (corePerformanceCounters.onEventCount - eventHandlerPlacementOnEventCount >=
+            eventHandlerPlacementPolicy.eventCount)
+        {
+            placeEventHandlers();
+        }
+    }
+    /**
+     * Applies the idle policy (see EngineIdlePolicy), to be called after each synchronize().
+     */
+    inline void synchronizeIdle() noexcept
+    {
+        if (loopUsagePerformanceCounterIncrement != 0)
+        {
+            eventPageIdleLoopCount = 0;
+            if (idleLoopCount != 0)
+            {
+                idleLoopCount = 0;
+                corePerformanceCounters.idleSpinNanosecond +=
+                    (uint64_t)(HighResolutionTime()() - idleStartTime).toNanosecond();
+            }
+        }
+        else
+        {
+            if (++eventPageIdleLoopCount == eventPageTrimPolicy.idleLoopCount)
+            {
+                trimEventPages();
+            }
+            if (idleLoopCount++ == 0)
+            {
+                idleStartTime = HighResolutionTime()();
+            }
+            else if (idleLoopCount > idlePolicy.spinLoopCount)
+            {
+                if (idleLoopCount - idlePolicy.spinLoopCount <= idlePolicy.pauseLoopCount)
+                {
+                    cpuPause();
+                }
+                else
+                {
+                    if (eventPageIdleLoopCount < eventPageTrimPolicy.idleLoopCount)
+                    {
+                        eventPageIdleLoopCount = eventPageTrimPolicy.idleLoopCount;
+                        trimEventPages();
+                    }
+                    park();
+                }
+            }
+        }
     }
     inline void stop() noexcept { nodeHandle.stopFlag = nodeHandle.interruptFlag = true; }
+    inline AsyncExceptionHandler &getExceptionHandler() noexcept { return nodeManager.exceptionHandler; }
 #ifndef NDEBUG
     inline const ThreadId &debugGetThreadId() const noexcept { return nodeAllocator.debugThreadId; }
 #endif
@@ -935,11 +1302,47 @@ class AsyncNode : private AsyncNodeBase, public AsyncNodeManager::Node
 
     EngineCustomEventLoopFactory::EventLoopAutoPointer eventLoop;
     AsyncNodesHandle::Shared::EventAllocatorPageChain usedlocalEventAllocatorPageChain;
+    AsyncNodesHandle::Shared::EventAllocatorPageChain usedlocalLargeEventAllocatorPageChain;
+    AsyncNodesHandle::EventChain localToBeDeliveredPriorityEventChain; // remainders (see synchronizeLocalEvents())
+    AsyncNodesHandle::EventChain localToBeDeliveredEventChain;
     Actor::CorePerformanceCounters corePerformanceCounters;
+    const EngineIdlePolicy idlePolicy;
+    const EngineEventPageTrimPolicy eventPageTrimPolicy;
+    const EngineEventFlowControlPolicy eventFlowControlPolicy;
+    const EngineEventDeliveryBudgetPolicy eventDeliveryBudgetPolicy;
+    AsyncNodesHandle::EventDeliveryBudget eventDeliveryBudget; // reset at each synchronize
+    const EngineEventHandlerPlacementPolicy eventHandlerPlacementPolicy;
+    const bool eventDispatchCountFlag; // event-tables count dispatches (see Actor::EventTable::DispatchCount)
+    const EngineEventDirectDeliveryPolicy eventDirectDeliveryPolicy;
+    AsyncNodesHandle::EventChain directToBeDeliveredEventChain; // (see Actor::Event::Pipe::setDirectDeliveryFlag())
+    size_t directDeliveryDepth;
+    AsyncNodesHandle::EventGrouping eventGrouping;
+    const EngineEventPrefetchPolicy eventPrefetchPolicy;
+    WriteSignalBitSet writableSignal; // peers with registered writable callbacks
+    const Actor::EventId multicastEventClassId; // (see Actor::Event::MulticastPipe)
+    uint64_t idleLoopCount;
+    Time idleStartTime;
+    uint64_t eventPageIdleLoopCount; // idle loops since the last busy loop or write (see synchronizeIdle())
+    uint64_t eventHandlerPlacementOnEventCount; // onEventCount as of last placeEventHandlers()
 #ifndef NDEBUG
     bool debugSynchronizePostBarrierFlag;
 #endif
 
+    void park() noexcept;
+    void trimEventPages() noexcept;
+    void placeEventHandlers() noexcept;
+
+    /**
+     * Below flow-control limits (see EngineEventFlowControlPolicy).
+     */
+    inline bool isWritable(const AsyncNodesHandle::Shared::WriteCache &writeCache) const noexcept
+    {
+        return writeCache.totalWrittenEventCount - writeCache.acknowledgedWrittenEventCount <
+                   eventFlowControlPolicy.maxOutstandingEventCount &&
+               writeCache.totalWrittenByteSize - writeCache.acknowledgedWrittenByteSize <
+                   eventFlowControlPolicy.maxOutstandingByteSize;
+    }
+
     inline void synchronizeUsageCount() noexcept
     {
         ++corePerformanceCounters.loopTotalCount;
@@ -988,17 +1391,27 @@ class AsyncNode : private AsyncNodeBase, public AsyncNodeManager::Node
         assert(writerSharedHandle.cl2.shared.readWriteLocked.checkUndeliveredEventsFlag == false);
         assert(writerSharedHandle.cl2.shared.readWriteLocked.deliveredEventsFlag == false);
         assert(writerSharedHandle.cl2.shared.readWriteLocked.readerNodeHandle == &nodeHandle);
+        assert(writerSharedHandle.cl2.shared.readWriteLocked.toBeDeliveredPriorityEventChain.empty());
         assert(writerSharedHandle.cl2.shared.readWriteLocked.toBeDeliveredEventChain.empty());
         assert(writerSharedHandle.cl2.shared.readWriteLocked.undeliveredEventChain.empty());
         assert(writerSharedHandle.cl2.shared.readWriteLocked.usedEventAllocatorPageChain.empty());
+        assert(writerSharedHandle.cl2.shared.readWriteLocked.usedLargeEventAllocatorPageChain.empty());
         assert(writerSharedHandle.cl2.shared.readWriteLocked.writerNodeId == id);
         assert(writerSharedHandle.cl2.shared.writeCache.checkUndeliveredEventsFlag == false);
         
-        if (!writerSharedHandle.cl2.shared.writeCache.toBeDeliveredEventChain.empty() ||
+        if (!localToBeDeliveredPriorityEventChain.empty() || !localToBeDeliveredEventChain.empty())
+        {   // remainder of the previous batch (see EngineEventDeliveryBudgetPolicy)
+            loopUsagePerformanceCounterIncrement = 1;
+            synchronizeLocalToBeDeliveredEvents(writerSharedHandle);
+        }
+        else if (!writerSharedHandle.cl2.shared.writeCache.toBeDeliveredPriorityEventChain.empty() ||
+            !writerSharedHandle.cl2.shared.writeCache.toBeDeliveredEventChain.empty() ||
             !writerSharedHandle.cl2.shared.writeCache.toBeRoutedEventChain.empty() ||
             !writerSharedHandle.cl2.shared.writeCache.toBeUndeliveredRoutedEventChain.empty() ||
-            !writerSharedHandle.cl2.shared.writeCache.unreachableNodeConnectionChain.empty())
-        {
+            !writerSharedHandle.cl2.shared.writeCache.unreachableNodeConnectionChain.empty() ||
+            writerSharedHandle.cl2.shared.writeCache.totalWrittenByteSize !=
+                writerSharedHandle.cl2.shared.writeCache.acknowledgedWrittenByteSize)
+        {   // (the last condition recycles the event-pages of directly delivered events)
             loopUsagePerformanceCounterIncrement = 1;
             if (writerSharedHandle.cl2.shared.writeCache.batchId != std::numeric_limits<uint64_t>::max())
             {
@@ -1007,28 +1420,32 @@ class AsyncNode : private AsyncNodeBase, public AsyncNodeManager::Node
                 writerSharedHandle.cl2.shared.writeCache.batchIdIncrement = 0;
             }
             
+            writerSharedHandle.cl2.shared.writeCache.acknowledgedWrittenByteSize =
+                writerSharedHandle.cl2.shared.writeCache.totalWrittenByteSize;
+            writerSharedHandle.cl2.shared.writeCache.acknowledgedWrittenEventCount =
+                writerSharedHandle.cl2.shared.writeCache.totalWrittenEventCount;
             writerSharedHandle.cl2.shared.writeCache.freeEventAllocatorPageChain.push_back(usedlocalEventAllocatorPageChain);
+            writerSharedHandle.cl2.shared.writeCache.freeLargeEventAllocatorPageChain.push_back(
+                usedlocalLargeEventAllocatorPageChain);
             
-            // 3 events chains: toBeDelivered/toBeRouted/toBeUndeliveredRouted
-            AsyncNodesHandle::EventChain toBeDeliveredEventChain;
-            writerSharedHandle.cl2.shared.writeCache.toBeDeliveredEventChain.swap(toBeDeliveredEventChain);
+            // 4 events chains: toBeDeliveredPriority/toBeDelivered/toBeRouted/toBeUndeliveredRouted
+            writerSharedHandle.cl2.shared.writeCache.toBeDeliveredPriorityEventChain.swap(
+                localToBeDeliveredPriorityEventChain);
+            writerSharedHandle.cl2.shared.writeCache.toBeDeliveredEventChain.swap(localToBeDeliveredEventChain);
+            eventGrouping(localToBeDeliveredPriorityEventChain);
+            eventGrouping(localToBeDeliveredEventChain);
             AsyncNodesHandle::EventChain toBeRoutedEventChain;
             writerSharedHandle.cl2.shared.writeCache.toBeRoutedEventChain.swap(toBeRoutedEventChain);
             AsyncNodesHandle::EventChain toBeUndeliveredRoutedEventChain;
             writerSharedHandle.cl2.shared.writeCache.toBeUndeliveredRoutedEventChain.swap(toBeUndeliveredRoutedEventChain);
             assert(usedlocalEventAllocatorPageChain.empty());
             writerSharedHandle.cl2.shared.writeCache.usedEventAllocatorPageChain.swap(usedlocalEventAllocatorPageChain);
+            assert(usedlocalLargeEventAllocatorPageChain.empty());
+            writerSharedHandle.cl2.shared.writeCache.usedLargeEventAllocatorPageChain.swap(
+                usedlocalLargeEventAllocatorPageChain);
             writerSharedHandle.cl2.shared.writeCache.frontUsedEventAllocatorPageChainOffset = 0;
             
-            for (AsyncNodesHandle::EventChain::iterator i = toBeDeliveredEventChain.begin(),
-                                                        endi = toBeDeliveredEventChain.end();
-                 i != endi; ++i)
-            {
-                if (!writerSharedHandle.localOnEvent(*i, corePerformanceCounters.onEventCount))
-                {
-                    writerSharedHandle.onUndeliveredEvent(*i);
-                }
-            }
+            synchronizeLocalToBeDeliveredEvents(writerSharedHandle);
             
             // is e2e? [PL]
             for (AsyncNodesHandle::EventChain::iterator i = toBeRoutedEventChain.begin(),
@@ -1066,6 +1483,94 @@ class AsyncNode : private AsyncNodeBase, public AsyncNodeManager::Node
         }
     }
     
+    /**
+     * Writable callbacks are dispatched once their writer/reader pair is back below flow-control limits.
+     * Until then, a write is retried at each synchronize so that the batch held by the reader gets
+     * acknowledged as soon as it is drained.
+     */
+    inline void synchronizeWritableCallbacks() noexcept
+    {
+        if (writableSignal.any())
+        {
+            for (size_t w = 0, endw = WriteSignalBitSet::wordCount(getNodeCount()); w < endw; ++w)
+            {
+                for (WriteSignalBitSet::word_type bits = writableSignal.getWord(w); bits != 0; bits &= bits - 1)
+                {
+                    Actor::NodeId i = (Actor::NodeId)WriteSignalBitSet::index(w, bits);
+                    AsyncNodesHandle::Shared::WriteCache &writeCache = getReferenceToWriterShared(i).writeCache;
+                    if (writeCache.writableCallbackChain.empty())
+                    {
+                        writableSignal.set(i, false);
+                    }
+                    else if (isWritable(writeCache))
+                    {
+                        writableSignal.set(i, false);
+                        if (synchronizeAsyncActorCallbacks(writeCache.writableCallbackChain,
+                                                           corePerformanceCounters.onCallbackCount) != 0)
+                        {
+                            loopUsagePerformanceCounterIncrement = 1;
+                        }
+                    }
+                    else
+                    {
+                        setWriteSignal(i);
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     * Delivers local events in order, priority lane first, within the delivery budget
+     * (see EngineEventDeliveryBudgetPolicy). The remainder is kept for the next synchronize.
+     */
+    inline void synchronizeLocalToBeDeliveredEvents(AsyncNodesHandle::WriterSharedHandle &writerSharedHandle) noexcept
+    {
+        eventDeliveryBudget.newBatch();
+        if (!synchronizeLocalToBeDeliveredEvents(writerSharedHandle, localToBeDeliveredPriorityEventChain,
+                                                 eventDeliveryBudget) ||
+            !synchronizeLocalToBeDeliveredEvents(writerSharedHandle, localToBeDeliveredEventChain,
+                                                 eventDeliveryBudget))
+        {
+            ++corePerformanceCounters.deliveryBudgetHitCountVector[id];
+        }
+    }
+    
+    inline bool synchronizeLocalToBeDeliveredEvents(AsyncNodesHandle::WriterSharedHandle &writerSharedHandle,
+                                                    AsyncNodesHandle::EventChain &toBeDeliveredEventChain,
+                                                    AsyncNodesHandle::EventDeliveryBudget &eventDeliveryBudget) noexcept
+    {
+        AsyncNodesHandle::EventPrefetch eventPrefetch(eventPrefetchPolicy, toBeDeliveredEventChain);
+        for (; !toBeDeliveredEventChain.empty(); toBeDeliveredEventChain.pop_front())
+        {
+            if (eventDeliveryBudget.isExhausted())
+            {
+                return false;
+            }
+            eventPrefetch();
+            if (!writerSharedHandle.localOnEvent(*toBeDeliveredEventChain.front(), corePerformanceCounters.onEventCount))
+            {
+                writerSharedHandle.onUndeliveredEvent(*toBeDeliveredEventChain.front());
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Delivers an event from within its push (see Actor::Event::Pipe::setDirectDeliveryFlag()),
+     * returning it to its source actor if undelivered.
+     */
+    inline void deliverDirectEvent(const Actor::Event &event) noexcept
+    {
+        AsyncNodesHandle::WriterSharedHandle &writerSharedHandle = nodeHandle.getWriterSharedHandle(id);
+        ++directDeliveryDepth;
+        if (!writerSharedHandle.localOnEvent(event, corePerformanceCounters.onEventCount))
+        {
+            writerSharedHandle.onUndeliveredEvent(event);
+        }
+        --directDeliveryDepth;
+    }
+
     inline void synchronizeDestroyAsyncActors() noexcept
     {
         if (!destroyedActorChain.empty())
@@ -1136,19 +1641,44 @@ private:
         
 };
 
-// returns [dispatched ok]
-bool Actor::EventTable::onEvent(const Event &event, uint64_t &performanceCounter) const
+// returns the hfEvent index of eventId, or HIGH_FREQUENCY_CALLBACK_ARRAY_SIZE if not found
+int Actor::EventTable::findHighFrequencyEvent(EventId eventId) const noexcept
 {
+    assert(eventId < MAX_EVENT_ID_COUNT);
+#if defined(__SSE2__)
+    static_assert(HIGH_FREQUENCY_EVENT_ID_ARRAY_SIZE * sizeof(EventId) == sizeof(__m128i), "one SSE2 register");
+    static_assert(HIGH_FREQUENCY_CALLBACK_ARRAY_SIZE <= HIGH_FREQUENCY_EVENT_ID_ARRAY_SIZE, "hfEventId overflow");
+    unsigned long mask = (unsigned long)_mm_movemask_epi8(_mm_cmpeq_epi16(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(hfEventId)), _mm_set1_epi16((short)eventId)));
+    return mask == 0 ? HIGH_FREQUENCY_CALLBACK_ARRAY_SIZE : (int)(lowestBit(mask) / sizeof(EventId));
+#else
     int i = 0;
-    for (EventId eventId = event.getClassId(); i < HIGH_FREQUENCY_CALLBACK_ARRAY_SIZE && hfEvent[i].eventId != eventId;
-         ++i)
+    for (; i < HIGH_FREQUENCY_CALLBACK_ARRAY_SIZE && hfEventId[i] != eventId; ++i)
     {
     }
+    return i;
+#endif
+}
+
+// returns [dispatched ok]
+bool Actor::EventTable::onEvent(const Event &event, uint64_t &performanceCounter, bool dispatchCountFlag) const
+{
+    int i = findHighFrequencyEvent(event.getClassId());
     if (i == HIGH_FREQUENCY_CALLBACK_ARRAY_SIZE)
     {
-        return onLowFrequencyEvent(event, performanceCounter);
+        // typedEventHandler sits past the 3 cache lines: only looked up once high-frequency handlers missed
+        if (typedEventHandler != 0 && (*typedEventHandler)(*asyncActor, event))
+        {
+            ++performanceCounter;
+            return true;
+        }
+        return onLowFrequencyEvent(event, performanceCounter, dispatchCountFlag);
     }
     ++performanceCounter;
+    if (dispatchCountFlag)
+    {
+        ++dispatchCount->hf[i];
+    }
     assert(hfEvent[i].staticEventHandler != 0);
     ENTERPRISE_0X5010(static_cast<Actor*>(static_cast<const Actor::EventTable*>(event.getDestinationActorId().eventTable)->asyncActor)->getAsyncNode(), &event, static_cast<void*>(hfEvent[i].eventHandler));
     bool ret =  (*hfEvent[i].staticEventHandler)(hfEvent[i].eventHandler, event);
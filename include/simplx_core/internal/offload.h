@@ -0,0 +1,107 @@
+/**
+ * @file offload.h
+ * @brief simplx blocking task executor (see Actor::offload())
+ * @copyright 2019 Scalewatch (www.scalewatch.com). All rights reserved.
+ * Please see accompanying LICENSE file for licensing terms.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "simplx_core/engine.h"
+
+namespace simplx
+{
+
+class OffloadActor;
+
+/**
+ * Pool of threads, which are not event-loops, executing the tasks submitted using Actor::offload().
+ * Tasks wait in a bounded FIFO queue shared by all the cores. Executed tasks are handed back to the OffloadActor of
+ * the submitting actor core, which pushes their completion events from its event-loop.
+ */
+class OffloadExecutor
+{
+  public:
+    OffloadExecutor(const EngineOffloadPolicy &, size_t threadStackSizeByte); // throw (std::bad_alloc, RunTimeException)
+    ~OffloadExecutor() noexcept;
+    Actor::OffloadToken submit(Actor::OffloadTask &); // throw (Actor::OffloadException)
+    Engine::OffloadCounters getCounters() const noexcept;
+    inline OffloadActor *getOffloadActor(Actor::NodeId nodeId) const noexcept
+    {
+        return nodeSlots[nodeId].offloadActor;
+    }
+
+  private:
+    friend class OffloadActor;
+    class WorkerThread : public Thread
+    {
+      public:
+        inline WorkerThread(OffloadExecutor &pexecutor) noexcept : executor(pexecutor) {}
+
+      private:
+        OffloadExecutor &executor;
+        virtual void onRun();
+    };
+    // executed tasks of a node (cpu-core), waiting to be completed by its OffloadActor
+    struct NodeSlot
+    {
+        Mutex mutex;
+        OffloadActor *offloadActor;
+        Actor::OffloadTask *headTask;
+        Actor::OffloadTask *tailTask;
+        std::atomic<bool> pendingFlag; // set with release semantics once headTask was appended to
+        inline NodeSlot() noexcept : offloadActor(0), headTask(0), tailTask(0), pendingFlag(false) {}
+    };
+    typedef std::vector<std::unique_ptr<WorkerThread>> WorkerThreadVector;
+
+    const size_t queueSize;
+    mutable Mutex mutex;
+    Signal signal;
+    bool stopFlag;
+    Actor::OffloadToken lastToken;
+    Actor::OffloadTask *headTask;
+    Actor::OffloadTask *tailTask;
+    Engine::OffloadCounters counters;
+    WorkerThreadVector workerThreads;
+    NodeSlot nodeSlots[std::numeric_limits<Actor::NodeId>::max() + 1];
+
+    Actor::OffloadTask *pop() noexcept;
+    void complete(Actor::OffloadTask &) noexcept;
+    static void requeue(NodeSlot &, Actor::OffloadTask &) noexcept;
+    void stop() noexcept;
+};
+
+/**
+ * Per-core actor pushing the completion events of the tasks submitted from its core.
+ * It is created by the first submission, then polls the completions using a performance-neutral callback and
+ * destroys itself once no task is in flight anymore, so that it neither keeps the core running nor delays its
+ * shutdown when idle.
+ */
+class OffloadActor : public Actor, public Actor::Callback
+{
+  public:
+    OffloadActor(OffloadExecutor *);
+    virtual ~OffloadActor() noexcept;
+    inline void onSubmit() noexcept
+    {
+        if (inFlightCount++ == 0)
+        {
+            registerPerformanceNeutralCallback(*this);
+        }
+    }
+    void onCallback() noexcept;
+
+  protected:
+    virtual void onDestroyRequest() noexcept;
+
+  private:
+    OffloadExecutor::NodeSlot &nodeSlot;
+    size_t inFlightCount;
+};
+
+} // namespace simplx
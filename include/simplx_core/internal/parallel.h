@@ -7,10 +7,10 @@
 
 #pragma once
 
-#include <bitset>
 #include <csignal>
 #include <limits>
 
+#include "simplx_core/internal/intrinsics.h"
 #include "simplx_core/internal/thread.h"
 
 #include "simplx_core/platform.h"
@@ -18,6 +18,111 @@
 namespace simplx
 {
 
+/**
+ * @brief Fixed-size bit set of node-ids.
+ * Set bits are iterated word by word using find-first-set (see lowestBit()),
+ * so that iteration cost is proportional to the set bit count rather than to _Size.
+ * atomicSet() and atomicFetchAndResetWord() may be called concurrently from different threads
+ * (used as a doorbell), all other methods are not thread-safe.
+ */
+template <size_t _Size> class NodeBitSet
+{
+  public:
+    typedef unsigned long long word_type;
+    static const size_t WORD_BIT_COUNT = 8 * sizeof(word_type);
+    static const size_t WORD_COUNT = (_Size + WORD_BIT_COUNT - 1) / WORD_BIT_COUNT;
+
+    inline NodeBitSet() noexcept { reset(); }
+    inline bool test(size_t i) const noexcept
+    {
+        assert(i < _Size);
+        return (words[i / WORD_BIT_COUNT] & mask(i)) != 0;
+    }
+    inline bool operator[](size_t i) const noexcept { return test(i); }
+    inline void set(size_t i, bool flag = true) noexcept
+    {
+        assert(i < _Size);
+        if (flag)
+        {
+            words[i / WORD_BIT_COUNT] |= mask(i);
+        }
+        else
+        {
+            words[i / WORD_BIT_COUNT] &= ~mask(i);
+        }
+    }
+    inline void reset() noexcept
+    {
+        for (size_t i = 0; i < WORD_COUNT; ++i)
+        {
+            words[i] = 0;
+        }
+    }
+    inline bool any() const noexcept
+    {
+        for (size_t i = 0; i < WORD_COUNT; ++i)
+        {
+            if (words[i] != 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+    inline word_type getWord(size_t wordIndex) const noexcept
+    {
+        assert(wordIndex < WORD_COUNT);
+        return words[wordIndex];
+    }
+    /**
+     * @brief Sets bit i with a full memory barrier.
+     */
+    inline void atomicSet(size_t i) noexcept
+    {
+        assert(i < _Size);
+        atomicFetchAndOr(&words[i / WORD_BIT_COUNT], mask(i));
+    }
+    /**
+     * @brief Returns and clears the set bits of a word with a full memory barrier.
+     * The word is first read without locking, so polling an unset word does not
+     * steal the cache line from concurrent atomicSet() callers.
+     */
+    inline word_type atomicFetchAndResetWord(size_t wordIndex) noexcept
+    {
+        assert(wordIndex < WORD_COUNT);
+        return *static_cast<volatile word_type *>(&words[wordIndex]) == 0
+                   ? 0
+                   : atomicFetchAndAnd(&words[wordIndex], (word_type)0);
+    }
+    /**
+     * @param wordIndex index of word
+     * @param bits non-zero value of word
+     * @return index of the lowest set bit in bits
+     */
+    static inline size_t index(size_t wordIndex, word_type bits) noexcept
+    {
+        assert(bits != 0);
+        return wordIndex * WORD_BIT_COUNT + lowestBit(bits);
+    }
+    /**
+     * @param bitCount number of significant bits
+     * @return number of words holding bitCount bits
+     */
+    static inline size_t wordCount(size_t bitCount) noexcept
+    {
+        assert(bitCount <= _Size);
+        return (bitCount + WORD_BIT_COUNT - 1) / WORD_BIT_COUNT;
+    }
+
+  private:
+    word_type words[WORD_COUNT];
+
+    static inline word_type mask(size_t i) noexcept { return (word_type)1 << (i % WORD_BIT_COUNT); }
+};
+
+template <size_t _Size> const size_t NodeBitSet<_Size>::WORD_BIT_COUNT;
+template <size_t _Size> const size_t NodeBitSet<_Size>::WORD_COUNT;
+
 template <class _NodesHandle> class Parallel
 {
   public:
@@ -49,7 +154,7 @@ template <class _NodesHandle>
 class Parallel<_NodesHandle>::Node
 {
   public:
-    typedef std::bitset<_NodesHandle::MAX_SIZE> WriteSignalBitSet;
+    typedef NodeBitSet<_NodesHandle::MAX_SIZE> WriteSignalBitSet;
 
     const NodeId id; // starts at 0
 
@@ -60,6 +165,7 @@ class Parallel<_NodesHandle>::Node
     inline void synchronizePostBarrier();
     inline Shared &getReferenceToWriterShared(NodeId);
     inline void setWriteSignal(NodeId, bool flag = true);
+    inline bool isWritePending() const noexcept { return writeSignal.any(); } // i.e. to be retried at next synchronize
     inline size_t getNodeCount() const noexcept;
 
   protected:
@@ -125,18 +231,42 @@ class Parallel<_NodesHandle>::Node
         int nodesCount;
         bool checkWriteFailed;
         inline ForEachSynchronizeReadOperator(Node &pnode) : node(pnode), nodesCount(-1), checkWriteFailed(false) {}
+        /**
+         * Only called for writers which rang the reader doorbell (see NodeHandle::foreachPendingRead()).
+         * The write lock is still checked as a doorbell may outlive an aborted write (see
+         * ForEachSynchronizeWriteFailedOperator).
+         */
         inline void operator()(ReaderSharedHandle &sharedHandle, NodeId writerNodeId)
         {
             assert(sharedHandle.getIsReaderActive());
             assert(sharedHandle.getReferenceToReaderCAS() == READER_CAS_ON);
             if (sharedHandle.getIsWriteLocked())
             {
-                sharedHandle.read();
-                assert(nodesCount + 1 < (int)node.nodesHandleSize);
-                nodes[++nodesCount] = writerNodeId;
+                if (sharedHandle.read())
+                {
+                    assert(nodesCount + 1 < (int)node.nodesHandleSize);
+                    nodes[++nodesCount] = writerNodeId;
+                } // else partially read: stays write-locked until read() resumes and completes it
+            }
+        }
+        /**
+         * Only peers this node has written to need be checked for a stopped writer.
+         */
+        inline void synchronizeWriteActivity()
+        {
+            for (size_t w = 0, endw = WriteSignalBitSet::wordCount(node.nodesHandleSize); w < endw; ++w)
+            {
+                for (typename WriteSignalBitSet::word_type bits = node.writeActivity.getWord(w); bits != 0;
+                     bits &= bits - 1)
+                {
+                    if (!node.nodeHandle.getReaderSharedHandle((NodeId)WriteSignalBitSet::index(w, bits))
+                             .getIsWriterActive())
+                    {
+                        checkWriteFailed = true;
+                        return;
+                    }
+                }
             }
-            checkWriteFailed =
-                checkWriteFailed || (node.writeActivity[writerNodeId] && !sharedHandle.getIsWriterActive());
         }
         inline void reset()
         {
@@ -159,14 +289,14 @@ class Parallel<_NodesHandle>::Node
                     {
                         sharedHandle.writeFailed();
                         sharedHandle.setIsWriteLocked(false);
-                        writeActivity[readerNodeId] = false;
+                        writeActivity.set(readerNodeId, false);
                         atomicCompareAndSwap<sig_atomic_t>(&sharedHandle.getReferenceToReaderCAS(), READER_CAS_OFF,
                                                            READER_CAS_IDLE);
                     }
                 }
                 else
                 {
-                    writeActivity[readerNodeId] = false;
+                    writeActivity.set(readerNodeId, false);
                 }
             }
         }
@@ -180,31 +310,35 @@ class Parallel<_NodesHandle>::Node
         inline void reset(Node &node)
         {
             nodesCount = -1;
-            for (unsigned i = 0; i < node.nodesHandleSize; ++i)
+            node.writeSignal.set(node.id, false); // Local writes need to be processed separately
+            for (size_t w = 0, endw = WriteSignalBitSet::wordCount(node.nodesHandleSize); w < endw; ++w)
             {
-                node.writeSignal[node.id] = false; // Local writes need to be processed separately, reset false at each
-                                                   // iteration as it may change during write or writeFailed
-                typename WriteSignalBitSet::reference iwriteSignal = node.writeSignal[i];
-                WriterSharedHandle *sharedHandle;
-                if (iwriteSignal &&
-                    !(sharedHandle = &node.nodeHandle.getWriterSharedHandle((NodeId)i))->getIsWriteLocked())
+                // signals set during write or writeFailed into an already visited bit range are processed on the next
+                // iteration
+                for (typename WriteSignalBitSet::word_type bits = node.writeSignal.getWord(w); bits != 0;
+                     bits &= bits - 1)
                 {
-                    assert(node.id != (NodeId)i);
-                    iwriteSignal = false;
-                    if (sharedHandle->getIsReaderActive())
+                    NodeId i = (NodeId)WriteSignalBitSet::index(w, bits);
+                    WriterSharedHandle &sharedHandle = node.nodeHandle.getWriterSharedHandle(i);
+                    if (i != node.id && !sharedHandle.getIsWriteLocked())
                     {
-                        if (sharedHandle->write())
+                        node.writeSignal.set(i, false);
+                        if (sharedHandle.getIsReaderActive())
                         {
-                            nodes[++nodesCount] = (NodeId)i;
-                            node.writeActivity[i] = true;
+                            if (sharedHandle.write())
+                            {
+                                nodes[++nodesCount] = i;
+                                node.writeActivity.set(i);
+                            }
+                        }
+                        else
+                        {
+                            sharedHandle.writeFailed();
                         }
-                    }
-                    else
-                    {
-                        sharedHandle->writeFailed();
                     }
                 }
             }
+            node.writeSignal.set(node.id, false); // may have been set during write or writeFailed
         }
     };
     _NodesHandle &nodesHandle;
@@ -273,6 +407,7 @@ template <class _NodesHandle> Parallel<_NodesHandle>::Node::~Node()
         {
             assert(!nodeHandle.getWriterSharedHandle(writeOperator.nodes[i]).getIsWriteLocked());
             nodeHandle.getWriterSharedHandle(writeOperator.nodes[i]).setIsWriteLocked(true);
+            nodeHandle.getWriterSharedHandle(writeOperator.nodes[i]).ringReaderDoorbell(id);
         }
         ForEachSynchronizeWriteFailedOperator writeFailedOperator(*this);
         nodeHandle.foreachWrite(id, writeFailedOperator);
@@ -291,7 +426,8 @@ template <class _NodesHandle> void Parallel<_NodesHandle>::Node::synchronize()
 template <class _NodesHandle> void Parallel<_NodesHandle>::Node::synchronizePreBarrier()
 {
     readOperator.reset();
-    nodeHandle.foreachRead(id, readOperator);
+    nodeHandle.foreachPendingRead(id, readOperator);
+    readOperator.synchronizeWriteActivity();
     writeOperator.reset(*this);
 }
 
@@ -309,6 +445,7 @@ template <class _NodesHandle> void Parallel<_NodesHandle>::Node::synchronizePost
     {
         assert(!nodeHandle.getWriterSharedHandle(writeOperator.nodes[i]).getIsWriteLocked());
         nodeHandle.getWriterSharedHandle(writeOperator.nodes[i]).setIsWriteLocked(true);
+        nodeHandle.getWriterSharedHandle(writeOperator.nodes[i]).ringReaderDoorbell(id);
     }
 
     if (readOperator.checkWriteFailed)
@@ -330,7 +467,7 @@ template <class _NodesHandle> void Parallel<_NodesHandle>::Node::synchronizePost
 template <class _NodesHandle> void Parallel<_NodesHandle>::Node::setWriteSignal(NodeId destNodeId, bool flag)
 {
     assert(destNodeId < nodesHandleSize);
-    writeSignal[destNodeId] = flag;
+    writeSignal.set(destNodeId, flag);
 }
 
 template <class _NodesHandle>
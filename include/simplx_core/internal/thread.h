@@ -402,6 +402,20 @@ namespace simplx
  * @param delta to be substracted to pointer
  * @return pointer
  */
+/**
+ * @fn template<typename _Type> inline _Type atomicFetchAndOr(_Type* ptr, _Type mask)
+ * @brief Atomically bitwise-or mask into *ptr (full memory barrier)
+ * @param ptr value to be updated
+ * @param mask bits to be set
+ * @return value of *ptr before the update
+ */
+/**
+ * @fn template<typename _Type> inline _Type atomicFetchAndAnd(_Type* ptr, _Type mask)
+ * @brief Atomically bitwise-and mask into *ptr (full memory barrier)
+ * @param ptr value to be updated
+ * @param mask bits to be kept
+ * @return value of *ptr before the update
+ */
 /**
  * @fn inline uint64_t getTSC()
  * @brief Get the current Time Stamp Counter (TSC)
@@ -473,6 +487,55 @@ namespace simplx
  * @return Logical CPU count
  */
 
+/**
+ * @fn int cpuGetNumaNode(unsigned) noexcept
+ * @brief Get the NUMA memory node of a logical core, as discovered from sysfs.
+ * @param Logical core
+ * @return NUMA memory node, or -1 if unknown
+ */
+/**
+ * @fn void memorySetNumaNode(void*, size_t, int numaNode) noexcept
+ * @brief Set the NUMA memory node preferred for the pages entirely covered by the given memory range (mbind()),
+ * moving the pages already touched by this process.
+ * @note Pages partially covered by the range are left untouched, as they may hold neighbouring objects: memory to
+ * be placed should be allocated in pages of its own (see PageAlignedBuffer).
+ * @param Start of the memory range
+ * @param Size of the memory range in bytes
+ * @param numaNode NUMA memory node, nothing is done if -1
+ */
+/**
+ * @fn int memoryGetNumaNode(const void*) noexcept
+ * @brief Get the NUMA memory node where a memory page actually lives (move_pages()).
+ * @param Address within the memory page
+ * @return NUMA memory node, or -1 if unknown (e.g. page not yet touched)
+ */
+/**
+ * @fn void *memoryHugePageMap(size_t)
+ * @brief Map anonymous memory backed by huge pages: reserved hugetlbfs pages (MAP_HUGETLB) when available,
+ * otherwise transparent huge pages (madvise(MADV_HUGEPAGE)) on a huge page aligned range.
+ * @note Throws std::bad_alloc if no memory could be mapped.
+ * @param Size of the memory range in bytes, multiple of HUGE_PAGE_SIZE
+ * @return Start of the memory range, aligned on HUGE_PAGE_SIZE
+ */
+/**
+ * @fn void memoryHugePageUnmap(void*, size_t) noexcept
+ * @brief Unmap memory returned by memoryHugePageMap().
+ * @param Start of the memory range
+ * @param Size of the memory range in bytes, as given to memoryHugePageMap()
+ */
+/**
+ * @fn void memoryRelease(void*, size_t) noexcept
+ * @brief Release to the system the memory pages entirely covered by the given range (madvise(MADV_DONTNEED)),
+ * the range remaining mapped: its memory is faulted back (zero-filled) on next access.
+ * @param Start of the memory range
+ * @param Size of the memory range in bytes
+ */
+/**
+ * @fn inline void cpuPause() noexcept
+ * @brief Hint the cpu-core that the calling thread is spin-waiting (e.g. x86 pause instruction),
+ * which lowers power usage and yields execution resources to the hyper-thread sibling.
+ */
+
 /**
  * @fn thread_t threadCreate(void (*)(void*), void*, size_t stackSizeBytes = 0)
  * @brief Start a new thread
@@ -512,6 +575,19 @@ namespace simplx
  * @brief As the name suggests, sleep thread for a defined time
  * @param delay Default is 0 for minimum sleep time
  */
+/**
+ * @fn void threadPark(int& parkWord, int parkedValue, const Time& timeOut) noexcept
+ * @brief Block the calling thread as long as parkWord equals parkedValue, until threadUnpark() is called
+ * on the same parkWord or timeOut expires (Linux futex).
+ * @param parkWord shared word, which must have been set to parkedValue by the calling thread
+ * @param parkedValue value of parkWord meaning the thread is (about to be) parked
+ * @param timeOut maximum duration of the call
+ */
+/**
+ * @fn void threadUnpark(int& parkWord) noexcept
+ * @brief Wake-up the thread blocked in threadPark() on the same parkWord, if any.
+ * @param parkWord shared word, which must have been changed from its parked value by the calling thread
+ */
 /**
  * @fn inline thread_t threadCurrent()
  * @brief Get current thread identifier
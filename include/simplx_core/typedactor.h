@@ -0,0 +1,119 @@
+/**
+ * @file typedactor.h
+ * @brief actor with a compile-time declared event list
+ * @copyright 2019 Scalewatch (www.scalewatch.com). All rights reserved.
+ * Please see accompanying LICENSE file for licensing terms.
+ */
+
+#pragma once
+
+#include <type_traits>
+
+#include "simplx_core/actor.h"
+
+namespace simplx
+{
+
+/**
+ * @brief Base class (CRTP) for actors handling a list of event types known at compile time.
+ *
+ * _Derived must publicly implement <code>void onEvent(const _Event&)</code> for each _Event of _Events.
+ * The declared events are dispatched without registration, through a single function generated for _Derived,
+ * which compares the event id against the declared ones (a table shared by all instances) and calls the matching
+ * onEvent() method directly (so that the compiler can inline it). It is called when the event misses the
+ * high-frequency part of the actor event-table, ahead of its low-frequency part.
+ * Event-handlers of other event types can still be registered using registerEventHandler().
+ * <br>Example:
+ * \code
+ * class MyActor : public simplx::TypedActor<MyActor, MyEventA, MyEventB> {
+ * public:
+ *     void onEvent(const MyEventA&);
+ *     void onEvent(const MyEventB&);
+ * };
+ * \endcode
+ * @note The declared events need not be registered, and are not reported by Actor::isRegisteredEventHandler().
+ * Registering an event-handler of a declared event type is rejected at compile time.
+ * @attention Actor::unregisterAllEventHandlers() also stops the dispatch of the declared events.
+ */
+template <class _Derived, class... _Events> class TypedActor : public Actor
+{
+  public:
+    static const size_t EVENT_COUNT = sizeof...(_Events);
+
+  protected:
+    /**
+     * @brief Default constructor.
+     * @throw Actor::UndersizedException The number of Event sub-classes specialized at runtime exceeds the limit.
+     * @throw std::bad_alloc
+     */
+    inline TypedActor()
+    {
+        static_assert(sizeof...(_Events) != 0, "empty event list");
+        static const bool eventIdsFlag = initEventIds(); // once per TypedActor instantiation
+        (void)eventIdsFlag;
+        registerTypedEventHandler(&TypedActor::onTypedEvent);
+    }
+    /**
+     * @brief Same as Actor::registerEventHandler(), only for event types not declared in _Events.
+     */
+    template <class _Event, class _EventHandler> inline void registerEventHandler(_EventHandler &eventHandler)
+    {
+        static_assert(!IsDeclared<_Event, _Events...>::value, "_Event is dispatched by TypedActor");
+        Actor::registerEventHandler<_Event>(eventHandler);
+    }
+
+  private:
+    template <size_t I, class... _Tail> struct Dispatch;
+    template <class _Event, class... _Tail> struct IsDeclared : std::false_type
+    {
+    };
+    template <class _Event, class _Head, class... _Tail>
+    struct IsDeclared<_Event, _Head, _Tail...>
+        : std::integral_constant<bool, std::is_same<_Event, _Head>::value || IsDeclared<_Event, _Tail...>::value>
+    {
+    };
+
+    static EventId eventIds[sizeof...(_Events)]; // run-time ids of _Events, in order (see initEventIds())
+
+    static bool initEventIds()
+    {
+        const EventId ids[sizeof...(_Events)] = {Event::getClassId<_Events>()...};
+        for (size_t i = 0; i < sizeof...(_Events); ++i)
+        {
+            eventIds[i] = ids[i];
+        }
+        return true;
+    }
+    static bool onTypedEvent(Actor &actor, const Event &event)
+    {
+        return Dispatch<0, _Events...>::onEvent(static_cast<TypedActor &>(actor), event, event.getClassId());
+    }
+};
+
+template <class _Derived, class... _Events>
+template <size_t I, class _Event, class... _Tail>
+struct TypedActor<_Derived, _Events...>::Dispatch<I, _Event, _Tail...>
+{
+    static inline bool onEvent(TypedActor &actor, const Event &event, EventId eventId)
+    {
+        if (eventId == eventIds[I])
+        {
+            static_cast<_Derived &>(actor).onEvent(static_cast<const _Event &>(event));
+            return true;
+        }
+        return Dispatch<I + 1, _Tail...>::onEvent(actor, event, eventId);
+    }
+};
+
+template <class _Derived, class... _Events>
+template <size_t I>
+struct TypedActor<_Derived, _Events...>::Dispatch<I>
+{
+    static inline bool onEvent(TypedActor &, const Event &, EventId) noexcept { return false; }
+};
+
+template <class _Derived, class... _Events> const size_t TypedActor<_Derived, _Events...>::EVENT_COUNT;
+template <class _Derived, class... _Events>
+Actor::EventId TypedActor<_Derived, _Events...>::eventIds[sizeof...(_Events)];
+
+} // namespace simplx
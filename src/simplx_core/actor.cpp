@@ -10,6 +10,7 @@
 #include <thread>
 
 #include "simplx_core/internal/node.h"
+#include "simplx_core/internal/offload.h"
 
 using namespace std;
 
@@ -18,6 +19,7 @@ namespace simplx
 
 const int Actor::MAX_NODE_COUNT;
 const int Actor::MAX_EVENT_ID_COUNT;
+thread_local const Actor::EventBase *Actor::Event::constructedHeader = 0;
 
 Actor::EventId Actor::Event::retainEventId(EventToOStreamFunction peventNameToOStreamFunction,
                                                      EventToOStreamFunction peventContentToOStreamFunction,
@@ -442,7 +444,11 @@ void Actor::registerLowPriorityEventHandler(EventId eventId, void *eventHandler,
                                                  bool (*staticEventHandler)(void *, const Event &))
 {
     assert(!isRegisteredEventHandler(eventId));
-    registerLowPriorityEventHandler(&eventTable.lfEvent, eventId, eventHandler, staticEventHandler);
+    if (registerLowPriorityEventHandler(&eventTable.lfEvent, eventId, eventHandler, staticEventHandler) != 0)
+    {
+        eventTable.indexLowFrequencyEvents(asyncNode->nodeAllocator);
+        eventTable.resizeDispatchCount(asyncNode->nodeAllocator);
+    }
 }
 
 /**
@@ -452,25 +458,31 @@ void Actor::registerHighPriorityEventHandler(EventId eventId, void *eventHandler
                                                   bool (*staticEventHandler)(void *, const Event &))
 {
     assert(!isRegisteredEventHandler(eventId));
-    EventTable::RegisteredEvent *hfEvent = eventTable.hfEvent;
-    int i = 0;
-    for (; i < EventTable::HIGH_FREQUENCY_CALLBACK_ARRAY_SIZE && hfEvent[i].eventId != eventId; ++i)
-    {
-    }
+    EventId *hfEventId = eventTable.hfEventId;
+    EventTable::RegisteredEventHandler *hfEvent = eventTable.hfEvent;
+    int i = eventTable.findHighFrequencyEvent(eventId);
     if (i == EventTable::HIGH_FREQUENCY_CALLBACK_ARRAY_SIZE)
     {
-        for (i = 0; i < EventTable::HIGH_FREQUENCY_CALLBACK_ARRAY_SIZE && hfEvent[i].eventId != MAX_EVENT_ID_COUNT; ++i)
+        for (i = 0; i < EventTable::HIGH_FREQUENCY_CALLBACK_ARRAY_SIZE && hfEventId[i] != MAX_EVENT_ID_COUNT; ++i)
         {
         }
         if (i == EventTable::HIGH_FREQUENCY_CALLBACK_ARRAY_SIZE)
         {
-            registerLowPriorityEventHandler(&eventTable.lfEvent, eventId, eventHandler, staticEventHandler);
+            if (registerLowPriorityEventHandler(&eventTable.lfEvent, eventId, eventHandler, staticEventHandler) != 0)
+            {
+                eventTable.indexLowFrequencyEvents(asyncNode->nodeAllocator);
+                eventTable.resizeDispatchCount(asyncNode->nodeAllocator);
+            }
         }
         else
         {
-            hfEvent[i].eventId = eventId;
+            hfEventId[i] = eventId;
             hfEvent[i].eventHandler = eventHandler;
             hfEvent[i].staticEventHandler = staticEventHandler;
+            if (eventTable.dispatchCount != 0)
+            {
+                eventTable.dispatchCount->hf[i] = 0;
+            }
         }
     }
     else
@@ -507,8 +519,8 @@ uint8_t Actor::unregisterLowPriorityEventHandler(void *pregisteredEvent, EventId
         for (; registeredEvent[i].eventId != MAX_EVENT_ID_COUNT && registeredEvent[i].eventId != eventId; ++i)
         {
         }
-        if (registeredEvent[i].eventId != MAX_EVENT_ID_COUNT)
-        {
+        if (registeredEvent[i].eventId != MAX_EVENT_ID_COUNT && registeredEvent[i].eventHandler != 0)
+        { // entries of handlers promoted to hfEvent stay unregistered (see placeEventHandlers())
             registeredEvent[i].eventHandler = 0;
             assert(registeredEvent[i].staticEventHandler != &EventTable::onUnregisteredEvent);
             registeredEvent[i].staticEventHandler = EventTable::onUnregisteredEvent;
@@ -556,25 +568,16 @@ bool Actor::isRegisteredLowPriorityEventHandler(void *pregisteredEvent, EventId
 
 bool Actor::isRegisteredHighPriorityEventHandler(EventId eventId) const noexcept
 {
-    EventTable::RegisteredEvent *hfEvent = eventTable.hfEvent;
-    int i = 0;
-    for (; i < EventTable::HIGH_FREQUENCY_CALLBACK_ARRAY_SIZE && hfEvent[i].eventId != eventId; ++i)
-    {
-    }
-    return i != EventTable::HIGH_FREQUENCY_CALLBACK_ARRAY_SIZE;
+    return eventTable.findHighFrequencyEvent(eventId) != EventTable::HIGH_FREQUENCY_CALLBACK_ARRAY_SIZE;
 }
 
 void Actor::unregisterHighPriorityEventHandler(EventId eventId) noexcept
 {
     assert(eventId < MAX_EVENT_ID_COUNT);
-    EventTable::RegisteredEvent *hfEvent = eventTable.hfEvent;
-    int i = 0;
-    for (; i < EventTable::HIGH_FREQUENCY_CALLBACK_ARRAY_SIZE && hfEvent[i].eventId != eventId; ++i)
-    {
-    }
+    int i = eventTable.findHighFrequencyEvent(eventId);
     if (i < EventTable::HIGH_FREQUENCY_CALLBACK_ARRAY_SIZE)
     {
-        hfEvent[i].eventId = MAX_EVENT_ID_COUNT;
+        eventTable.hfEventId[i] = MAX_EVENT_ID_COUNT;
     }
 }
 
@@ -599,10 +602,10 @@ void Actor::unregisterUndeliveredEventHandler(EventId eventId) noexcept
 
 void Actor::unregisterAllEventHandlers() noexcept
 {
-    EventTable::RegisteredEvent *hfEvent = eventTable.hfEvent;
+    eventTable.typedEventHandler = 0;
     for (int i = 0; i < EventTable::HIGH_FREQUENCY_CALLBACK_ARRAY_SIZE; ++i)
     {
-        hfEvent[i].eventId = MAX_EVENT_ID_COUNT;
+        eventTable.hfEventId[i] = MAX_EVENT_ID_COUNT;
     }
     unregisterLowPriorityEventHandlers(eventTable.lfEvent);
     unregisterLowPriorityEventHandlers(eventTable.undeliveredEvent);
@@ -615,12 +618,158 @@ void Actor::unregisterAllEventHandlers() noexcept
     }
 }
 
+void Actor::saveEventHandlers(EventHandlerRegistrations &registrations) const
+{ // throw (std::bad_alloc)
+    registrations.clear();
+    for (int i = 0; i < EventTable::HIGH_FREQUENCY_CALLBACK_ARRAY_SIZE; ++i)
+    {
+        if (eventTable.hfEventId[i] != MAX_EVENT_ID_COUNT)
+        {
+            registrations.entries.push_back(EventHandlerRegistrations::Entry(
+                eventTable.hfEventId[i], false, eventTable.hfEvent[i].eventHandler,
+                eventTable.hfEvent[i].staticEventHandler));
+        }
+    }
+    const EventTable::RegisteredEvent *const registeredEvents[2] = {eventTable.lfEvent, eventTable.undeliveredEvent};
+    for (int j = 0; j < 2; ++j)
+    {
+        for (int i = 0; registeredEvents[j] != 0 && registeredEvents[j][i].eventId != MAX_EVENT_ID_COUNT; ++i)
+        {
+            if (registeredEvents[j][i].eventHandler != 0)
+            {
+                registrations.entries.push_back(EventHandlerRegistrations::Entry(
+                    registeredEvents[j][i].eventId, j == 1, registeredEvents[j][i].eventHandler,
+                    registeredEvents[j][i].staticEventHandler));
+            }
+        }
+    }
+    registrations.typedEventHandler = eventTable.typedEventHandler;
+}
+
+void Actor::registerEventHandlers(const EventHandlerRegistrations &registrations)
+{ // throw (AlreadyRegisterdEventHandlerException, std::bad_alloc)
+    for (std::vector<EventHandlerRegistrations::Entry>::const_iterator i = registrations.entries.begin(),
+                                                                      endi = registrations.entries.end();
+         i != endi; ++i)
+    {
+        if (i->undeliveredFlag)
+        {
+            if (isRegisteredUndeliveredEventHandler(i->eventId))
+            {
+                throw AlreadyRegisterdEventHandlerException();
+            }
+            registerUndeliveredEventHandler(i->eventId, i->eventHandler, i->staticEventHandler);
+        }
+        else
+        {
+            if (isRegisteredEventHandler(i->eventId))
+            {
+                throw AlreadyRegisterdEventHandlerException();
+            }
+            registerHighPriorityEventHandler(i->eventId, i->eventHandler, i->staticEventHandler);
+        }
+    }
+    if (registrations.typedEventHandler != 0)
+    {
+        registerTypedEventHandler(registrations.typedEventHandler);
+    }
+}
+
 bool Actor::isRegisteredEventHandler(EventId eventId) const noexcept
 {
     return isRegisteredHighPriorityEventHandler(eventId) ||
            isRegisteredLowPriorityEventHandler(eventTable.lfEvent, eventId);
 }
 
+void Actor::registerTypedEventHandler(bool (*typedEventHandler)(Actor &, const Event &)) noexcept
+{
+    eventTable.typedEventHandler = typedEventHandler;
+}
+
+/**
+ * Promotes the low-frequency event-handlers dispatched more than twice as often as the least dispatched
+ * high-frequency one, hottest first (see EngineEventHandlerPlacementPolicy), then resets dispatch counts.
+ * Demoted handlers carry their dispatch count along, so that a promotion is never undone within the same call.
+ */
+void Actor::placeEventHandlers(uint64_t &promotionCount, uint64_t &demotionCount) noexcept
+{
+    EventTable::DispatchCount *dispatchCount = eventTable.dispatchCount;
+    if (dispatchCount == 0)
+    {
+        return;
+    }
+    for (;;)
+    {
+        EventTable::RegisteredEvent *lfEvent = eventTable.lfEvent;
+        int hottest = -1;
+        for (int i = 0; lfEvent != 0 && (size_t)i < dispatchCount->lfCount && lfEvent[i].eventId != MAX_EVENT_ID_COUNT;
+             ++i)
+        {
+            if (lfEvent[i].eventHandler != 0 && dispatchCount->lf[i] != 0 &&
+                (hottest < 0 || dispatchCount->lf[i] > dispatchCount->lf[hottest]))
+            {
+                hottest = i;
+            }
+        }
+        if (hottest < 0)
+        {
+            break;
+        }
+        int coldest = 0;
+        for (int i = 0; i < EventTable::HIGH_FREQUENCY_CALLBACK_ARRAY_SIZE &&
+                        eventTable.hfEventId[coldest] != MAX_EVENT_ID_COUNT;
+             ++i)
+        {
+            if (eventTable.hfEventId[i] == MAX_EVENT_ID_COUNT || dispatchCount->hf[i] < dispatchCount->hf[coldest])
+            {
+                coldest = i;
+            }
+        }
+        uint64_t hottestDispatchCount = dispatchCount->lf[hottest];
+        if (eventTable.hfEventId[coldest] != MAX_EVENT_ID_COUNT)
+        {
+            if (hottestDispatchCount / 2 <= dispatchCount->hf[coldest])
+            {
+                break;
+            }
+            try
+            {
+                if (registerLowPriorityEventHandler(&eventTable.lfEvent, eventTable.hfEventId[coldest],
+                                                    eventTable.hfEvent[coldest].eventHandler,
+                                                    eventTable.hfEvent[coldest].staticEventHandler) != 0)
+                {
+                    eventTable.indexLowFrequencyEvents(asyncNode->nodeAllocator);
+                    eventTable.resizeDispatchCount(asyncNode->nodeAllocator);
+                    dispatchCount = eventTable.dispatchCount;
+                }
+            }
+            catch (std::bad_alloc &)
+            {
+                break;
+            }
+            lfEvent = eventTable.lfEvent;
+            int i = 0;
+            for (; lfEvent[i].eventId != eventTable.hfEventId[coldest]; ++i)
+            {
+            }
+            if ((size_t)i < dispatchCount->lfCount)
+            {
+                dispatchCount->lf[i] = dispatchCount->hf[coldest];
+            }
+            ++demotionCount;
+        }
+        eventTable.hfEventId[coldest] = lfEvent[hottest].eventId;
+        eventTable.hfEvent[coldest].eventHandler = lfEvent[hottest].eventHandler;
+        eventTable.hfEvent[coldest].staticEventHandler = lfEvent[hottest].staticEventHandler;
+        dispatchCount->hf[coldest] = hottestDispatchCount;
+        lfEvent[hottest].eventHandler = 0;
+        lfEvent[hottest].staticEventHandler = EventTable::onUnregisteredEvent;
+        dispatchCount->lf[hottest] = 0;
+        ++promotionCount;
+    }
+    eventTable.resetDispatchCount();
+}
+
 bool Actor::isRegisteredUndeliveredEventHandler(EventId eventId) const noexcept
 {
     return isRegisteredLowPriorityEventHandler(eventTable.undeliveredEvent, eventId);
@@ -714,6 +863,29 @@ void Actor::registerPerformanceNeutralCallback(void (*ponCallback)(Callback &) n
     ENTERPRISE_0X5016(pcallback.actorEventTable->asyncActor->getAsyncNode(), &pcallback, pcallback.actorEventTable->asyncActor);
 }
 
+/**
+ * throw (OffloadException, std::bad_alloc)
+ */
+Actor::OffloadToken Actor::offload(OffloadTask &task)
+{
+    OffloadExecutor *executor = getEngine().offloadExecutor.get();
+    if (executor == 0)
+    {
+        throw OffloadException(false);
+    }
+    OffloadActor *offloadActor = executor->getOffloadActor(getActorId().getNodeId());
+    if (offloadActor == 0)
+    {
+        newUnreferencedActor<OffloadActor>(executor);
+        offloadActor = executor->getOffloadActor(getActorId().getNodeId());
+        assert(offloadActor != 0);
+    }
+    task.actorId = getActorId();
+    OffloadToken ret = executor->submit(task);
+    offloadActor->onSubmit();
+    return ret;
+}
+
 Actor::AllocatorBase::AllocatorBase(AsyncNode &asyncNode) noexcept : asyncNodeAllocator(&asyncNode.nodeAllocator)
 {
 }
@@ -744,7 +916,7 @@ void Actor::AllocatorBase::deallocate(size_t sz, void *p) noexcept
 
 size_t Actor::Event::AllocatorBase::max_size() const noexcept
 {
-    return factory == 0 ? 0 : Engine::getEngine().getEventAllocatorPageSizeByte();
+    return factory == 0 ? 0 : std::numeric_limits<size_t>::max();
 }
 
 Actor::Event::Pipe::Pipe(Actor &asyncActor, const ActorId &pdestinationActorId) noexcept
@@ -752,6 +924,8 @@ Actor::Event::Pipe::Pipe(Actor &asyncActor, const ActorId &pdestinationActorId)
       destinationActorId(pdestinationActorId.getNodeActorId() == 0 ? ActorId(sourceActor.getActorId().nodeId, 0, 0)
                                                                    : pdestinationActorId),
       asyncNode(*asyncActor.asyncNode),
+      priorityLaneFlag(false),
+      directDeliveryFlag(false),
       eventFactory(getEventFactory())
 {
 #ifndef NDEBUG
@@ -775,13 +949,27 @@ void Actor::Event::Pipe::setDestinationActorId(const ActorId &pdestinationActorI
     registerProcessOutPipe();
 }
 
+void Actor::Event::Pipe::setPriorityLaneFlag(bool ppriorityLaneFlag) noexcept
+{
+    priorityLaneFlag = ppriorityLaneFlag;
+    eventFactory = getEventFactory();
+}
+
+void Actor::Event::Pipe::setDirectDeliveryFlag(bool pdirectDeliveryFlag) noexcept
+{
+    directDeliveryFlag = pdirectDeliveryFlag;
+    eventFactory = getEventFactory();
+}
+
 Actor::Event::Pipe::EventFactory Actor::Event::Pipe::getEventFactory() noexcept
 {
     if (destinationActorId.isInProcess())
     {
         return EventFactory(&asyncNode.getReferenceToWriterShared(destinationActorId.nodeId).writeCache,
-                            &Pipe::newInProcessEvent, &allocateInProcessEvent, &allocateInProcessEvent,
-                            &batchInProcessEvent);
+                            directDeliveryFlag && destinationActorId.nodeId == asyncNode.id
+                                ? &Pipe::newInProcessDirectEvent
+                                : priorityLaneFlag ? &Pipe::newInProcessPriorityEvent : &Pipe::newInProcessEvent,
+                            &allocateInProcessEvent, &allocateInProcessEvent, &batchInProcessEvent);
     }
     else if (destinationActorId.getRouteId().getNodeId() == sourceActor.getActorId().nodeId &&
              destinationActorId.getRouteId().nodeConnection->isEngineToEngineSharedMemoryConnectorFlag)
@@ -828,13 +1016,88 @@ bool Actor::Event::Batch::debugCheckHasChanged() noexcept
 }
 #endif
 
+bool Actor::Event::Pipe::isWritable() const noexcept
+{
+    return eventFactory.newFn == &Pipe::newOutOfProcessSharedMemoryEvent ||
+           asyncNode.isWritable(*static_cast<const AsyncNodesHandle::Shared::WriteCache *>(eventFactory.context));
+}
+
+void Actor::Event::Pipe::registerOnWritableCallback(void (*ponCallback)(Callback &) noexcept,
+                                                    Callback &pcallback) noexcept
+{
+    pcallback.unregister();
+    pcallback.actorEventTable = &sourceActor.eventTable;
+    pcallback.nodeActorId = sourceActor.eventTable.nodeActorId;
+    pcallback.onCallback = ponCallback;
+    if (eventFactory.newFn == &Pipe::newOutOfProcessSharedMemoryEvent)
+    {
+        (pcallback.chain = &asyncNode.asyncActorCallbackChain)->push_back(&pcallback);
+    }
+    else
+    {
+        (pcallback.chain = &static_cast<AsyncNodesHandle::Shared::WriteCache *>(eventFactory.context)
+                                ->writableCallbackChain)
+            ->push_back(&pcallback);
+        asyncNode.writableSignal.set(destinationActorId.isInProcess() ? destinationActorId.nodeId
+                                                                      : destinationActorId.getRouteId().getNodeId());
+    }
+}
+
 void *Actor::Event::Pipe::newInProcessEvent(size_t sz, EventChain *&destinationEventChain, uintptr_t,
                                                  Event::route_offset_type &)
 {
-    destinationEventChain =
-        &static_cast<AsyncNodesHandle::Shared::WriteCache *>(eventFactory.context)->toBeDeliveredEventChain;
+    AsyncNodesHandle::Shared::WriteCache &writeCache =
+        *static_cast<AsyncNodesHandle::Shared::WriteCache *>(eventFactory.context);
+    destinationEventChain = &writeCache.toBeDeliveredEventChain;
+    asyncNode.setWriteSignal(destinationActorId.nodeId);
+    ++writeCache.totalWrittenEventCount;
+    return writeCache.allocateEvent(sz);
+}
+
+void *Actor::Event::Pipe::newInProcessPriorityEvent(size_t sz, EventChain *&destinationEventChain, uintptr_t,
+                                                    Event::route_offset_type &)
+{
+    AsyncNodesHandle::Shared::WriteCache &writeCache =
+        *static_cast<AsyncNodesHandle::Shared::WriteCache *>(eventFactory.context);
+    destinationEventChain = &writeCache.toBeDeliveredPriorityEventChain;
     asyncNode.setWriteSignal(destinationActorId.nodeId);
-    return static_cast<AsyncNodesHandle::Shared::WriteCache *>(eventFactory.context)->allocateEvent(sz);
+    ++writeCache.totalWrittenEventCount;
+    return writeCache.allocateEvent(sz);
+}
+
+/**
+ * Direct events go to the node direct chain (see deliverDirectEvents()), unless the nested direct delivery limit
+ * is reached (see EngineEventDirectDeliveryPolicy), in which case they are queued like any in-process event.
+ */
+void *Actor::Event::Pipe::newInProcessDirectEvent(size_t sz, EventChain *&destinationEventChain, uintptr_t,
+                                                  Event::route_offset_type &)
+{
+    AsyncNodesHandle::Shared::WriteCache &writeCache =
+        *static_cast<AsyncNodesHandle::Shared::WriteCache *>(eventFactory.context);
+    if (asyncNode.directDeliveryDepth < asyncNode.eventDirectDeliveryPolicy.maxDepth)
+    {
+        assert(asyncNode.directToBeDeliveredEventChain.empty());
+        destinationEventChain = &asyncNode.directToBeDeliveredEventChain;
+    }
+    else
+    {
+        destinationEventChain =
+            priorityLaneFlag ? &writeCache.toBeDeliveredPriorityEventChain : &writeCache.toBeDeliveredEventChain;
+        asyncNode.setWriteSignal(destinationActorId.nodeId);
+        ++writeCache.totalWrittenEventCount;
+    }
+    return writeCache.allocateEvent(sz);
+}
+
+void Actor::Event::Pipe::deliverDirectEvents(EventChain &destinationEventChain) noexcept
+{
+    if (&destinationEventChain == &asyncNode.directToBeDeliveredEventChain)
+    {
+        assert(!destinationEventChain.empty());
+        const Event &event = *destinationEventChain.pop_front();
+        assert(destinationEventChain.empty());
+        asyncNode.deliverDirectEvent(event);
+    }
 }
 
 void *Actor::Event::Pipe::allocateInProcessEvent(size_t sz, void *destinationEventPipe)
@@ -872,6 +1135,84 @@ uint64_t Actor::Event::Pipe::batchInProcessEvent(void *destinationEventPipe) noe
 }
 #endif
 
+namespace
+{
+// in-process actor-ids first, ordered by event-loop, then out-of-process actor-ids
+struct MulticastDestinationActorIdLess
+{
+    inline bool operator()(const Actor::ActorId &a, const Actor::ActorId &b) const noexcept
+    {
+        return a.isInProcess() && (!b.isInProcess() || a.Actor::InProcessActorId::operator<(b));
+    }
+};
+} // namespace
+
+Actor::Event::MulticastPipe::MulticastPipe(Actor &psourceActor) noexcept
+    : sourceActor(psourceActor),
+      destinationActorIds(sourceActor.getAllocator())
+{
+}
+
+void Actor::Event::MulticastPipe::addDestinationActorId(const ActorId &actorId)
+{
+    if (actorId == null)
+    {
+        return;
+    }
+    DestinationActorIdVector::iterator i = std::lower_bound(destinationActorIds.begin(), destinationActorIds.end(),
+                                                            actorId, MulticastDestinationActorIdLess());
+    if (actorId.isInProcess() ? i == destinationActorIds.end() || *i != actorId
+                              : std::find(i, destinationActorIds.end(), actorId) == destinationActorIds.end())
+    {
+        destinationActorIds.insert(i, actorId);
+    }
+}
+
+void Actor::Event::MulticastPipe::removeDestinationActorId(const ActorId &actorId) noexcept
+{
+    DestinationActorIdVector::iterator i = std::find(destinationActorIds.begin(), destinationActorIds.end(), actorId);
+    if (i != destinationActorIds.end())
+    {
+        destinationActorIds.erase(i);
+    }
+}
+
+void Actor::Event::MulticastPipe::clearDestinationActorIds() noexcept
+{
+    destinationActorIds.clear();
+}
+
+size_t Actor::Event::MulticastPipe::getDestinationNodeEnd(size_t i) const noexcept
+{
+    assert(i < destinationActorIds.size());
+    size_t ret = i + 1;
+    if (destinationActorIds[i].isInProcess())
+    {
+        for (NodeId nodeId = destinationActorIds[i].getNodeId(); ret < destinationActorIds.size() &&
+                                                                 destinationActorIds[ret].isInProcess() &&
+                                                                 destinationActorIds[ret].getNodeId() == nodeId;
+             ++ret)
+        {
+        }
+    }
+    return ret;
+}
+
+/**
+ * throw (std::bad_alloc)
+ */
+void Actor::Event::MulticastPipe::pushMulticastEvent(Pipe &pipe, Event &event, size_t begin, size_t end)
+{
+    assert(end - begin > 1);
+    InProcessActorId *multicastDestinationActorIds = pipe.allocate<InProcessActorId>(end - begin);
+    for (size_t i = begin; i != end; ++i)
+    {
+        assert(destinationActorIds[i].getNodeId() == pipe.getDestinationActorId().getNodeId());
+        new (multicastDestinationActorIds + (i - begin)) InProcessActorId(destinationActorIds[i]);
+    }
+    pipe.push<MulticastEvent>(event, multicastDestinationActorIds, end - begin);
+}
+
 // static
 bool Actor::ActorReferenceBase::recursiveFind(const Actor &referencedActor, const Actor &referencingActor)
 {
@@ -8,6 +8,7 @@
 #include <iostream>
 
 #include "simplx_core/internal/node.h"
+#include "simplx_core/internal/offload.h"
 
 using namespace std;
 
@@ -208,6 +209,7 @@ void EngineCustomEventLoopFactory::DefaultEventLoop::run() noexcept
         do
         {
             asyncNode->synchronize();
+            asyncNode->synchronizeIdle();
         } while (!*interruptFlag);
     }
     asyncNode->synchronizePreBarrier();
@@ -378,13 +380,19 @@ unsigned Engine::ServiceIndex::staticIndexValue = 0;
 Engine::Engine(const StartSequence &startSequence)
     : engineName(startSequence.getEngineName()), engineSuffix(startSequence.getEngineSuffix()),
       threadStackSizeByte(startSequence.getThreadStackSizeByte()), redZoneParam(startSequence.getRedZoneParam()),
+      policy(startSequence.getPolicy()),
       regularActorsCoreCount(1u), defaultCoreActorFactory(new EngineCustomCoreActorFactory),
       defaultEventLoopFactory(new EngineCustomEventLoopFactory),
+      offloadExecutor(policy.offloadPolicy.threadCount == 0
+                          ? 0
+                          : new OffloadExecutor(policy.offloadPolicy, threadStackSizeByte)),
       nodeManager(startSequence.getAsyncExceptionHandler() == 0
-                      ? new AsyncNodeManager(startSequence.getEventAllocatorPageSizeByte(), startSequence.getCoreSet())
+                      ? new AsyncNodeManager(startSequence.getEventAllocatorPageSizeByte(), startSequence.getCoreSet(),
+                                             startSequence.getEventAllocatorHugePageFlag())
                       : new AsyncNodeManager(*startSequence.getAsyncExceptionHandler(),
                                              startSequence.getEventAllocatorPageSizeByte(),
-                                             startSequence.getCoreSet())),
+                                             startSequence.getCoreSet(),
+                                             startSequence.getEventAllocatorHugePageFlag())),
       customCoreActorFactory(
           startSequence.getEngineCustomCoreActorFactory() == 0
               ? *defaultCoreActorFactory
@@ -471,12 +479,31 @@ void Engine::finish() noexcept
     memoryBarrier();
 
     nodeManager.release();
+    offloadExecutor.reset();
 }
 
 const Engine::CoreSet &Engine::getCoreSet() const noexcept { return nodeManager->getCoreSet(); }
 
 size_t Engine::getEventAllocatorPageSizeByte() const noexcept { return nodeManager->getEventAllocatorPageSize(); }
 
+/**
+ * throw (CoreSet::UndefinedCoreException)
+ */
+Engine::NumaPlacement Engine::getNumaPlacement(CoreId writerCoreId, CoreId readerCoreId) const
+{
+    return nodeManager->getNumaPlacement(getCoreSet().index(writerCoreId), getCoreSet().index(readerCoreId));
+}
+
+Engine::OffloadCounters Engine::getOffloadCounters() const noexcept
+{
+    return offloadExecutor.get() == 0 ? OffloadCounters() : offloadExecutor->getCounters();
+}
+
+Engine::EventPageCount Engine::getEventPageCount(CoreId writerCoreId, CoreId readerCoreId) const
+{
+    return nodeManager->getEventPageCount(getCoreSet().index(writerCoreId), getCoreSet().index(readerCoreId));
+}
+
 #ifndef NDEBUG
 void Engine::debugActivateMemoryLeakBacktrace() noexcept
 {
@@ -530,25 +557,191 @@ void Engine::start(const StartSequence &startSequence)
             nodeThreadList.back().thread.reset(new AsyncNode::Thread(coreId, startSequence.isRedZoneCore(coreId),
                                                                      redZoneParam, threadStackSizeByte, threadStartHook,
                                                                      this, 0));
-            cpuset_type savedThreadAffinity = threadGetAffinity();
-            try
-            {
-                threadSetAffinity(coreId);
-                nodeThreadList.back().node = new CacheLineAlignedObject<AsyncNode>(
-                    AsyncNode::Init(*nodeManager.get(), coreId, customEventLoopFactory));
-            }
-            catch (...)
+            if (!startSequence.getParallelStartFlag()) // otherwise node is constructed by its own thread
             {
+                cpuset_type savedThreadAffinity = threadGetAffinity();
+                try
+                {
+                    threadSetAffinity(coreId);
+                    nodeThreadList.back().node = new CacheLineAlignedObject<AsyncNode>(
+                        AsyncNode::Init(*nodeManager.get(), coreId, customEventLoopFactory, policy,
+                                        startSequence.isRedZoneCore(coreId)));
+                }
+                catch (...)
+                {
+                    threadSetAffinity(savedThreadAffinity);
+                    throw;
+                }
                 threadSetAffinity(savedThreadAffinity);
-                throw;
             }
-            threadSetAffinity(savedThreadAffinity);
         }
         if (i->isServiceFlag)
         {
             ilastService = i;
         }
     }
+    if (startSequence.getParallelStartFlag())
+    {
+        /*
+         * Each node is constructed, then runs its start-sequence actors and its core actor, from within its own
+         * thread (first-touch memory placement, no thread affinity switching). The calling thread waits for all
+         * nodes at each step (barrier): start-sequence actors are split into steps at each service actor, which is
+         * started alone, so that service ordering is kept.
+         */
+        struct NodeStartTask : AsyncNode::Thread::Task
+        {
+            enum Step
+            {
+                NEW_NODE,
+                START_ACTORS,
+                NEW_CORE_ACTOR
+            };
+            Engine &engine;
+            const StartSequence &startSequence;
+            Engine_start_NodeThread &nodeThread;
+            const StartSequence::Starter *const lastService;
+            Step step;
+            std::vector<const StartSequence::Starter *> starters;
+            Actor::ActorId previousServiceDestroyActorId;
+            bool pendingFlag;
+            NodeStartTask(Engine &pengine, const StartSequence &pstartSequence, Engine_start_NodeThread &pnodeThread,
+                          const StartSequence::Starter *plastService) noexcept
+                : engine(pengine), startSequence(pstartSequence), nodeThread(pnodeThread), lastService(plastService),
+                  step(NEW_NODE), pendingFlag(false)
+            {
+            }
+            virtual void onExecute()
+            {
+                currentEngineTLS.set(&engine);
+                try
+                {
+                    execute();
+                }
+                catch (...)
+                {
+                    currentEngineTLS.set(0);
+                    throw;
+                }
+                currentEngineTLS.set(0);
+            }
+            void execute()
+            {
+                const CoreId coreId = nodeThread.coreId;
+                switch (step)
+                {
+                case NEW_NODE:
+                    nodeThread.node = new CacheLineAlignedObject<AsyncNode>(
+                        AsyncNode::Init(*engine.nodeManager.get(), coreId, engine.customEventLoopFactory,
+                                        engine.policy, startSequence.isRedZoneCore(coreId)));
+                    break;
+                case START_ACTORS:
+                    for (std::vector<const StartSequence::Starter *>::const_iterator i = starters.begin(),
+                                                                                     endi = starters.end();
+                         i != endi; ++i)
+                    {
+                        Actor::ActorId serviceDestroyActorId = (*i)->onStart(
+                            engine, **nodeThread.node, previousServiceDestroyActorId, *i == lastService);
+                        if ((*i)->isServiceFlag)
+                        {
+                            assert(serviceDestroyActorId != simplx::null);
+                            previousServiceDestroyActorId = serviceDestroyActorId;
+                        }
+                    }
+                    break;
+                case NEW_CORE_ACTOR:
+                    (*nodeThread.node)
+                        ->newActor<CoreActor>(CoreActor::Init(engine, coreId, startSequence.isRedZoneCore(coreId)));
+                    break;
+                }
+            }
+        };
+        struct NodeStartTaskList : std::list<NodeStartTask>
+        {
+            iterator find(CoreId coreId) noexcept
+            {
+                iterator ret = begin();
+                for (; ret != end() && ret->nodeThread.coreId != coreId; ++ret)
+                {
+                }
+                return ret;
+            }
+            /**
+             * throw (...) first exception raised by a task, once all tasks are completed
+             */
+            void execute(NodeStartTask::Step step)
+            {
+                for (iterator i = begin(), endi = end(); i != endi; ++i)
+                {
+                    if (step != NodeStartTask::START_ACTORS || !i->starters.empty())
+                    {
+                        i->step = step;
+                        i->pendingFlag = true;
+                        i->nodeThread.thread->execute(*i);
+                    }
+                }
+                std::exception_ptr taskException;
+                for (iterator i = begin(), endi = end(); i != endi; ++i)
+                {
+                    if (i->pendingFlag)
+                    {
+                        try
+                        {
+                            i->nodeThread.thread->waitExecuted();
+                        }
+                        catch (...)
+                        {
+                            if (!taskException)
+                            {
+                                taskException = std::current_exception();
+                            }
+                        }
+                        i->pendingFlag = false;
+                        i->starters.clear();
+                    }
+                }
+                if (taskException)
+                {
+                    std::rethrow_exception(taskException);
+                }
+            }
+        };
+        const StartSequence::Starter *lastService =
+            ilastService == startSequence.starterChain.end() ? 0 : &*ilastService;
+        NodeStartTaskList nodeStartTaskList;
+        for (NodeThreadList::iterator i = nodeThreadList.begin(), endi = nodeThreadList.end(); i != endi; ++i)
+        {
+            nodeStartTaskList.push_back(NodeStartTask(*this, startSequence, *i, lastService));
+        }
+        nodeStartTaskList.execute(NodeStartTask::NEW_NODE);
+        Actor::ActorId previousServiceDestroyActorId;
+        for (StartSequence::StarterChain::const_iterator i = startSequence.starterChain.begin(),
+                                                         endi = startSequence.starterChain.end();
+             ; ++i)
+        {
+            if (i == endi || i->isServiceFlag)
+            {
+                nodeStartTaskList.execute(NodeStartTask::START_ACTORS); // actors preceding service
+                if (i == endi)
+                {
+                    break;
+                }
+                NodeStartTaskList::iterator inodeStartTask = nodeStartTaskList.find(i->coreId);
+                assert(inodeStartTask != nodeStartTaskList.end());
+                inodeStartTask->starters.push_back(&*i);
+                inodeStartTask->previousServiceDestroyActorId = previousServiceDestroyActorId;
+                nodeStartTaskList.execute(NodeStartTask::START_ACTORS); // service alone
+                previousServiceDestroyActorId = inodeStartTask->previousServiceDestroyActorId;
+            }
+            else
+            {
+                NodeStartTaskList::iterator inodeStartTask = nodeStartTaskList.find(i->coreId);
+                assert(inodeStartTask != nodeStartTaskList.end());
+                inodeStartTask->starters.push_back(&*i);
+            }
+        }
+        nodeStartTaskList.execute(NodeStartTask::NEW_CORE_ACTOR);
+        return;
+    }
     Actor::ActorId previousServiceDestroyActorId;
     for (StartSequence::StarterChain::const_iterator i = startSequence.starterChain.begin(),
                                                      endi = startSequence.starterChain.end();
@@ -612,8 +805,8 @@ Actor::ActorId Engine::newCore(CoreId coreId, bool isRedZone, NewCoreStarter &ne
     try
     {
         threadSetAffinity(coreId);
-        node =
-            new CacheLineAlignedObject<AsyncNode>(AsyncNode::Init(*nodeManager.get(), coreId, customEventLoopFactory));
+        node = new CacheLineAlignedObject<AsyncNode>(
+            AsyncNode::Init(*nodeManager.get(), coreId, customEventLoopFactory, policy, isRedZone));
         (*node)->newActor<CoreActor>(CoreActor::Init(*this, coreId, isRedZone));
         ret = newCoreStarter.start(**node);
     }
@@ -696,7 +889,8 @@ Engine::CoreId Engine::CoreSet::at(NodeId nodeId) const
     Engine::StartSequence::StartSequence(const CoreSet &pcoreSet, int)
         : coreSet(pcoreSet), asyncNodeAllocator(new AsyncNodeAllocator), asyncExceptionHandler(0),
         engineCustomCoreActorFactory(0), engineCustomEventLoopFactory(0),
-        eventAllocatorPageSizeByte(DEFAULT_EVENT_ALLOCATOR_PAGE_SIZE), threadStackSizeByte(0)
+        eventAllocatorPageSizeByte(DEFAULT_EVENT_ALLOCATOR_PAGE_SIZE), eventAllocatorHugePageFlag(false),
+        parallelStartFlag(false), threadStackSizeByte(0)
 {
     std::stringstream s;
     s << (uint64_t)getPID() << '-' << getTSC() << std::ends;
@@ -725,6 +919,96 @@ void Engine::StartSequence::setRedZoneParam(const ThreadRealTimeParam &predZoneP
 
 const ThreadRealTimeParam &Engine::StartSequence::getRedZoneParam() const noexcept { return redZoneParam; }
 
+void Engine::StartSequence::setIdlePolicy(const EngineIdlePolicy &pidlePolicy) noexcept
+{
+    policy.idlePolicy = pidlePolicy;
+}
+
+const EngineIdlePolicy &Engine::StartSequence::getIdlePolicy() const noexcept { return policy.idlePolicy; }
+
+void Engine::StartSequence::setEventPageTrimPolicy(const EngineEventPageTrimPolicy &peventPageTrimPolicy) noexcept
+{
+    policy.eventPageTrimPolicy = peventPageTrimPolicy;
+}
+
+const EngineEventPageTrimPolicy &Engine::StartSequence::getEventPageTrimPolicy() const noexcept
+{
+    return policy.eventPageTrimPolicy;
+}
+
+void Engine::StartSequence::setEventFlowControlPolicy(
+    const EngineEventFlowControlPolicy &peventFlowControlPolicy) noexcept
+{
+    policy.eventFlowControlPolicy = peventFlowControlPolicy;
+}
+
+const EngineEventFlowControlPolicy &Engine::StartSequence::getEventFlowControlPolicy() const noexcept
+{
+    return policy.eventFlowControlPolicy;
+}
+
+void Engine::StartSequence::setEventDeliveryBudgetPolicy(
+    const EngineEventDeliveryBudgetPolicy &peventDeliveryBudgetPolicy) noexcept
+{
+    policy.eventDeliveryBudgetPolicy = peventDeliveryBudgetPolicy;
+}
+
+const EngineEventDeliveryBudgetPolicy &Engine::StartSequence::getEventDeliveryBudgetPolicy() const noexcept
+{
+    return policy.eventDeliveryBudgetPolicy;
+}
+
+void Engine::StartSequence::setEventHandlerPlacementPolicy(
+    const EngineEventHandlerPlacementPolicy &peventHandlerPlacementPolicy) noexcept
+{
+    policy.eventHandlerPlacementPolicy = peventHandlerPlacementPolicy;
+}
+
+const EngineEventHandlerPlacementPolicy &Engine::StartSequence::getEventHandlerPlacementPolicy() const noexcept
+{
+    return policy.eventHandlerPlacementPolicy;
+}
+
+void Engine::StartSequence::setEventDirectDeliveryPolicy(
+    const EngineEventDirectDeliveryPolicy &peventDirectDeliveryPolicy) noexcept
+{
+    policy.eventDirectDeliveryPolicy = peventDirectDeliveryPolicy;
+}
+
+const EngineEventDirectDeliveryPolicy &Engine::StartSequence::getEventDirectDeliveryPolicy() const noexcept
+{
+    return policy.eventDirectDeliveryPolicy;
+}
+
+void Engine::StartSequence::setEventGroupingPolicy(const EngineEventGroupingPolicy &peventGroupingPolicy) noexcept
+{
+    policy.eventGroupingPolicy = peventGroupingPolicy;
+}
+
+const EngineEventGroupingPolicy &Engine::StartSequence::getEventGroupingPolicy() const noexcept
+{
+    return policy.eventGroupingPolicy;
+}
+
+void Engine::StartSequence::setEventPrefetchPolicy(const EngineEventPrefetchPolicy &peventPrefetchPolicy) noexcept
+{
+    policy.eventPrefetchPolicy = peventPrefetchPolicy;
+}
+
+const EngineEventPrefetchPolicy &Engine::StartSequence::getEventPrefetchPolicy() const noexcept
+{
+    return policy.eventPrefetchPolicy;
+}
+
+void Engine::StartSequence::setOffloadPolicy(const EngineOffloadPolicy &poffloadPolicy) noexcept
+{
+    policy.offloadPolicy = poffloadPolicy;
+}
+
+const EngineOffloadPolicy &Engine::StartSequence::getOffloadPolicy() const noexcept { return policy.offloadPolicy; }
+
+const EnginePolicy &Engine::StartSequence::getPolicy() const noexcept { return policy; }
+
 /**
  * throw (std::bad_alloc)
  */
@@ -769,6 +1053,16 @@ void Engine::StartSequence::setEventAllocatorPageSizeByte(size_t peventAllocator
     eventAllocatorPageSizeByte = peventAllocatorPageSizeByte;
 }
 
+void Engine::StartSequence::setEventAllocatorHugePageFlag(bool peventAllocatorHugePageFlag) noexcept
+{
+    eventAllocatorHugePageFlag = peventAllocatorHugePageFlag;
+}
+
+void Engine::StartSequence::setParallelStartFlag(bool pparallelStartFlag) noexcept
+{
+    parallelStartFlag = pparallelStartFlag;
+}
+
 void Engine::StartSequence::setThreadStackSizeByte(size_t pthreadStackSizeByte) noexcept
 {
     threadStackSizeByte = pthreadStackSizeByte;
@@ -791,6 +1085,10 @@ EngineCustomEventLoopFactory *Engine::StartSequence::getEngineCustomEventLoopFac
 
 size_t Engine::StartSequence::getEventAllocatorPageSizeByte() const noexcept { return eventAllocatorPageSizeByte; }
 
+bool Engine::StartSequence::getEventAllocatorHugePageFlag() const noexcept { return eventAllocatorHugePageFlag; }
+
+bool Engine::StartSequence::getParallelStartFlag() const noexcept { return parallelStartFlag; }
+
 size_t Engine::StartSequence::getThreadStackSizeByte() const noexcept { return threadStackSizeByte; }
 
 /**
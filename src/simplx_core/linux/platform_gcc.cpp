@@ -21,6 +21,11 @@
 
 #include <sys/types.h>
 #include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <dirent.h>
+#include <linux/futex.h>
+#include <linux/mempolicy.h>
 #include <netdb.h>
 
 /*
@@ -192,6 +197,97 @@ size_t simplx::cpuGetCount()
     return (size_t)ret;
 }
 
+int simplx::cpuGetNumaNode(unsigned coreId) noexcept
+{
+    char path[64];
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u", coreId);
+    DIR *dir = opendir(path);
+    if (dir == 0)
+    {
+        return -1;
+    }
+    int ret = -1;
+    for (struct dirent *entry; ret == -1 && (entry = readdir(dir)) != 0;)
+    {
+        if (strncmp(entry->d_name, "node", 4) == 0 && entry->d_name[4] >= '0' && entry->d_name[4] <= '9')
+        {
+            ret = atoi(entry->d_name + 4);
+        }
+    }
+    closedir(dir);
+    return ret;
+}
+
+void simplx::memorySetNumaNode(void *p, size_t sz, int numaNode) noexcept
+{
+    static const size_t NODE_MASK_BIT_COUNT = 8 * sizeof(unsigned long);
+    if (numaNode < 0 || (size_t)numaNode >= 16 * NODE_MASK_BIT_COUNT || sz == 0)
+    {
+        return;
+    }
+    unsigned long nodeMask[16] = {};
+    nodeMask[numaNode / NODE_MASK_BIT_COUNT] = 1ul << (numaNode % NODE_MASK_BIT_COUNT);
+    const uintptr_t pageSize = (uintptr_t)systemPageSize();
+    // pages partially covered may hold neighbouring objects, which must not be moved
+    const uintptr_t start = ((uintptr_t)p + pageSize - 1) & ~(pageSize - 1);
+    const uintptr_t end = ((uintptr_t)p + sz) & ~(pageSize - 1);
+    if (start >= end)
+    {
+        return;
+    }
+    // best effort: may fail without NUMA kernel support, placement then remains first-touch
+    syscall(SYS_mbind, start, end - start, MPOL_PREFERRED, nodeMask, 16 * NODE_MASK_BIT_COUNT + 1, MPOL_MF_MOVE);
+}
+
+int simplx::memoryGetNumaNode(const void *p) noexcept
+{
+    void *page = (void *)((uintptr_t)p & ~((uintptr_t)systemPageSize() - 1));
+    int status = -1;
+    if (syscall(SYS_move_pages, 0, 1ul, &page, 0, &status, 0) != 0 || status < 0)
+    {
+        return -1;
+    }
+    return status;
+}
+
+void *simplx::memoryHugePageMap(size_t sz)
+{
+    assert(sz % HUGE_PAGE_SIZE == 0);
+    void *p = mmap(0, sz, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (p != MAP_FAILED)
+    {
+        return p;
+    }
+    // no reserved hugetlbfs pages: fall back to transparent huge pages, which need a huge page aligned range
+    char *q = static_cast<char *>(mmap(0, sz + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (q == MAP_FAILED)
+    {
+        throw std::bad_alloc();
+    }
+    char *ret = reinterpret_cast<char *>(((uintptr_t)q + HUGE_PAGE_SIZE - 1) & ~((uintptr_t)HUGE_PAGE_SIZE - 1));
+    if (ret != q)
+    {
+        munmap(q, ret - q);
+    }
+    munmap(ret + sz, HUGE_PAGE_SIZE - (ret - q));
+    madvise(ret, sz, MADV_HUGEPAGE); // best effort: may fail if transparent huge pages are disabled
+    return ret;
+}
+
+void simplx::memoryHugePageUnmap(void *p, size_t sz) noexcept { munmap(p, sz); }
+
+void simplx::memoryRelease(void *p, size_t sz) noexcept
+{
+    const uintptr_t pageSize = (uintptr_t)systemPageSize();
+    const uintptr_t start = ((uintptr_t)p + pageSize - 1) & ~(pageSize - 1);
+    const uintptr_t end = ((uintptr_t)p + sz) & ~(pageSize - 1);
+    if (start < end)
+    {
+        // best effort: fails on hugetlbfs pages which are not covered as a whole
+        madvise((void *)start, end - start, MADV_DONTNEED);
+    }
+}
+
 simplx::thread_t simplx::threadCreate(void (*fn)(void *), void *param, size_t stackSizeBytes)
 {
     struct Callback
@@ -342,6 +438,15 @@ void simplx::threadSleep(const Time &delay)
     }
 }
 
+void simplx::threadPark(int &parkWord, int parkedValue, const Time &timeOut) noexcept
+{
+    struct timespec req = {timeOut.extractSeconds(), (long)timeOut.extractNanoseconds()};
+    // EAGAIN (parkWord already changed), EINTR and ETIMEDOUT all mean the same to the caller: re-check and carry on
+    syscall(SYS_futex, &parkWord, FUTEX_WAIT_PRIVATE, parkedValue, &req, 0, 0);
+}
+
+void simplx::threadUnpark(int &parkWord) noexcept { syscall(SYS_futex, &parkWord, FUTEX_WAKE_PRIVATE, 1, 0, 0, 0); }
+
 simplx::tls_t simplx::tlsCreate()
 {
     tls_t key;
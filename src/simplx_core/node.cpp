@@ -24,10 +24,13 @@ AsyncNodeBase::StaticShared AsyncNodeBase::s_StaticShared;
 Actor::EventTable::EventTable(void *pdeallocatePointer) noexcept : nodeActorId(0),
                                                                         asyncActor(0),
                                                                         lfEvent(0),
+                                                                        lfEventIndex(0),
                                                                         undeliveredEvent(0),
                                                                         undeliveredEventCount(0),
                                                                         nextUnused(0),
-                                                                        deallocatePointer(pdeallocatePointer)
+                                                                        deallocatePointer(pdeallocatePointer),
+                                                                        typedEventHandler(0),
+                                                                        dispatchCount(0)
 {
     CRITICAL_ASSERT((uintptr_t) this % CACHE_LINE_SIZE == 0);
 }
@@ -39,8 +42,10 @@ Actor::EventTable::EventTable(void *pdeallocatePointer) noexcept : nodeActorId(0
     assert(nodeActorId == 0);
     assert(asyncActor == 0);
     assert(lfEvent == 0);
+    assert(lfEventIndex == 0);
     assert(undeliveredEvent == 0);
     assert(undeliveredEventCount == 0);
+    assert(dispatchCount == 0);
 }
 
 void Actor::EventTable::onUndeliveredEvent(const Event &event) const
@@ -63,25 +68,163 @@ void Actor::EventTable::onUndeliveredEvent(const Event &event) const
 }
 
 // returns [dispatched ok]
-bool Actor::EventTable::onLowFrequencyEvent(const Event &event, uint64_t &performanceCounter) const
+bool Actor::EventTable::onLowFrequencyEvent(const Event &event, uint64_t &performanceCounter,
+                                            bool dispatchCountFlag) const
 {
     if (lfEvent == 0)
     {
         return false;
     }
+    EventId eventId = event.getClassId();
     int i = 0;
-    for (; lfEvent[i].eventId != MAX_EVENT_ID_COUNT && event.getClassId() != lfEvent[i].eventId; ++i)
+    if (lfEventIndex != 0)
     {
+        size_t h = eventId & lfEventIndex->mask;
+        for (; lfEventIndex->slot[h] != 0 && lfEvent[lfEventIndex->slot[h] - 1].eventId != eventId;
+             h = (h + 1) & lfEventIndex->mask)
+        {
+        }
+        if (lfEventIndex->slot[h] == 0)
+        {
+            return false;
+        }
+        i = lfEventIndex->slot[h] - 1;
     }
-    if (lfEvent[i].eventId == MAX_EVENT_ID_COUNT)
+    else
     {
-        return false;
+        for (; lfEvent[i].eventId != MAX_EVENT_ID_COUNT && eventId != lfEvent[i].eventId; ++i)
+        {
+        }
+        if (lfEvent[i].eventId == MAX_EVENT_ID_COUNT)
+        {
+            return false;
+        }
     }
     ++performanceCounter;
+    if (dispatchCountFlag && (size_t)i < dispatchCount->lfCount)
+    {
+        ++dispatchCount->lf[i];
+    }
     assert(lfEvent[i].staticEventHandler != 0);
     return (*lfEvent[i].staticEventHandler)(lfEvent[i].eventHandler, event);
 }
 
+/**
+ * (Re)builds lfEventIndex once lfEvent has at least LOW_FREQUENCY_INDEX_MIN_EVENT_COUNT entries.
+ * lfEvent entries are never removed (unregistered ones get onUnregisteredEvent), so the index only grows:
+ * it is updated in place while at most half full, and rebuilt twice as large otherwise.
+ * If the index cannot be allocated, lfEvent is scanned instead.
+ */
+void Actor::EventTable::indexLowFrequencyEvents(AsyncNodeAllocator &allocator) noexcept
+{
+    size_t eventCount = 0;
+    for (; lfEvent != 0 && lfEvent[eventCount].eventId != MAX_EVENT_ID_COUNT; ++eventCount)
+    {
+    }
+    if (eventCount < LOW_FREQUENCY_INDEX_MIN_EVENT_COUNT)
+    {
+        return;
+    }
+    assert(eventCount < std::numeric_limits<uint16_t>::max());
+    if (lfEventIndex != 0 && 2 * eventCount <= lfEventIndex->mask + 1)
+    { // enough room left: only the last lfEvent entry may be missing from the index
+        size_t h = lfEvent[eventCount - 1].eventId & lfEventIndex->mask;
+        for (; lfEventIndex->slot[h] != 0 && lfEventIndex->slot[h] != eventCount; h = (h + 1) & lfEventIndex->mask)
+        {
+        }
+        lfEventIndex->slot[h] = (uint16_t)eventCount;
+        return;
+    }
+    size_t mask = 1;
+    for (; mask + 1 < 2 * eventCount; mask = 2 * mask + 1)
+    {
+    }
+    LowFrequencyEventIndex *index;
+    try
+    {
+        index = static_cast<LowFrequencyEventIndex *>(allocator.allocate(LowFrequencyEventIndex::byteSize(mask)));
+    }
+    catch (std::bad_alloc &)
+    {
+        releaseLowFrequencyEventIndex(allocator);
+        return;
+    }
+    index->mask = mask;
+    std::memset(index->slot, 0, (mask + 1) * sizeof(uint16_t));
+    for (size_t i = 0; i < eventCount; ++i)
+    {
+        size_t h = lfEvent[i].eventId & mask;
+        for (; index->slot[h] != 0; h = (h + 1) & mask)
+        {
+        }
+        index->slot[h] = (uint16_t)(i + 1);
+    }
+    releaseLowFrequencyEventIndex(allocator);
+    lfEventIndex = index;
+}
+
+void Actor::EventTable::releaseLowFrequencyEventIndex(AsyncNodeAllocator &allocator) noexcept
+{
+    if (lfEventIndex != 0)
+    {
+        allocator.deallocate(LowFrequencyEventIndex::byteSize(lfEventIndex->mask), lfEventIndex);
+        lfEventIndex = 0;
+    }
+}
+
+/**
+ * Grows dispatchCount to cover every lfEvent entry, to be called once lfEvent got a new entry.
+ * If it cannot be grown, the new entries are not counted.
+ */
+void Actor::EventTable::resizeDispatchCount(AsyncNodeAllocator &allocator) noexcept
+{
+    if (dispatchCount == 0 || lfEvent == 0)
+    {
+        return;
+    }
+    size_t eventCount = 0;
+    for (; lfEvent[eventCount].eventId != MAX_EVENT_ID_COUNT; ++eventCount)
+    {
+    }
+    if (eventCount <= dispatchCount->lfCount)
+    {
+        return;
+    }
+    size_t lfCount = lfRegisteredEventArraySize(lfEvent);
+    DispatchCount *count;
+    try
+    {
+        count = static_cast<DispatchCount *>(allocator.allocate(DispatchCount::byteSize(lfCount)));
+    }
+    catch (std::bad_alloc &)
+    {
+        return;
+    }
+    std::memcpy(count, dispatchCount, DispatchCount::byteSize(dispatchCount->lfCount));
+    std::memset(count->lf + dispatchCount->lfCount, 0, (lfCount - dispatchCount->lfCount) * sizeof(uint64_t));
+    count->lfCount = lfCount;
+    releaseDispatchCount(allocator);
+    dispatchCount = count;
+}
+
+void Actor::EventTable::resetDispatchCount() noexcept
+{
+    if (dispatchCount != 0)
+    {
+        std::memset(dispatchCount->hf, 0, sizeof(dispatchCount->hf));
+        std::memset(dispatchCount->lf, 0, dispatchCount->lfCount * sizeof(uint64_t));
+    }
+}
+
+void Actor::EventTable::releaseDispatchCount(AsyncNodeAllocator &allocator) noexcept
+{
+    if (dispatchCount != 0)
+    {
+        allocator.deallocate(DispatchCount::byteSize(dispatchCount->lfCount), dispatchCount);
+        dispatchCount = 0;
+    }
+}
+
 size_t Actor::EventTable::lfRegisteredEventArraySize(RegisteredEvent *registeredEvent) noexcept
 {
     size_t i = 0;
@@ -123,17 +266,19 @@ size_t Actor::EventTable::lfRegisteredEventArraySize(RegisteredEvent *registered
 
 //---- Nodes Handle CTOR -------------------------------------------------------
 
-    AsyncNodesHandle::AsyncNodesHandle(const std::pair<size_t, const CoreSet *> &init)
-        : size(init.second->size()), eventAllocatorPageSize(init.first), activeNodeHandles(size, false), nodeHandles(size)
+    AsyncNodesHandle::AsyncNodesHandle(const Init &init)
+        : size(init.coreSet->size()), eventAllocatorPageSize(init.eventAllocatorPageSize),
+          eventAllocatorHugePageFlag(init.eventAllocatorHugePageFlag),
+          activeNodeHandles(size, false), nodeHandles(size)
 {
     cpuset_type currentThreadAffinity = threadGetAffinity();
     for (size_t i = 0; i < size; ++i)
     {
         try
         {
-            threadSetAffinity(init.second->at(
+            threadSetAffinity(init.coreSet->at(
                 (NodeId)i)); // For NUMA to allocate nodeHandle in the correponding core NUMA memory node
-            nodeHandles[i].init(*this, *init.second);
+            nodeHandles[i].init(*this, *init.coreSet);
         }
         catch (...)
         {
@@ -152,6 +297,64 @@ size_t Actor::EventTable::lfRegisteredEventArraySize(RegisteredEvent *registered
                                                         nodeHandles[j]->readerSharedHandles[i]);
         }
     }
+
+    // first-touch placement above is not reliable (e.g. memory recycled by the allocator), so place explicitly when
+    // cores span several NUMA nodes
+    bool multiNumaNodeFlag = false;
+    for (size_t i = 1; i < size && !multiNumaNodeFlag; ++i)
+    {
+        multiNumaNodeFlag = cpuGetNumaNode(init.coreSet->at((NodeId)i)) != cpuGetNumaNode(init.coreSet->at(0));
+    }
+    for (size_t i = 0; multiNumaNodeFlag && i < size; ++i)
+    {
+        nodeHandles[i]->setNumaNode(cpuGetNumaNode(init.coreSet->at((NodeId)i)));
+    }
+}
+
+Engine::NumaPlacement AsyncNodesHandle::getNumaPlacement(NodeId writerNodeId, NodeId readerNodeId) noexcept
+{
+    struct EventPageOperator
+    {
+        Engine::NumaPlacement &numaPlacement;
+        EventPageOperator(Engine::NumaPlacement &pnumaPlacement) noexcept : numaPlacement(pnumaPlacement) {}
+        void operator()(void *eventPage) noexcept
+        {
+            ++numaPlacement.eventPageCount;
+            if (numaPlacement.writerCoreNumaNode != -1 &&
+                memoryGetNumaNode(eventPage) == numaPlacement.writerCoreNumaNode)
+            {
+                ++numaPlacement.writerEventPageCount;
+            }
+        }
+    };
+    assert(writerNodeId < size);
+    assert(readerNodeId < size);
+    NodeHandle &writerNodeHandle = getNodeHandle(writerNodeId);
+    NodeHandle &readerNodeHandle = getNodeHandle(readerNodeId);
+    WriterSharedHandle &writerSharedHandle = writerNodeHandle.getWriterSharedHandle(readerNodeId);
+    Engine::NumaPlacement ret;
+    ret.writerCoreNumaNode = cpuGetNumaNode(writerNodeHandle.coreSet.at(writerNodeId));
+    ret.readerCoreNumaNode = cpuGetNumaNode(readerNodeHandle.coreSet.at(readerNodeId));
+    ret.writerSharedNumaNode = memoryGetNumaNode(&writerSharedHandle.cl2.shared.writeCache);
+    ret.readerSharedNumaNode = memoryGetNumaNode(&readerNodeHandle.getReaderSharedHandle(writerNodeId).cl2);
+    EventPageOperator eventPageOperator(ret);
+    writerSharedHandle.cl2.shared.writeCache.eventAllocatorPageAllocator.foreach(eventPageOperator);
+    return ret;
+}
+
+Engine::EventPageCount AsyncNodesHandle::getEventPageCount(NodeId writerNodeId, NodeId readerNodeId) noexcept
+{
+    assert(writerNodeId < size);
+    assert(readerNodeId < size);
+    const Shared::WriteCache &writeCache =
+        getNodeHandle(writerNodeId).getWriterSharedHandle(readerNodeId).cl2.shared.writeCache;
+    Engine::EventPageCount ret;
+    ret.freePageCount = writeCache.freeEventAllocatorPageCount;
+    ret.trimmedPageCount = writeCache.trimmedEventAllocatorPageCount;
+    size_t pageCount = writeCache.nextEventAllocatorPageIndex; // read last: counts above may be ahead
+    ret.usedPageCount =
+        pageCount > ret.freePageCount + ret.trimmedPageCount ? pageCount - ret.freePageCount - ret.trimmedPageCount : 0;
+    return ret;
 }
 
 AsyncNodesHandle::ReaderSharedHandle::ReaderSharedHandle() noexcept
@@ -218,7 +421,9 @@ void AsyncNodesHandle::ReaderSharedHandle::dispatchUnreachableNodes(
 
 //---- WriterSharedHandle CTOR -------------------------------------------------
 
-    AsyncNodesHandle::WriterSharedHandle::WriterSharedHandle(size_t eventAllocatorPageSize) : cl2(eventAllocatorPageSize)
+    AsyncNodesHandle::WriterSharedHandle::WriterSharedHandle(
+        const std::pair<size_t, CacheLineAlignedHugePageSlab *> &init)
+        : cl2(init)
 {
 
     CRITICAL_ASSERT((uintptr_t)&cl1 % CACHE_LINE_SIZE == 0);
@@ -235,6 +440,7 @@ void AsyncNodesHandle::WriterSharedHandle::init(NodeId writerNodeId, NodeHandle
     cl1.isWriterActive = &readerSharedHandle.cl2.isWriterActive;
     cl1.isWriteLocked = &readerSharedHandle.cl2.isWriteLocked;
     cl1.writerNodeHandle = &writerNodeHandle;
+    cl1.readerNodeHandle = &readerNodeHandle;
     cl2.shared.readWriteLocked.writerNodeId = writerNodeId;
     cl2.shared.readWriteLocked.readerNodeHandle = &readerNodeHandle;
 }
@@ -268,25 +474,38 @@ AsyncNodesHandle::Shared::ReadWriteLocked::undeliveredEvent(const AsyncNodesHand
 /**
  * throw (std::bad_alloc)
  */
-AsyncNodesHandle::Shared::WriteCache::WriteCache(size_t peventAllocatorPageSize)
+AsyncNodesHandle::Shared::WriteCache::WriteCache(size_t peventAllocatorPageSize,
+                                                 CacheLineAlignedHugePageSlab *eventPageSlab)
     : checkUndeliveredEventsFlag(false), batchIdIncrement(0), batchId(0), totalWrittenByteSize(0),
+      totalWrittenEventCount(0), batchWrittenByteSize(0), batchWrittenEventCount(0), acknowledgedWrittenByteSize(0),
+      acknowledgedWrittenEventCount(0),
       eventAllocatorPageSize(peventAllocatorPageSize), frontUsedEventAllocatorPageChainOffset(0),
-      nextEventAllocatorPageIndex(0)
+      eventAllocatorPageAllocator(eventPageSlab), nextEventAllocatorPageIndex(0), freeEventAllocatorPageCount(1),
+      trimmedEventAllocatorPageCount(0), numaNode(-1)
 {
     CRITICAL_ASSERT(nextEventAllocatorPageIndex + 1 != 0);
-    freeEventAllocatorPageChain.push_back(new (eventAllocatorPageAllocator.insert(
-        CACHE_LINE_SIZE + eventAllocatorPageSize)) EventAllocatorPage(nextEventAllocatorPageIndex));
+    freeEventAllocatorPageChain.push_back(
+        new (eventAllocatorPageAllocator.insert(CACHE_LINE_SIZE + eventAllocatorPageSize))
+            EventAllocatorPage(nextEventAllocatorPageIndex, eventAllocatorPageSize));
     ++nextEventAllocatorPageIndex;
     CRITICAL_ASSERT(nextEventAllocatorPageIndex + 1 != 0);
-    usedEventAllocatorPageChain.push_back(new (eventAllocatorPageAllocator.insert(
-        CACHE_LINE_SIZE + eventAllocatorPageSize)) EventAllocatorPage(nextEventAllocatorPageIndex));
+    usedEventAllocatorPageChain.push_back(
+        new (eventAllocatorPageAllocator.insert(CACHE_LINE_SIZE + eventAllocatorPageSize))
+            EventAllocatorPage(nextEventAllocatorPageIndex, eventAllocatorPageSize));
     ++nextEventAllocatorPageIndex;
 }
 
+void AsyncNodesHandle::Shared::WriteCache::setNumaNode(int pnumaNode) noexcept
+{
+    numaNode = pnumaNode;
+    eventAllocatorPageAllocator.setNumaNode(numaNode); // slab pages are placed with the slab (see NodeHandle)
+}
+
 /**
  * throw (std::bad_alloc)
  */
-AsyncNodesHandle::Shared::Shared(size_t eventAllocatorPageSize) : writeCache(eventAllocatorPageSize)
+AsyncNodesHandle::Shared::Shared(size_t eventAllocatorPageSize, CacheLineAlignedHugePageSlab *eventPageSlab)
+    : writeCache(eventAllocatorPageSize, eventPageSlab)
 {
     CRITICAL_ASSERT((uintptr_t)&readWriteLocked % CACHE_LINE_SIZE == 0);
 }
@@ -295,20 +514,43 @@ AsyncNodesHandle::Shared::Shared(size_t eventAllocatorPageSize) : writeCache(eve
  * throw (std::bad_alloc)
  */
 AsyncNodesHandle::NodeHandle::NodeHandle(const std::pair<AsyncNodesHandle *, const CoreSet *> &init)
-    : readerSharedHandles(init.first->size), writerSharedHandles(init.first->size, init.first->eventAllocatorPageSize),
-      node(0), nextHanlerId(1), stopFlag(false), shutdownFlag(false), interruptFlag(true), coreSet(*init.second)
+    : parkFlag(0), readerSharedHandles(init.first->size),
+      writerSharedHandles(init.first->size,
+                          std::make_pair(init.first->eventAllocatorPageSize,
+                                         init.first->eventAllocatorHugePageFlag ? &eventPageSlab : 0)),
+      node(0), nextHanlerId(1),
+      numaNode(-1), stopFlag(false), shutdownFlag(false), interruptFlag(true), coreSet(*init.second)
 #ifndef NDEBUG
       ,
       debugNodePtrWasSet(false)
 #endif
 {
     assert(coreSet.size() == init.first->size);
+    CRITICAL_ASSERT((uintptr_t)&doorbell % CACHE_LINE_SIZE == 0);
+}
+
+/**
+ * Places the node memory (doorbell, reader flags, write-caches and event pages) on the given NUMA node.
+ */
+void AsyncNodesHandle::NodeHandle::setNumaNode(int pnumaNode) noexcept
+{
+    numaNode = pnumaNode;
+    // in pages of its own (see AsyncNodesHandle::CacheLineAlignedNodeHandleAutoPointer)
+    memorySetNumaNode(this, PageAlignedBuffer::pageAlignedSize(sizeof(NodeHandle)), numaNode);
+    eventPageSlab.setNumaNode(numaNode);
+    readerSharedHandles.setNumaNode(numaNode);
+    writerSharedHandles.setNumaNode(numaNode);
+    for (size_t i = 0, sz = writerSharedHandles.size(); i < sz; ++i)
+    {
+        writerSharedHandles[i].cl2.shared.writeCache.setNumaNode(numaNode);
+    }
 }
 
 AsyncNodesHandle::NodeHandle::~NodeHandle() noexcept
 {
     // assert(node == 0); // Silenced as to much defensive - typically over-stepping a failure in the thread preventing
     // call to delete node (required to comply with this assert) in AsyncNode::Thread::inThread()
+    eventPageSlab.clear(); // huge page event pages of the write-caches, which are not destroyed by page
 }
 
 void AsyncNodesHandle::WriterSharedHandle::writeFailed() noexcept
@@ -318,19 +560,28 @@ void AsyncNodesHandle::WriterSharedHandle::writeFailed() noexcept
     {
         cl2.shared.readWriteLocked.deliveredEventsFlag = false;
         writeDispatchAndClearUndeliveredEvents(cl2.shared.readWriteLocked.undeliveredEventChain);
-        {
-            EventChain emptyEventChain;
-            cl2.shared.readWriteLocked.toBeDeliveredEventChain.swap(emptyEventChain);
-        }
+        // delivered events were erased by the reader, what is left was held back by the delivery budget
+        writeDispatchAndClearUndeliveredEvents(cl2.shared.readWriteLocked.toBeDeliveredPriorityEventChain);
+        writeDispatchAndClearUndeliveredEvents(cl2.shared.readWriteLocked.toBeDeliveredEventChain);
     }
     else
     {
         assert(cl2.shared.readWriteLocked.undeliveredEventChain.empty());
+        writeDispatchAndClearUndeliveredEvents(cl2.shared.readWriteLocked.toBeDeliveredPriorityEventChain);
         writeDispatchAndClearUndeliveredEvents(cl2.shared.readWriteLocked.toBeDeliveredEventChain);
     }
+    writeDispatchAndClearUndeliveredEvents(cl2.shared.writeCache.toBeDeliveredPriorityEventChain);
     writeDispatchAndClearUndeliveredEvents(cl2.shared.writeCache.toBeDeliveredEventChain);
+    cl2.shared.writeCache.acknowledgedWrittenByteSize = cl2.shared.writeCache.batchWrittenByteSize =
+        cl2.shared.writeCache.totalWrittenByteSize;
+    cl2.shared.writeCache.acknowledgedWrittenEventCount = cl2.shared.writeCache.batchWrittenEventCount =
+        cl2.shared.writeCache.totalWrittenEventCount;
     cl2.shared.writeCache.freeEventAllocatorPageChain.push_back(cl2.shared.readWriteLocked.usedEventAllocatorPageChain);
     cl2.shared.writeCache.freeEventAllocatorPageChain.push_back(cl2.shared.writeCache.usedEventAllocatorPageChain);
+    cl2.shared.writeCache.freeLargeEventAllocatorPageChain.push_back(
+        cl2.shared.readWriteLocked.usedLargeEventAllocatorPageChain);
+    cl2.shared.writeCache.freeLargeEventAllocatorPageChain.push_back(
+        cl2.shared.writeCache.usedLargeEventAllocatorPageChain);
     assert(!cl2.shared.writeCache.freeEventAllocatorPageChain.empty());
     cl2.shared.writeCache.usedEventAllocatorPageChain.push_front(
         cl2.shared.writeCache.freeEventAllocatorPageChain.pop_front());
@@ -356,6 +607,18 @@ void AsyncNodesHandle::WriterSharedHandle::onUndeliveredEventToSourceActor(const
     assert(!event.isRouteToSource());
     assert(event.getSourceInProcessActorId().nodeId == cl1.writerNodeHandle->node->id);
     assert(event.getSourceInProcessActorId().nodeId == cl2.shared.readWriteLocked.writerNodeId);
+    if (event.getClassId() == cl1.writerNodeHandle->node->multicastEventClassId)
+    {   // once per destination the event was not delivered to
+        MulticastEvent &multicastEvent = static_cast<MulticastEvent &>(const_cast<Actor::Event &>(event));
+        for (size_t i = 0; i < multicastEvent.destinationActorIdCount; ++i)
+        {
+            if (multicastEvent.destinationActorIds[i] != null)
+            {
+                onUndeliveredEventToSourceActor(multicastEvent.getEvent(i));
+            }
+        }
+        return;
+    }
     const Actor::InProcessActorId &eventSourceActorId = event.getSourceInProcessActorId();
     const Actor::EventTable &eventTable = *eventSourceActorId.eventTable;
     if (eventSourceActorId.getNodeActorId() == eventTable.nodeActorId)
@@ -380,15 +643,18 @@ void AsyncNodesHandle::WriterSharedHandle::onUndeliveredEventToSourceActor(const
     }
 }
 
-AsyncNodeManager::AsyncNodeManager(size_t eventAllocatorPageSize, const CoreSet &pcoreSet)
+AsyncNodeManager::AsyncNodeManager(size_t eventAllocatorPageSize, const CoreSet &pcoreSet,
+                                   bool eventAllocatorHugePageFlag)
     : std::unique_ptr<AsyncExceptionHandler>(new AsyncExceptionHandler),
-      Parallel<AsyncNodesHandle>(std::make_pair(eventAllocatorPageSize, &pcoreSet)), exceptionHandler(**this),
+      Parallel<AsyncNodesHandle>(AsyncNodesHandle::Init(eventAllocatorPageSize, pcoreSet, eventAllocatorHugePageFlag)),
+      exceptionHandler(**this),
       coreSet(pcoreSet)
 {
 }
 
-AsyncNodeManager::AsyncNodeManager(AsyncExceptionHandler &pexceptionHandler, size_t eventAllocatorPageSize, const CoreSet &pcoreSet)
-    : Parallel<AsyncNodesHandle>(std::make_pair(eventAllocatorPageSize, &pcoreSet)),
+AsyncNodeManager::AsyncNodeManager(AsyncExceptionHandler &pexceptionHandler, size_t eventAllocatorPageSize,
+                                   const CoreSet &pcoreSet, bool eventAllocatorHugePageFlag)
+    : Parallel<AsyncNodesHandle>(AsyncNodesHandle::Init(eventAllocatorPageSize, pcoreSet, eventAllocatorHugePageFlag)),
       exceptionHandler(pexceptionHandler), coreSet(pcoreSet)
 {
 }
@@ -408,6 +674,11 @@ void AsyncNodeManager::shutdown() noexcept
     }
     
     memoryBarrier();
+    
+    for (size_t i = 0; i < nodesHandle.size; ++i)
+    {
+        nodesHandle.getNodeHandle((NodeId)i).unpark();
+    }
 }
 
     AsyncNodeBase::AsyncNodeBase(AsyncNodeManager &pnodeManager)
@@ -444,6 +715,7 @@ void AsyncNodeManager::shutdown() noexcept
     {
         Actor::EventTable *tmp = i;
         i = i->nextUnused;
+        tmp->releaseDispatchCount(nodeAllocator);
         tmp->~EventTable();
         nodeAllocator.deallocate(sizeof(Actor::EventTable) + CACHE_LINE_SIZE - 1, tmp->deallocatePointer);
     }
@@ -567,6 +839,19 @@ void AsyncNodeBase::StaticShared::AbsoluteEventIds::debugCheckMaps() const
           AsyncNodeManager::Node(init.nodeManager, init.nodeManager.getCoreSet().index(init.coreId)),
         eventLoop(init.customEventLoopFactory.newEventLoop()),
         corePerformanceCounters(Actor::AllocatorBase(*this), getCoreSet().size()),
+        idlePolicy(init.redZoneFlag ? EngineIdlePolicy() : init.policy.idlePolicy),
+        eventPageTrimPolicy(init.policy.eventPageTrimPolicy),
+        eventFlowControlPolicy(init.policy.eventFlowControlPolicy),
+        eventDeliveryBudgetPolicy(init.policy.eventDeliveryBudgetPolicy),
+        eventHandlerPlacementPolicy(init.policy.eventHandlerPlacementPolicy),
+        eventDispatchCountFlag(init.policy.eventHandlerPlacementPolicy.eventCount !=
+                               std::numeric_limits<uint64_t>::max()),
+        eventDirectDeliveryPolicy(init.policy.eventDirectDeliveryPolicy), directDeliveryDepth(0),
+        eventGrouping(init.policy.eventGroupingPolicy, Actor::Event::getClassId<AsyncNodesHandle::MulticastEvent>(),
+                      Actor::AllocatorBase(*this)),
+        eventPrefetchPolicy(init.policy.eventPrefetchPolicy),
+        multicastEventClassId(Actor::Event::getClassId<AsyncNodesHandle::MulticastEvent>()), idleLoopCount(0),
+        eventPageIdleLoopCount(0), eventHandlerPlacementOnEventCount(0),
         
 #ifndef NDEBUG
         debugSynchronizePostBarrierFlag(false),
@@ -598,8 +883,27 @@ catch (AsyncNodeManager::NodeInUseException &)
     AsyncNode::~AsyncNode() noexcept
 {
     assert(!debugSynchronizePostBarrierFlag);
+    {
+        AsyncNodesHandle::EventChain emptyEventChain;
+        localToBeDeliveredPriorityEventChain.swap(emptyEventChain);
+    }
+    {
+        AsyncNodesHandle::EventChain emptyEventChain;
+        localToBeDeliveredEventChain.swap(emptyEventChain);
+    }
     nodeHandle.getWriterSharedHandle(id).cl2.shared.writeCache.freeEventAllocatorPageChain.push_back(
         usedlocalEventAllocatorPageChain);
+    nodeHandle.getWriterSharedHandle(id).cl2.shared.writeCache.freeLargeEventAllocatorPageChain.push_back(
+        usedlocalLargeEventAllocatorPageChain);
+    for (size_t i = 0, sz = getNodeCount(); i < sz; ++i)
+    {
+        AsyncActorCallbackChain &writableCallbackChain =
+            nodeHandle.getWriterSharedHandle((Actor::NodeId)i).cl2.shared.writeCache.writableCallbackChain;
+        while (!writableCallbackChain.empty())
+        {
+            writableCallbackChain.front()->unregister();
+        }
+    }
         
     #ifdef TRACE_REF
         std::ofstream refLogFile;
@@ -641,12 +945,29 @@ Actor::EventTable &AsyncNode::retainEventTable(Actor &asyncActor)
     assert(ret->asyncActor == 0);
     assert(ret->lfEvent == 0);
     assert(ret->undeliveredEvent == 0);
+    assert(ret->typedEventHandler == 0);
+    if (eventDispatchCountFlag && ret->dispatchCount == 0)
+    {   // kept by free event-tables
+        try
+        {
+            ret->dispatchCount = static_cast<Actor::EventTable::DispatchCount *>(
+                nodeAllocator.allocate(Actor::EventTable::DispatchCount::byteSize(0)));
+        }
+        catch (std::bad_alloc &)
+        {
+            ret->nextUnused = freeEventTable;
+            freeEventTable = ret;
+            throw;
+        }
+        ret->dispatchCount->lfCount = 0;
+    }
+    ret->resetDispatchCount();
     ret->nodeActorId = nodeHandle.nextHanlerId;
     ret->asyncActor = &asyncActor;
     ++nodeHandle.nextHanlerId;
-    for (int i = 0; i < Actor::EventTable::HIGH_FREQUENCY_CALLBACK_ARRAY_SIZE; ++i)
+    for (int i = 0; i < Actor::EventTable::HIGH_FREQUENCY_EVENT_ID_ARRAY_SIZE; ++i)
     {
-        ret->hfEvent[i].eventId = Actor::MAX_EVENT_ID_COUNT;
+        ret->hfEventId[i] = Actor::MAX_EVENT_ID_COUNT;
     }
     return *ret;
 }
@@ -655,6 +976,8 @@ void AsyncNode::releaseEventTable(Actor::EventTable &eventTable) noexcept
 {
     eventTable.nodeActorId = 0;
     eventTable.asyncActor = 0;
+    eventTable.typedEventHandler = 0;
+    eventTable.releaseLowFrequencyEventIndex(nodeAllocator);
     if (eventTable.lfEvent != 0)
     {
         nodeAllocator.deallocate(Actor::EventTable::lfRegisteredEventArraySize(eventTable.lfEvent) *
@@ -684,6 +1007,58 @@ void AsyncNode::destroyAsyncActors() noexcept
     }
 }
 
+/**
+ * Parks the node thread until a peer writer rings the doorbell (see WriterSharedHandle::ringReaderDoorbell()),
+ * the node is interrupted (see AsyncNodeManager::shutdown()) or the idle policy time-out expires.
+ * parkFlag is set before checking for work, and peers change what is checked before resetting parkFlag,
+ * both with a full memory barrier in-between, so that no wake-up can be missed.
+ */
+void AsyncNode::park() noexcept
+{
+    Time now = HighResolutionTime()();
+    corePerformanceCounters.idleSpinNanosecond += (uint64_t)(now - idleStartTime).toNanosecond();
+    idleStartTime = now;
+    idleLoopCount = 1; // spin again before next parking
+    nodeHandle.parkFlag = 1;
+    memoryBarrier();
+    if (!nodeHandle.interruptFlag && !nodeHandle.doorbell.any() && !isWritePending() &&
+        asyncActorCallbackChain.empty() && asyncActorPerformanceNeutralCallbackChain.empty() &&
+        destroyedActorChain.empty())
+    {
+        threadPark(nodeHandle.parkFlag, 1, idlePolicy.parkTimeOut);
+        now = HighResolutionTime()();
+        ++corePerformanceCounters.idleParkCount;
+        corePerformanceCounters.idleParkNanosecond += (uint64_t)(now - idleStartTime).toNanosecond();
+        idleStartTime = now;
+    }
+    nodeHandle.parkFlag = 0;
+}
+
+/**
+ * Applies the event-handler placement policy (see EngineEventHandlerPlacementPolicy) to every actor of the node.
+ */
+void AsyncNode::placeEventHandlers() noexcept
+{
+    eventHandlerPlacementOnEventCount = corePerformanceCounters.onEventCount;
+    for (AsyncActorChain::iterator i = asyncActorChain.begin(), endi = asyncActorChain.end(); i != endi; ++i)
+    {
+        i->placeEventHandlers(corePerformanceCounters.eventHandlerPromotionCount,
+                              corePerformanceCounters.eventHandlerDemotionCount);
+    }
+}
+
+/**
+ * Trims the free event pages of each pair this node writes to (see EngineEventPageTrimPolicy).
+ */
+void AsyncNode::trimEventPages() noexcept
+{
+    for (size_t i = 0, sz = nodeHandle.writerSharedHandles.size(); i < sz; ++i)
+    {
+        nodeHandle.writerSharedHandles[i].cl2.shared.writeCache.trimEventPages(
+            eventPageTrimPolicy.freePageHighWatermark);
+    }
+}
+
 /**
  * throw (Exception)
  */
@@ -692,7 +1067,7 @@ AsyncNode::Thread::Thread(CoreId pcoreId, bool predZoneFlag, const ThreadRealTim
     : coreId(pcoreId), redZoneFlag(predZoneFlag), redZoneParam(predZoneParam),
       inThreadFlag(false), runFlag(false),
       inThreadExceptionFlag(false), startHook(pstartHook), startHookArg(pstartHookArg), stopHook(pstopHook),
-      inThreadNode(0)
+      inThreadNode(0), inThreadTask(0)
 {
     threadCreate(inThread, this, stackSizeBytes);
     for (; !inThreadFlag && !inThreadExceptionFlag; threadSleep())
@@ -711,6 +1086,7 @@ AsyncNode::Thread::~Thread() noexcept
 {
     assert(inThreadExceptionFlag == false);
     assert(inThreadNode != 0);
+    assert(inThreadTask == 0);
     for (runFlag = true; inThreadFlag; threadSleep())
     {
     }
@@ -731,6 +1107,51 @@ void AsyncNode::Thread::run(CacheLineAlignedObject<AsyncNode> &node) noexcept
     memoryBarrier();
 }
 
+void AsyncNode::Thread::execute(Task &task) noexcept
+{
+    assert(inThreadExceptionFlag == false);
+    assert(inThreadFlag == true);
+    assert(runFlag == false);
+    assert(inThreadTask == 0);
+    memoryBarrier();
+
+    inThreadTask = &task;
+
+    memoryBarrier();
+}
+
+void AsyncNode::Thread::waitExecuted()
+{
+    for (; inThreadTask != 0; threadSleep())
+    {
+    }
+    memoryBarrier();
+    if (inThreadTaskException)
+    {
+        std::exception_ptr taskException;
+        std::swap(taskException, inThreadTaskException);
+        std::rethrow_exception(taskException);
+    }
+}
+
+void AsyncNode::Thread::executeInThreadTask() noexcept
+{
+    memoryBarrier();
+    try
+    {
+        inThreadTask->onExecute();
+    }
+    catch (...)
+    {
+        inThreadTaskException = std::current_exception();
+    }
+    memoryBarrier();
+
+    inThreadTask = 0;
+
+    memoryBarrier();
+}
+
 void AsyncNode::Thread::inThread(void *pthread)
 {
     try
@@ -793,6 +1214,10 @@ void AsyncNode::Thread::inThread(void *pthread)
             }
             for (; !thread.runFlag; threadSleep())
             {
+                if (thread.inThreadTask != 0)
+                {
+                    thread.executeInThreadTask();
+                }
             }
             
             memoryBarrier();
@@ -969,24 +1394,158 @@ void    AsyncNode::onActorRemoved(Actor *actor)
     onNodeActorCountChange_LL(-1, actor);    
 }
 
-void AsyncNodesHandle::ReaderSharedHandle::read(void) noexcept
+//---- Event Grouping ----------------------------------------------------------
+
+const uint32_t AsyncNodesHandle::EventGrouping::NO_GROUP;
+
+AsyncNodesHandle::EventGrouping::EventGrouping(const EngineEventGroupingPolicy &eventGroupingPolicy,
+                                               Actor::EventId pmulticastEventClassId,
+                                               const Actor::AllocatorBase &allocator) noexcept
+    : minEventCount(eventGroupingPolicy.minEventCount), multicastEventClassId(pmulticastEventClassId),
+      events(allocator), eventGroups(allocator), groups(allocator), groupHashTable(allocator),
+      groupedEvents(allocator)
+{
+}
+
+namespace
+{
+
+inline size_t eventGroupHash(const Actor::EventTable *eventTable, size_t segment) noexcept
+{ // event-tables are cache-line aligned
+    return ((uintptr_t)eventTable / CACHE_LINE_SIZE) * 0x9e3779b1u + segment;
+}
+
+} // namespace
+
+/**
+ * Reorders the batch so that the events to the same destination actor are consecutive, keeping their relative order.
+ * Groups are dispatched in the order of their first event.
+ * The batch is left in arrival order if it is too small, already grouped, or if memory cannot be allocated.
+ */
+void AsyncNodesHandle::EventGrouping::group(EventChain &eventChain) noexcept
+{
+    events.clear();
+    for (EventChain::iterator i = eventChain.begin(), endi = eventChain.end(); i != endi; ++i)
+    {
+        if (events.size() == std::numeric_limits<uint32_t>::max())
+        {
+            return;
+        }
+        try
+        {
+            events.push_back(&*i);
+        }
+        catch (std::bad_alloc &)
+        {
+            return;
+        }
+    }
+    const size_t eventCount = events.size();
+    if (eventCount < minEventCount || eventCount < 3)
+    {
+        return;
+    }
+    size_t hashTableSize = 4;
+    for (; hashTableSize < 2 * eventCount; hashTableSize *= 2)
+    {
+    }
+    try
+    {
+        eventGroups.resize(eventCount);
+        groups.clear();
+        groups.reserve(eventCount);
+        groupHashTable.assign(hashTableSize, NO_GROUP);
+        groupedEvents.resize(eventCount);
+    }
+    catch (std::bad_alloc &)
+    {
+        return;
+    }
+    bool reorderFlag = false;
+    size_t segment = 0;
+    const Actor::EventTable *previousEventTable = 0;
+    uint32_t previousGroup = NO_GROUP;
+    for (size_t i = 0; i < eventCount; ++i)
+    {
+        const Actor::Event &event = *events[i];
+        if (event.getClassId() == multicastEventClassId)
+        { // not moved: is a group of its own, between two segments
+            eventGroups[i] = (uint32_t)groups.size();
+            groups.push_back(Group(0, ++segment));
+            groups.back().eventCount = 1;
+            ++segment;
+            previousEventTable = 0;
+            previousGroup = NO_GROUP;
+            continue;
+        }
+        const Actor::EventTable *eventTable = event.getDestinationInProcessActorId().eventTable;
+        if (eventTable != previousEventTable)
+        {
+            size_t h = eventGroupHash(eventTable, segment) & (hashTableSize - 1);
+            for (; groupHashTable[h] != NO_GROUP && (groups[groupHashTable[h]].eventTable != eventTable ||
+                                                     groups[groupHashTable[h]].segment != segment);
+                 h = (h + 1) & (hashTableSize - 1))
+            {
+            }
+            if (groupHashTable[h] == NO_GROUP)
+            {
+                groupHashTable[h] = (uint32_t)groups.size();
+                groups.push_back(Group(eventTable, segment));
+            }
+            else
+            { // joins a former group
+                reorderFlag = true;
+            }
+            previousEventTable = eventTable;
+            previousGroup = groupHashTable[h];
+        }
+        eventGroups[i] = previousGroup;
+        ++groups[previousGroup].eventCount;
+    }
+    if (!reorderFlag)
+    { // already grouped
+        return;
+    }
+    uint32_t offset = 0;
+    for (GroupVector::iterator i = groups.begin(), endi = groups.end(); i != endi; ++i)
+    { // segments are in creation order
+        i->offset = offset;
+        offset += i->eventCount;
+    }
+    assert(offset == eventCount);
+    for (size_t i = 0; i < eventCount; ++i)
+    {
+        groupedEvents[groups[eventGroups[i]].offset++] = events[i];
+    }
+    for (size_t i = 0; i < eventCount; ++i)
+    {
+        eventChain.pop_front();
+    }
+    assert(eventChain.empty());
+    for (size_t i = 0; i < eventCount; ++i)
+    {
+        eventChain.push_back(groupedEvents[i]);
+    }
+}
+
+/**
+ * Delivers one lane of in-process events, in order, within the delivery budget (see EngineEventDeliveryBudgetPolicy).
+ * Delivered events are erased so that the lane only holds the remainder if the budget was exhausted (returns false).
+ */
+bool AsyncNodesHandle::ReaderSharedHandle::readToBeDeliveredEvents(EventChain &toBeDeliveredEventChain,
+                                                                   EventDeliveryBudget &eventDeliveryBudget) noexcept
 {
-    assert(cl1.sharedReadWriteLocked);
-    
     Shared::ReadWriteLocked &sharedReadWriteLocked = *cl1.sharedReadWriteLocked;
-    assert(!sharedReadWriteLocked.deliveredEventsFlag);
-    sharedReadWriteLocked.deliveredEventsFlag = true;
-    assert(sharedReadWriteLocked.readerNodeHandle);
-    assert(sharedReadWriteLocked.readerNodeHandle->node);
     AsyncNode &node = *sharedReadWriteLocked.readerNodeHandle->node;
     
-    if (sharedReadWriteLocked.checkUndeliveredEventsFlag)
-    {   // flag will be falsed by next peer write
-        node.setWriteSignal(sharedReadWriteLocked.writerNodeId);
-    }
-    
-    for (EventChain::iterator i = sharedReadWriteLocked.toBeDeliveredEventChain.begin(), endi = sharedReadWriteLocked.toBeDeliveredEventChain.end(); i != endi; node.loopUsagePerformanceCounterIncrement = 1)
+    EventPrefetch eventPrefetch(node.eventPrefetchPolicy, toBeDeliveredEventChain);
+    for (EventChain::iterator i = toBeDeliveredEventChain.begin(), endi = toBeDeliveredEventChain.end(); i != endi; node.loopUsagePerformanceCounterIncrement = 1)
     {
+        if (eventDeliveryBudget.isExhausted())
+        {
+            return false;
+        }
+        eventPrefetch();
         assert(i->getSourceActorId() != i->getDestinationActorId());
         assert(i->getDestinationInProcessActorId().nodeId == node.id);
         
@@ -994,28 +1553,41 @@ void AsyncNodesHandle::ReaderSharedHandle::read(void) noexcept
         const Actor::InProcessActorId   &eventDestinationInProcessActorId = event.getDestinationInProcessActorId();
         const Actor::EventTable         &eventTable = *eventDestinationInProcessActorId.eventTable;
         
+        if (event.getClassId() == node.multicastEventClassId)
+        {
+            if (dispatchMulticastEvent(static_cast<MulticastEvent &>(event), node.corePerformanceCounters.onEventCount,
+                                       node.eventDispatchCountFlag,
+                                       node.nodeManager.exceptionHandler))
+            {
+                i = toBeDeliveredEventChain.erase(i);
+            }
+            else
+            {   // returned to sender for the remaining destinations
+                i = sharedReadWriteLocked.undeliveredEvent(i, toBeDeliveredEventChain);
+            }
+        }
         // is event destination in this node?
-        if (eventDestinationInProcessActorId.getNodeActorId() == eventTable.nodeActorId)
+        else if (eventDestinationInProcessActorId.getNodeActorId() == eventTable.nodeActorId)
         {
             try
             {
-                if (eventTable.onEvent(event, node.corePerformanceCounters.onEventCount))
+                if (eventTable.onEvent(event, node.corePerformanceCounters.onEventCount, node.eventDispatchCountFlag))
                 {
                     // was dispatched ok
-                    ++i;
+                    i = toBeDeliveredEventChain.erase(i);
                 }
                 else
                 {   // couldn't dispatch anomaly
-                    i = sharedReadWriteLocked.undeliveredEvent(i, sharedReadWriteLocked.toBeDeliveredEventChain);
+                    i = sharedReadWriteLocked.undeliveredEvent(i, toBeDeliveredEventChain);
                 }
             }
             catch (Actor::ReturnToSenderException &)
             {
-                i = sharedReadWriteLocked.undeliveredEvent(i, sharedReadWriteLocked.toBeDeliveredEventChain);
+                i = sharedReadWriteLocked.undeliveredEvent(i, toBeDeliveredEventChain);
             }
             catch (std::exception &e)
             {
-                ++i;
+                i = toBeDeliveredEventChain.erase(i);
                 assert(eventTable.asyncActor != 0);
                 assert(sharedReadWriteLocked.readerNodeHandle != 0);
                 assert(sharedReadWriteLocked.readerNodeHandle->node != 0);
@@ -1023,7 +1595,7 @@ void AsyncNodesHandle::ReaderSharedHandle::read(void) noexcept
             }
             catch (...)
             {
-                ++i;
+                i = toBeDeliveredEventChain.erase(i);
                 assert(eventTable.asyncActor != 0);
                 assert(sharedReadWriteLocked.readerNodeHandle != 0);
                 assert(sharedReadWriteLocked.readerNodeHandle->node != 0);
@@ -1032,9 +1604,45 @@ void AsyncNodesHandle::ReaderSharedHandle::read(void) noexcept
         }
         else
         {   // move from to-be-delivered into undelivered chain
-            i = sharedReadWriteLocked.undeliveredEvent(i, sharedReadWriteLocked.toBeDeliveredEventChain);
+            i = sharedReadWriteLocked.undeliveredEvent(i, toBeDeliveredEventChain);
         }
     }
+    return true;
+}
+
+/**
+ * Returns false if the delivery budget was exhausted (see EngineEventDeliveryBudgetPolicy), in which case the batch
+ * stays write-locked and the reader doorbell is rung so that read() resumes it at next synchronize.
+ */
+bool AsyncNodesHandle::ReaderSharedHandle::read(void) noexcept
+{
+    assert(cl1.sharedReadWriteLocked);
+    
+    Shared::ReadWriteLocked &sharedReadWriteLocked = *cl1.sharedReadWriteLocked;
+    assert(sharedReadWriteLocked.readerNodeHandle);
+    assert(sharedReadWriteLocked.readerNodeHandle->node);
+    AsyncNode &node = *sharedReadWriteLocked.readerNodeHandle->node;
+    
+    if (!sharedReadWriteLocked.deliveredEventsFlag)
+    {   // new batch (otherwise resumed)
+        sharedReadWriteLocked.deliveredEventsFlag = true;
+        node.eventGrouping(sharedReadWriteLocked.toBeDeliveredPriorityEventChain);
+        node.eventGrouping(sharedReadWriteLocked.toBeDeliveredEventChain);
+        if (sharedReadWriteLocked.checkUndeliveredEventsFlag)
+        {   // flag will be falsed by next peer write
+            node.setWriteSignal(sharedReadWriteLocked.writerNodeId);
+        }
+    }
+    
+    node.eventDeliveryBudget.newBatch();
+    if (!readToBeDeliveredEvents(sharedReadWriteLocked.toBeDeliveredPriorityEventChain, node.eventDeliveryBudget) ||
+        !readToBeDeliveredEvents(sharedReadWriteLocked.toBeDeliveredEventChain, node.eventDeliveryBudget))
+    {
+        ++node.corePerformanceCounters.deliveryBudgetHitCountVector[sharedReadWriteLocked.writerNodeId];
+        // rings own doorbell so that the remainder gets read at next synchronize
+        sharedReadWriteLocked.readerNodeHandle->doorbell.atomicSet(sharedReadWriteLocked.writerNodeId);
+        return false;
+    }
     
     // routed events (NOT always e2e-related) [PL]
     for (EventChain::iterator i = sharedReadWriteLocked.toBeRoutedEventChain.begin(), endi = sharedReadWriteLocked.toBeRoutedEventChain.end(); i != endi; node.loopUsagePerformanceCounterIncrement = 1)
@@ -1130,6 +1738,58 @@ void AsyncNodesHandle::ReaderSharedHandle::read(void) noexcept
         dispatchUnreachableNodes(*actorOnUnreachableChain, sharedReadWriteLocked.unreachableNodeConnectionChain,
                                  sharedReadWriteLocked.writerNodeId, node.nodeManager.exceptionHandler);
     }
+    return true;
+}
+
+/**
+ * Delivers the event of a MulticastPipe to each of its destination actors, in this node.
+ * Destination actor-ids are set to null once delivered, returns false if some remain (to be returned to sender).
+ */
+bool AsyncNodesHandle::ReaderSharedHandle::dispatchMulticastEvent(MulticastEvent &multicastEvent,
+                                                                  uint64_t &performanceCounter,
+                                                                  bool dispatchCountFlag,
+                                                                  AsyncExceptionHandler &exceptionHandler) noexcept
+{
+    bool ret = true;
+    for (size_t i = 0; i < multicastEvent.destinationActorIdCount; ++i)
+    {
+        Actor::InProcessActorId &destinationActorId = multicastEvent.destinationActorIds[i];
+        const Actor::EventTable &eventTable = *destinationActorId.eventTable;
+        Actor::Event &event = multicastEvent.getEvent(i);
+        
+        if (destinationActorId.getNodeActorId() == eventTable.nodeActorId)
+        {
+            try
+            {
+                if (eventTable.onEvent(event, performanceCounter, dispatchCountFlag))
+                {
+                    destinationActorId = null;
+                    continue;
+                }
+            }
+            catch (Actor::ReturnToSenderException &)
+            {
+            }
+            catch (std::exception &e)
+            {
+                destinationActorId = null;
+                assert(eventTable.asyncActor != 0);
+                exceptionHandler.onEventExceptionSynchronous(eventTable.asyncActor, typeid(*eventTable.asyncActor),
+                                                             "onEvent", event, e.what());
+                continue;
+            }
+            catch (...)
+            {
+                destinationActorId = null;
+                assert(eventTable.asyncActor != 0);
+                exceptionHandler.onEventExceptionSynchronous(eventTable.asyncActor, typeid(*eventTable.asyncActor),
+                                                             "onEvent", event, "unknown exception");
+                continue;
+            }
+        }
+        ret = false;
+    }
+    return ret;
 }
 
 bool AsyncNodesHandle::ReaderSharedHandle::returnToSender(const Actor::Event &event) noexcept
@@ -1137,16 +1797,22 @@ bool AsyncNodesHandle::ReaderSharedHandle::returnToSender(const Actor::Event &ev
     assert(!event.isRouted());
     assert(cl1.sharedReadWriteLocked);
     Shared::ReadWriteLocked &sharedReadWriteLocked = *cl1.sharedReadWriteLocked;
-    EventChain::iterator i = sharedReadWriteLocked.toBeDeliveredEventChain.begin(), endi = sharedReadWriteLocked.toBeDeliveredEventChain.end();
+    EventChain *toBeDeliveredEventChains[] = {&sharedReadWriteLocked.toBeDeliveredPriorityEventChain,
+                                              &sharedReadWriteLocked.toBeDeliveredEventChain};
     
-    for (; i != endi && &*i != &event; ++i)
+    for (size_t c = 0; c < sizeof(toBeDeliveredEventChains) / sizeof(toBeDeliveredEventChains[0]); ++c)
     {
-    }
-    
-    if (i != endi)
-    {
-        sharedReadWriteLocked.undeliveredEvent(i, sharedReadWriteLocked.toBeDeliveredEventChain);
-        return true;
+        EventChain::iterator i = toBeDeliveredEventChains[c]->begin(), endi = toBeDeliveredEventChains[c]->end();
+        
+        for (; i != endi && &*i != &event; ++i)
+        {
+        }
+        
+        if (i != endi)
+        {
+            sharedReadWriteLocked.undeliveredEvent(i, *toBeDeliveredEventChains[c]);
+            return true;
+        }
     }
     return false;
 }
@@ -1165,6 +1831,10 @@ bool AsyncNodesHandle::WriterSharedHandle::write() noexcept
         cl1.writerNodeHandle->node->loopUsagePerformanceCounterIncrement = 1;
         writeDispatchAndClearUndeliveredEvents(cl2.shared.readWriteLocked.undeliveredEventChain);
     }
+    {
+        EventChain emptyEventChain;
+        cl2.shared.readWriteLocked.toBeDeliveredPriorityEventChain.swap(emptyEventChain);
+    }
     {
         EventChain emptyEventChain;
         cl2.shared.readWriteLocked.toBeDeliveredEventChain.swap(emptyEventChain);
@@ -1181,17 +1851,29 @@ bool AsyncNodesHandle::WriterSharedHandle::write() noexcept
         Shared::UnreachableNodeConnectionChain emptyUnreachableNodeConnectionChain;
         cl2.shared.readWriteLocked.unreachableNodeConnectionChain.swap(emptyUnreachableNodeConnectionChain);
     }
+    cl2.shared.writeCache.acknowledgedWrittenByteSize = cl2.shared.writeCache.batchWrittenByteSize;
+    cl2.shared.writeCache.acknowledgedWrittenEventCount = cl2.shared.writeCache.batchWrittenEventCount;
     cl2.shared.writeCache.freeEventAllocatorPageChain.push_back(cl2.shared.readWriteLocked.usedEventAllocatorPageChain);
-    if (!cl2.shared.writeCache.toBeDeliveredEventChain.empty() || !cl2.shared.writeCache.toBeRoutedEventChain.empty() ||
+    cl2.shared.writeCache.freeLargeEventAllocatorPageChain.push_back(
+        cl2.shared.readWriteLocked.usedLargeEventAllocatorPageChain);
+    if (!cl2.shared.writeCache.toBeDeliveredPriorityEventChain.empty() ||
+        !cl2.shared.writeCache.toBeDeliveredEventChain.empty() || !cl2.shared.writeCache.toBeRoutedEventChain.empty() ||
         !cl2.shared.writeCache.toBeUndeliveredRoutedEventChain.empty() ||
         !cl2.shared.writeCache.unreachableNodeConnectionChain.empty())
     {
         isWriteWorthy = true;
+        assert(cl1.writerNodeHandle != 0);
+        assert(cl1.writerNodeHandle->node != 0);
+        cl1.writerNodeHandle->node->eventPageIdleLoopCount = 0; // pages were just freed (see trimEventPages())
         if (cl2.shared.writeCache.batchId != std::numeric_limits<uint64_t>::max())
         {
             cl2.shared.writeCache.batchId += cl2.shared.writeCache.batchIdIncrement;
             cl2.shared.writeCache.batchIdIncrement = 0;
         }
+        cl2.shared.writeCache.batchWrittenByteSize = cl2.shared.writeCache.totalWrittenByteSize;
+        cl2.shared.writeCache.batchWrittenEventCount = cl2.shared.writeCache.totalWrittenEventCount;
+        cl2.shared.readWriteLocked.toBeDeliveredPriorityEventChain.swap(
+            cl2.shared.writeCache.toBeDeliveredPriorityEventChain);
         cl2.shared.readWriteLocked.toBeDeliveredEventChain.swap(cl2.shared.writeCache.toBeDeliveredEventChain);
         cl2.shared.readWriteLocked.toBeRoutedEventChain.swap(cl2.shared.writeCache.toBeRoutedEventChain);
         cl2.shared.readWriteLocked.toBeUndeliveredRoutedEventChain.swap(
@@ -1199,11 +1881,15 @@ bool AsyncNodesHandle::WriterSharedHandle::write() noexcept
         cl2.shared.readWriteLocked.unreachableNodeConnectionChain.swap(
             cl2.shared.writeCache.unreachableNodeConnectionChain);
         cl2.shared.readWriteLocked.usedEventAllocatorPageChain.swap(cl2.shared.writeCache.usedEventAllocatorPageChain);
+        cl2.shared.readWriteLocked.usedLargeEventAllocatorPageChain.swap(
+            cl2.shared.writeCache.usedLargeEventAllocatorPageChain);
+        assert(cl2.shared.writeCache.toBeDeliveredPriorityEventChain.empty());
         assert(cl2.shared.writeCache.toBeDeliveredEventChain.empty());
         assert(cl2.shared.writeCache.toBeRoutedEventChain.empty());
         assert(cl2.shared.writeCache.toBeUndeliveredRoutedEventChain.empty());
         assert(cl2.shared.writeCache.unreachableNodeConnectionChain.empty());
         assert(cl2.shared.writeCache.usedEventAllocatorPageChain.empty());
+        assert(cl2.shared.writeCache.usedLargeEventAllocatorPageChain.empty());
         if (!cl2.shared.writeCache.freeEventAllocatorPageChain.empty())
         {
             cl2.shared.writeCache.usedEventAllocatorPageChain.push_front(
@@ -1222,6 +1908,13 @@ bool AsyncNodesHandle::WriterSharedHandle::localOnEvent(const Actor::Event &even
     assert((!event.isRouted() && event.getSourceInProcessActorId().nodeId == cl1.writerNodeHandle->node->id) ||
            (event.isRouted() && event.getRouteId().getNodeId() == cl1.writerNodeHandle->node->id));
     assert(event.getDestinationInProcessActorId().nodeId == cl1.writerNodeHandle->node->id);
+    if (event.getClassId() == cl1.writerNodeHandle->node->multicastEventClassId)
+    {
+        return ReaderSharedHandle::dispatchMulticastEvent(
+            static_cast<MulticastEvent &>(const_cast<Actor::Event &>(event)), performanceCounter,
+            cl1.writerNodeHandle->node->eventDispatchCountFlag,
+            cl1.writerNodeHandle->node->nodeManager.exceptionHandler);
+    }
     const Actor::ActorId &actorId = event.getDestinationActorId();
     Actor::NodeActorId nodeActorId = actorId.getNodeActorId();
     const Actor::EventTable *eventTable = actorId.eventTable;
@@ -1231,7 +1924,7 @@ bool AsyncNodesHandle::WriterSharedHandle::localOnEvent(const Actor::Event &even
     }
     try
     {
-        return eventTable->onEvent(event, performanceCounter);
+        return eventTable->onEvent(event, performanceCounter, cl1.writerNodeHandle->node->eventDispatchCountFlag);
     }
     catch (Actor::ReturnToSenderException &)
     {
@@ -1254,15 +1947,20 @@ bool AsyncNodesHandle::WriterSharedHandle::localOnEvent(const Actor::Event &even
 
 void AsyncNodesHandle::Shared::WriteCache::newEventPage()
 {
-    if (freeEventAllocatorPageChain.empty())
+    if (freeEventAllocatorPageChain.empty() && !trimmedEventAllocatorPageChain.empty())
+    {
+        usedEventAllocatorPageChain.push_front(trimmedEventAllocatorPageChain.pop_front());
+        --trimmedEventAllocatorPageCount;
+    }
+    else if (freeEventAllocatorPageChain.empty())
     {
         if (nextEventAllocatorPageIndex + 1 == 0)
         {
             throw std::bad_alloc();
         }
-        usedEventAllocatorPageChain.push_front(
-            new (eventAllocatorPageAllocator.insert(CACHE_LINE_SIZE + eventAllocatorPageSize))
-                AsyncNodesHandle::Shared::EventAllocatorPage(nextEventAllocatorPageIndex));
+        void *eventPage = eventAllocatorPageAllocator.insert(CACHE_LINE_SIZE + eventAllocatorPageSize, numaNode);
+        usedEventAllocatorPageChain.push_front(new (eventPage) AsyncNodesHandle::Shared::EventAllocatorPage(
+            nextEventAllocatorPageIndex, eventAllocatorPageSize));
         ++nextEventAllocatorPageIndex;
     }
     else
@@ -1272,6 +1970,96 @@ void AsyncNodesHandle::Shared::WriteCache::newEventPage()
     frontUsedEventAllocatorPageChainOffset = 0;
 }
 
+/**
+ * Events larger than eventAllocatorPageSize get a page of their own, spanning as many page sizes as needed.
+ * Large pages follow the batch as regular pages do, and are recycled once the batch is acknowledged.
+ */
+AsyncNodesHandle::Shared::EventAllocatorPage &AsyncNodesHandle::Shared::WriteCache::newLargeEventPage(size_t sz)
+{
+    assert(sz > eventAllocatorPageSize);
+    for (EventAllocatorPageChain::iterator i = freeLargeEventAllocatorPageChain.begin(),
+                                           endi = freeLargeEventAllocatorPageChain.end();
+         i != endi; ++i)
+    {
+        if (i->size >= sz)
+        {
+            EventAllocatorPage &eventPage = *i;
+            freeLargeEventAllocatorPageChain.erase(i);
+            usedLargeEventAllocatorPageChain.push_front(&eventPage);
+            return eventPage;
+        }
+    }
+    for (EventAllocatorPageChain::iterator i = trimmedLargeEventAllocatorPageChain.begin(),
+                                           endi = trimmedLargeEventAllocatorPageChain.end();
+         i != endi; ++i)
+    {
+        if (i->size >= sz)
+        {
+            EventAllocatorPage &eventPage = *i;
+            trimmedLargeEventAllocatorPageChain.erase(i);
+            --trimmedEventAllocatorPageCount;
+            usedLargeEventAllocatorPageChain.push_front(&eventPage);
+            return eventPage;
+        }
+    }
+    if (nextEventAllocatorPageIndex + 1 == 0)
+    {
+        throw std::bad_alloc();
+    }
+    size_t eventPageSize = eventAllocatorPageSize * ((sz + eventAllocatorPageSize - 1) / eventAllocatorPageSize);
+    void *eventPage = eventAllocatorPageAllocator.insert(CACHE_LINE_SIZE + eventPageSize, numaNode);
+    EventAllocatorPage *ret = new (eventPage) EventAllocatorPage(nextEventAllocatorPageIndex, eventPageSize);
+    ++nextEventAllocatorPageIndex;
+    usedLargeEventAllocatorPageChain.push_front(ret);
+    return *ret;
+}
+
+/**
+ * Releases the memory of the free pages beyond freePageHighWatermark (counted separately for regular and large
+ * pages), which are then kept in trimmed chains for reuse.
+ */
+void AsyncNodesHandle::Shared::WriteCache::trimEventPages(size_t freePageHighWatermark) noexcept
+{
+    struct TrimOperator
+    {
+        const size_t freePageHighWatermark;
+        size_t freePageCount;
+        size_t trimmedPageCount;
+        TrimOperator(size_t pfreePageHighWatermark) noexcept
+            : freePageHighWatermark(pfreePageHighWatermark), freePageCount(0), trimmedPageCount(0)
+        {
+        }
+        void operator()(EventAllocatorPageChain &freeChain, EventAllocatorPageChain &trimmedChain) noexcept
+        {
+            size_t n = 0;
+            for (EventAllocatorPageChain::iterator i = freeChain.begin(), endi = freeChain.end(); i != endi;)
+            {
+                if (n < freePageHighWatermark)
+                {
+                    ++n;
+                    ++i;
+                }
+                else
+                {
+                    EventAllocatorPage &eventPage = *i;
+                    i = freeChain.erase(i);
+                    memoryRelease(eventPage.at(0), eventPage.size);
+                    trimmedChain.push_front(&eventPage);
+                    ++trimmedPageCount;
+                }
+            }
+            freePageCount += n;
+        }
+    };
+    // pages carved out of the huge page slab cannot be released by event page (see memoryRelease()): all are kept
+    TrimOperator trimOperator(eventAllocatorPageAllocator.getSlab() == 0 ? freePageHighWatermark
+                                                                         : std::numeric_limits<size_t>::max());
+    trimOperator(freeEventAllocatorPageChain, trimmedEventAllocatorPageChain);
+    trimOperator(freeLargeEventAllocatorPageChain, trimmedLargeEventAllocatorPageChain);
+    freeEventAllocatorPageCount = trimOperator.freePageCount;
+    trimmedEventAllocatorPageCount += trimOperator.trimmedPageCount;
+}
+
 void *AsyncNodesHandle::Shared::WriteCache::allocateEvent(size_t sz)
 {
     assert(frontUsedEventAllocatorPageChainOffset <= eventAllocatorPageSize);
@@ -1279,7 +2067,8 @@ void *AsyncNodesHandle::Shared::WriteCache::allocateEvent(size_t sz)
     {
         if (sz > eventAllocatorPageSize)
         {
-            breakThrow(std::bad_alloc());
+            totalWrittenByteSize += sz;
+            return newLargeEventPage(sz).at(0);
         }
         newEventPage();
     }
@@ -1298,7 +2087,11 @@ void *AsyncNodesHandle::Shared::WriteCache::allocateEvent(size_t sz, uint32_t &e
     {
         if (sz > eventAllocatorPageSize)
         {
-            breakThrow(std::bad_alloc());
+            AsyncNodesHandle::Shared::EventAllocatorPage &largeEventPage = newLargeEventPage(sz);
+            eventPageIndex = largeEventPage.index;
+            eventPageOffset = 0;
+            totalWrittenByteSize += sz;
+            return largeEventPage.at(0);
         }
         newEventPage();
     }
@@ -1373,4 +2166,30 @@ void AsyncExceptionHandler::onUnreachableException(Actor &, const std::type_info
 #endif
 }
 
+void AsyncExceptionHandler::onCallbackException(Actor *, const std::type_info &asyncActorTypeInfo,
+                                                const char *onXXX_FunctionName, const char *whatException) noexcept
+{
+    try
+    {
+        stringstream oss;
+        oss << cppDemangledTypeInfoName(asyncActorTypeInfo) << "::" << onXXX_FunctionName << "() threw ("
+            << whatException << ')' << endl;
+        cout << oss.str();
+    }
+    catch (...)
+    {
+        try
+        {
+            cout << asyncActorTypeInfo.name() << "::" << onXXX_FunctionName << "() threw (" << whatException << ')'
+                 << endl;
+        }
+        catch (...)
+        {
+        }
+    }
+#ifndef NDEBUG
+    std::exit(-1);
+#endif
+}
+
 } // namespace simplx
@@ -0,0 +1,255 @@
+/**
+ * @file offload.cpp
+ * @brief simplx blocking task executor (see Actor::offload())
+ * @copyright 2019 Scalewatch (www.scalewatch.com). All rights reserved.
+ * Please see accompanying LICENSE file for licensing terms.
+ */
+
+#include "simplx_core/internal/offload.h"
+#include "simplx_core/internal/node.h"
+
+namespace simplx
+{
+
+/**
+ * throw (std::bad_alloc, RunTimeException)
+ */
+OffloadExecutor::OffloadExecutor(const EngineOffloadPolicy &policy, size_t threadStackSizeByte)
+    : queueSize(policy.queueSize), signal(mutex), stopFlag(false), lastToken(0), headTask(0), tailTask(0)
+{
+    try
+    {
+        for (size_t i = 0; i < policy.threadCount; ++i)
+        {
+            workerThreads.push_back(std::unique_ptr<WorkerThread>(new WorkerThread(*this)));
+            workerThreads.back()->run(threadStackSizeByte);
+        }
+    }
+    catch (...)
+    {
+        stop();
+        throw;
+    }
+}
+
+OffloadExecutor::~OffloadExecutor() noexcept { stop(); }
+
+/**
+ * throw (Actor::OffloadException)
+ */
+Actor::OffloadToken OffloadExecutor::submit(Actor::OffloadTask &task)
+{
+    Lock<Mutex> lock(mutex);
+    if (counters.queueSize == queueSize)
+    {
+        ++counters.rejectCount;
+        throw Actor::OffloadException(true);
+    }
+    task.token = ++lastToken;
+    task.submitTime = HighResolutionTime()();
+    task.next = 0;
+    if (tailTask == 0)
+    {
+        headTask = tailTask = &task;
+    }
+    else
+    {
+        tailTask = tailTask->next = &task;
+    }
+    ++counters.submitCount;
+    if (++counters.queueSize > counters.queueHighWatermark)
+    {
+        counters.queueHighWatermark = counters.queueSize;
+    }
+    signal.notify();
+    return task.token;
+}
+
+Engine::OffloadCounters OffloadExecutor::getCounters() const noexcept
+{
+    Lock<Mutex> lock(mutex);
+    return counters;
+}
+
+Actor::OffloadTask *OffloadExecutor::pop() noexcept
+{
+    Actor::OffloadTask *ret = headTask;
+    if (ret != 0)
+    {
+        if ((headTask = ret->next) == 0)
+        {
+            tailTask = 0;
+        }
+        --counters.queueSize;
+    }
+    return ret;
+}
+
+void OffloadExecutor::complete(Actor::OffloadTask &task) noexcept
+{
+    NodeSlot &nodeSlot = nodeSlots[task.actorId.getNodeId()];
+    Lock<Mutex> lock(nodeSlot.mutex);
+    task.next = 0;
+    if (nodeSlot.tailTask == 0)
+    {
+        nodeSlot.headTask = nodeSlot.tailTask = &task;
+    }
+    else
+    {
+        nodeSlot.tailTask = nodeSlot.tailTask->next = &task;
+    }
+    nodeSlot.pendingFlag.store(true, std::memory_order_release);
+}
+
+/**
+ * Puts back a chain of executed tasks, not completed yet, ahead of the ones executed since.
+ */
+void OffloadExecutor::requeue(NodeSlot &nodeSlot, Actor::OffloadTask &task) noexcept
+{
+    Actor::OffloadTask *tailTask = &task;
+    for (; tailTask->next != 0; tailTask = tailTask->next)
+    {
+    }
+    Lock<Mutex> lock(nodeSlot.mutex);
+    tailTask->next = nodeSlot.headTask;
+    if (nodeSlot.headTask == 0)
+    {
+        nodeSlot.tailTask = tailTask;
+    }
+    nodeSlot.headTask = &task;
+    nodeSlot.pendingFlag.store(true, std::memory_order_release);
+}
+
+void OffloadExecutor::stop() noexcept
+{
+    {
+        Lock<Mutex> lock(mutex);
+        stopFlag = true;
+        signal.notify(); // each exiting thread notifies the next one
+    }
+    for (WorkerThreadVector::iterator i = workerThreads.begin(), endi = workerThreads.end(); i != endi; ++i)
+    {
+        (*i)->join();
+    }
+    workerThreads.clear();
+    // tasks still queued or not completed by an OffloadActor (destroyed core) are dropped
+    for (Actor::OffloadTask *task; (task = pop()) != 0;)
+    {
+        delete task;
+    }
+    for (size_t i = 0; i <= std::numeric_limits<Actor::NodeId>::max(); ++i)
+    {
+        for (Actor::OffloadTask *task = nodeSlots[i].headTask, *nextTask; task != 0; task = nextTask)
+        {
+            nextTask = task->next;
+            delete task;
+        }
+        nodeSlots[i].headTask = nodeSlots[i].tailTask = 0;
+    }
+}
+
+void OffloadExecutor::WorkerThread::onRun()
+{
+    for (;;)
+    {
+        Actor::OffloadTask *task;
+        Time startTime;
+        {
+            Lock<Mutex> lock(executor.mutex);
+            while (!executor.stopFlag && (task = executor.pop()) == 0)
+            {
+                executor.signal.wait();
+            }
+            if (executor.stopFlag)
+            {
+                executor.signal.notify();
+                break;
+            }
+            startTime = HighResolutionTime()();
+            executor.counters.queueWaitTime = executor.counters.queueWaitTime + (startTime - task->submitTime);
+        }
+        task->onExecute();
+        {
+            Time executeTime = HighResolutionTime()() - startTime;
+            Lock<Mutex> lock(executor.mutex);
+            ++executor.counters.executeCount;
+            executor.counters.executeTime = executor.counters.executeTime + executeTime;
+        }
+        executor.complete(*task);
+    }
+}
+
+OffloadActor::OffloadActor(OffloadExecutor *executor)
+    : nodeSlot(executor->nodeSlots[getActorId().getNodeId()]), inFlightCount(0)
+{
+    Lock<Mutex> lock(nodeSlot.mutex);
+    nodeSlot.offloadActor = this;
+}
+
+OffloadActor::~OffloadActor() noexcept
+{
+    Lock<Mutex> lock(nodeSlot.mutex);
+    nodeSlot.offloadActor = 0;
+}
+
+/**
+ * If a completion event cannot be pushed, the task and the ones following it stay queued, to be completed again
+ * at next callback, and the exception is reported to the engine exception handler
+ * (see AsyncExceptionHandler::onCallbackException()).
+ */
+void OffloadActor::onCallback() noexcept
+{
+    if (nodeSlot.pendingFlag.load(std::memory_order_acquire))
+    {
+        Actor::OffloadTask *task;
+        {
+            Lock<Mutex> lock(nodeSlot.mutex);
+            task = nodeSlot.headTask;
+            nodeSlot.headTask = nodeSlot.tailTask = 0;
+            nodeSlot.pendingFlag.store(false, std::memory_order_relaxed);
+        }
+        while (task != 0)
+        {
+            try
+            {
+                task->onComplete(*this);
+            }
+            catch (std::exception &e)
+            {
+                OffloadExecutor::requeue(nodeSlot, *task);
+                getAsyncNode()->getExceptionHandler().onCallbackExceptionSynchronous(this, typeid(*this), "onCallback",
+                                                                                     e.what());
+                break;
+            }
+            catch (...)
+            {
+                OffloadExecutor::requeue(nodeSlot, *task);
+                getAsyncNode()->getExceptionHandler().onCallbackExceptionSynchronous(this, typeid(*this), "onCallback",
+                                                                                     "unknown exception");
+                break;
+            }
+            Actor::OffloadTask *nextTask = task->next;
+            delete task;
+            --inFlightCount;
+            task = nextTask;
+        }
+    }
+    if (inFlightCount != 0)
+    {
+        registerPerformanceNeutralCallback(*this);
+    }
+    else
+    {
+        requestDestroy();
+    }
+}
+
+void OffloadActor::onDestroyRequest() noexcept
+{
+    if (inFlightCount == 0)
+    {
+        Actor::onDestroyRequest();
+    } // otherwise destruction is requested again once no task is in flight
+}
+
+} // namespace simplx
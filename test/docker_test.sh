@@ -12,10 +12,14 @@ compiler_set_3="8.2"
 [ "$compiler" == "3" ] && compiler_set="$compiler_set_3"
 [ "$compiler" == "" ] && compiler_set="$compiler_set_1"
 
+# compilers supporting C++20 coroutines (gcc >= 10), building the C++20-only tests (e.g. testcoroutine)
+[ "$cxx20_compiler_set" == "" ] && cxx20_compiler_set="12.2"
+
 [ "$dorelease" == "" ] && dorelease="1"
 [ "$dodebug" == "" ] && dodebug="1"
 
 [ "$dotestsimplx_core" == "" ] && dotestsimplx_core="1"
+[ "$dotestcxx20" == "" ] && dotestcxx20="1"
 [ "$dotestconnector" == "" ] && dotestconnector="1"
 [ "$dotutorials" == "" ] && dotutorials="1"
 
@@ -39,6 +43,14 @@ do
  [ "$dotutorials" == "1" ] && docker run -it -v $DIR/../:/simplx -u $(id -u):$(id -g) --rm volatilebitfield/cpp:$i bash -c " ! ( cd /simplx/tutorial && find ./ -maxdepth 1 -iname \"??_*\" -exec bash -c \"f={} && cd \\\$f && rm -rf build && mkdir build && cd build && cmake .. && make -j8\" \; ) && echo [DEADBEEF] FAILED [$i]" | tee $tmpfile ; grep "DEADBEEF" $tmpfile > /dev/null && exit
 
 done;
+
+# unitary tests simplx_core, C++20
+for i in $cxx20_compiler_set
+do
+ echo [simplx_core C++20] using [$i]
+ [ "$dotestcxx20" == "1" ] && docker run -it -v $DIR/../:/simplx -u $(id -u):$(id -g) --rm volatilebitfield/cpp:$i bash -c " ! ( rm -rf /simplx/test/simplx_core/build_cxx20 && mkdir /simplx/test/simplx_core/build_cxx20 && cd /simplx/test/simplx_core/build_cxx20/ &&  cmake $* -DCMAKE_CXX_FLAGS=\"-std=c++20 -Werror=mismatched-new-delete\" .. && make -j8 && make test ) && echo [DEADBEEF] FAILED [$i]" | tee $tmpfile ; grep "DEADBEEF" $tmpfile > /dev/null && exit
+done;
+
 rm -rf $tmpfile
 }
 
@@ -0,0 +1,120 @@
+/**
+ * @file benchactorpool.cpp
+ * @brief benchmark of per-connection actor churn, new/destroyed versus recycled by an ActorPool
+ * @copyright 2019 Scalewatch (www.scalewatch.com). All rights reserved.
+ * Please see accompanying LICENSE file for licensing terms.
+ */
+
+#include "gtest/gtest.h"
+
+#include <iomanip>
+#include <iostream>
+
+#include "simplx_core/engine.h"
+#include "pattern/actorpool.h"
+
+using namespace std;
+using namespace simplx;
+
+// anonymous namespace to prevent link error due to multiple functions with same name
+namespace
+{
+
+const size_t BENCH_CONNECTION_COUNT = 1024; // simultaneous connections
+const size_t BENCH_BATCH_COUNT = 200;
+
+template <int I> struct BenchEvent : Actor::Event
+{
+};
+
+/**
+ * Stands for a connection server process: registers 8 event-handlers and owns a 4KB buffer.
+ */
+struct ConnectionActor : Actor
+{
+    size_t bufferSize;
+    char buffer[4096];
+    ConnectionActor() : bufferSize(0)
+    {
+        registerEventHandler<BenchEvent<0>>(*this);
+        registerEventHandler<BenchEvent<1>>(*this);
+        registerEventHandler<BenchEvent<2>>(*this);
+        registerEventHandler<BenchEvent<3>>(*this);
+        registerEventHandler<BenchEvent<4>>(*this);
+        registerEventHandler<BenchEvent<5>>(*this);
+        registerEventHandler<BenchEvent<6>>(*this);
+        registerEventHandler<BenchEvent<7>>(*this);
+    }
+    template <int I> void onEvent(const BenchEvent<I> &) {}
+    void onRecycle() noexcept { bufferSize = 0; }
+};
+
+/**
+ * Opens then closes BENCH_CONNECTION_COUNT connections per event-loop iteration, and times all batches
+ * (including deferred actor destruction).
+ */
+struct ServerActor : Actor, Actor::Callback
+{
+    double &result; // ns per connection
+    volatile bool &doneFlag;
+    size_t batchCount;
+    Time startTime;
+    ActorPool<ConnectionActor> pool;
+    vector<ActorPool<ConnectionActor>::ActorReference> connections;
+    ServerActor(std::tuple<double *, volatile bool *, size_t> p)
+        : result(*std::get<0>(p)), doneFlag(*std::get<1>(p)), batchCount(0), pool(*this, std::get<2>(p))
+    {
+        pool.reserve(BENCH_CONNECTION_COUNT);
+        connections.reserve(BENCH_CONNECTION_COUNT);
+        registerCallback(*this);
+        startTime = HighResolutionTime()();
+    }
+    void onCallback() noexcept
+    {
+        if (batchCount == BENCH_BATCH_COUNT)
+        {
+            result = (double)(HighResolutionTime()() - startTime).toNanosecond() /
+                     (BENCH_BATCH_COUNT * BENCH_CONNECTION_COUNT);
+            memoryBarrier();
+            doneFlag = true;
+            return;
+        }
+        for (size_t i = 0; i < BENCH_CONNECTION_COUNT; ++i)
+        {
+            connections.push_back(pool.acquire());
+        }
+        for (size_t i = 0; i < BENCH_CONNECTION_COUNT; ++i)
+        {
+            pool.release(connections[i]);
+        }
+        connections.clear();
+        ++batchCount;
+        registerCallback(*this);
+    }
+};
+
+double benchConnections(size_t poolCapacity)
+{
+    double result = 0;
+    volatile bool doneFlag = false;
+    Engine::CoreSet coreSet;
+    coreSet.set(0);
+    Engine::StartSequence startSequence(coreSet);
+    startSequence.addActor<ServerActor>(0, std::make_tuple(&result, &doneFlag, poolCapacity));
+    Engine engine(startSequence);
+    for (; !doneFlag; threadSleep())
+    {
+    }
+    return result;
+}
+
+void benchActorPool()
+{
+    double newDestroyed = benchConnections(0);
+    double recycled = benchConnections(BENCH_CONNECTION_COUNT);
+    cout << "connection(ns/actor)  new-destroyed  recycled" << endl;
+    cout << setw(35) << fixed << setprecision(1) << newDestroyed << setw(10) << recycled << endl;
+}
+} // namespace
+
+TEST(ActorPool, benchConnections) { benchActorPool(); }
@@ -0,0 +1,183 @@
+/**
+ * @file benchcoroutine.cpp
+ * @brief benchmark of request/response round-trips, coroutines versus a hand-written state machine
+ * @copyright 2019 Scalewatch (www.scalewatch.com). All rights reserved.
+ * Please see accompanying LICENSE file for licensing terms.
+ */
+
+#include "gtest/gtest.h"
+
+#include <iomanip>
+#include <iostream>
+#include <map>
+
+#include "simplx_core/engine.h"
+#include "pattern/coroutine.h"
+
+using namespace std;
+using namespace simplx;
+using namespace simplx::coroutine;
+
+// anonymous namespace to prevent link error due to multiple functions with same name
+namespace
+{
+
+const int BENCH_SESSION_COUNT = 64;   // concurrent sessions
+const int BENCH_REQUEST_COUNT = 2000; // sequential requests per session
+
+struct BenchRequestEvent : RequestEvent
+{
+    const uint64_t value;
+    BenchRequestEvent(RequestId requestId, uint64_t pvalue) noexcept : RequestEvent(requestId), value(pvalue) {}
+};
+
+struct BenchResponseEvent : ResponseEvent
+{
+    const uint64_t value;
+    BenchResponseEvent(RequestId requestId, uint64_t pvalue) noexcept : ResponseEvent(requestId), value(pvalue) {}
+};
+
+struct BenchService : Service
+{
+};
+
+struct BenchServer : Actor
+{
+    BenchServer() { registerEventHandler<BenchRequestEvent>(*this); }
+    void onEvent(const BenchRequestEvent &event) { reply<BenchResponseEvent>(*this, event, event.value + 1); }
+};
+
+struct BenchResult
+{
+    double roundTrips; // per second
+    uint64_t checkSum;
+};
+
+/**
+ * Each session awaits BENCH_REQUEST_COUNT sequential requests from a coroutine.
+ */
+struct CoroutineClient : Requester
+{
+    BenchResult &result;
+    volatile bool &doneFlag;
+    int completionCount;
+    Time startTime;
+    CoroutineClient(std::pair<BenchResult *, volatile bool *> p)
+        : result(*p.first), doneFlag(*p.second), completionCount(0), startTime(HighResolutionTime()())
+    {
+        for (int i = 0; i < BENCH_SESSION_COUNT; ++i)
+        {
+            spawn(run());
+        }
+    }
+    Task run()
+    {
+        RequestPipe pipe(*this, getEngine().getServiceIndex().getServiceActorId<BenchService>());
+        uint64_t value = 0;
+        for (int i = 0; i < BENCH_REQUEST_COUNT; ++i)
+        {
+            value = (co_await pipe.request<BenchRequestEvent, BenchResponseEvent>(value)).value;
+        }
+        result.checkSum += value;
+        if (++completionCount == BENCH_SESSION_COUNT)
+        {
+            result.roundTrips = (double)BENCH_SESSION_COUNT * BENCH_REQUEST_COUNT * 1000000000 /
+                                (double)(HighResolutionTime()() - startTime).toNanosecond();
+            memoryBarrier();
+            doneFlag = true;
+        }
+    }
+};
+
+/**
+ * Same sessions, with the session state looked up by request-id in the response event-handler.
+ */
+struct StateMachineClient : Actor
+{
+    struct Session
+    {
+        uint64_t value;
+        int requestCount;
+    };
+    typedef std::map<RequestId, Session> SessionMap;
+
+    BenchResult &result;
+    volatile bool &doneFlag;
+    Event::Pipe pipe;
+    RequestId lastRequestId;
+    SessionMap sessionMap;
+    int completionCount;
+    Time startTime;
+    StateMachineClient(std::pair<BenchResult *, volatile bool *> p)
+        : result(*p.first), doneFlag(*p.second),
+          pipe(*this, getEngine().getServiceIndex().getServiceActorId<BenchService>()), lastRequestId(0),
+          completionCount(0), startTime(HighResolutionTime()())
+    {
+        registerEventHandler<BenchResponseEvent>(*this);
+        for (int i = 0; i < BENCH_SESSION_COUNT; ++i)
+        {
+            Session session = {0, 0};
+            request(session);
+        }
+    }
+    void request(const Session &session)
+    {
+        sessionMap[++lastRequestId] = session;
+        pipe.push<BenchRequestEvent>(lastRequestId, session.value);
+    }
+    void onEvent(const BenchResponseEvent &event)
+    {
+        SessionMap::iterator i = sessionMap.find(event.requestId);
+        ASSERT_TRUE(i != sessionMap.end());
+        Session session = {event.value, i->second.requestCount + 1};
+        sessionMap.erase(i);
+        if (session.requestCount < BENCH_REQUEST_COUNT)
+        {
+            request(session);
+            return;
+        }
+        result.checkSum += session.value;
+        if (++completionCount == BENCH_SESSION_COUNT)
+        {
+            result.roundTrips = (double)BENCH_SESSION_COUNT * BENCH_REQUEST_COUNT * 1000000000 /
+                                (double)(HighResolutionTime()() - startTime).toNanosecond();
+            memoryBarrier();
+            doneFlag = true;
+        }
+    }
+};
+
+/**
+ * Client on core 0, server on core 1.
+ */
+template <class _Client> BenchResult benchCoroutine()
+{
+    BenchResult result = {0, 0};
+    volatile bool doneFlag = false;
+    Engine::CoreSet coreSet;
+    coreSet.set(0);
+    coreSet.set(1);
+    Engine::StartSequence startSequence(coreSet);
+    startSequence.addServiceActor<BenchService, BenchServer>(1);
+    startSequence.addActor<_Client>(0, std::make_pair(&result, &doneFlag));
+    Engine engine(startSequence);
+    for (; !doneFlag; threadSleep())
+    {
+    }
+    return result;
+}
+
+void benchCoroutine()
+{
+    BenchResult stateMachine = benchCoroutine<StateMachineClient>();
+    BenchResult coroutine = benchCoroutine<CoroutineClient>();
+    EXPECT_EQ((uint64_t)BENCH_SESSION_COUNT * BENCH_REQUEST_COUNT, stateMachine.checkSum);
+    EXPECT_EQ(stateMachine.checkSum, coroutine.checkSum);
+    cout << "session-count " << BENCH_SESSION_COUNT << " request-count " << BENCH_REQUEST_COUNT << endl;
+    cout << "round-trips(/s)  state-machine  coroutine" << endl;
+    cout << setw(31) << fixed << setprecision(0) << stateMachine.roundTrips << setw(11) << coroutine.roundTrips
+         << endl;
+}
+} // namespace
+
+TEST(Coroutine, benchRoundTrips) { benchCoroutine(); }
@@ -0,0 +1,179 @@
+/**
+ * @file benchparallel.cpp
+ * @brief benchmark of parallel node synchronization latency versus node count
+ * @copyright 2019 Scalewatch (www.scalewatch.com). All rights reserved.
+ * Please see accompanying LICENSE file for licensing terms.
+ */
+
+#include "gtest/gtest.h"
+
+#include <iomanip>
+#include <iostream>
+
+#include "simplx_core/internal/cacheline.h"
+#include "simplx_core/internal/parallel.h"
+
+using namespace std;
+
+// anonymous namespace to prevent link error due to multiple functions with same name
+namespace
+{
+
+const size_t BENCH_LOOP_COUNT = 20000;
+
+/**
+ * Single reader node (id 0), with every peer writer on its own cache line.
+ * Peer writers are simulated by the benchmark loop, which write-locks and rings
+ * the doorbell of activeWriterCount peers before each synchronization.
+ * When _ScanAllPeers is true, foreachPendingRead() ignores the doorbell and polls
+ * every peer, as node synchronization did before the doorbell was introduced.
+ */
+template <bool _ScanAllPeers> struct BenchNodesHandle
+{
+    static const int MAX_SIZE = 255;
+    typedef unsigned char NodeId;
+    typedef simplx::NodeBitSet<MAX_SIZE> Doorbell;
+
+    struct Shared
+    {
+    };
+
+    struct SharedHandle
+    {
+        bool isWriteLocked;
+        bool isReaderActive;
+        sig_atomic_t readerCAS;
+        bool isWriterActive;
+        Shared shared;
+        SharedHandle() : isWriteLocked(false), isReaderActive(false), readerCAS(0), isWriterActive(false) {}
+        bool read() { return true; }
+        bool write() { return true; }
+        void writeFailed() {}
+        bool getIsWriterActive() { return isWriterActive; }
+        void setIsWriterActive(bool pisWriterActive) { isWriterActive = pisWriterActive; }
+        bool getIsReaderActive() { return isReaderActive; }
+        void setIsReaderActive(bool pisReaderActive) { isReaderActive = pisReaderActive; }
+        sig_atomic_t &getReferenceToReaderCAS() { return readerCAS; }
+        bool getIsWriteLocked() { return isWriteLocked; }
+        void setIsWriteLocked(bool pisWriteLocked) { isWriteLocked = pisWriteLocked; }
+        void ringReaderDoorbell(NodeId) {} // the benchmarked node never writes
+        Shared &getReferenceToShared() { return shared; }
+    };
+
+    typedef SharedHandle ReaderSharedHandle;
+    typedef SharedHandle WriterSharedHandle;
+
+    struct NodeHandle
+    {
+        Doorbell doorbell;
+        simplx::CacheLineAlignedArray<SharedHandle> readerSharedHandles;
+        simplx::CacheLineAlignedArray<SharedHandle> writerSharedHandles;
+        bool isActive;
+#ifndef NDEBUG
+        bool debugSynchronizeWriteFailedOperatorCalled;
+#endif
+        NodeHandle(size_t size) : readerSharedHandles(size), writerSharedHandles(size), isActive(false) {}
+        ReaderSharedHandle &getReaderSharedHandle(NodeId writerNodeId) { return readerSharedHandles[writerNodeId]; }
+        WriterSharedHandle &getWriterSharedHandle(NodeId readerNodeId) { return writerSharedHandles[readerNodeId]; }
+        template <class _Operator> void foreachRead(NodeId readerNodeId, _Operator &op)
+        {
+            for (size_t i = 0, sz = readerSharedHandles.size(); i < sz; ++i)
+            {
+                if (i != readerNodeId)
+                {
+                    op(readerSharedHandles[i], (NodeId)i);
+                }
+            }
+        }
+        template <class _Operator> void foreachWrite(NodeId writerNodeId, _Operator &op)
+        {
+            for (size_t i = 0, sz = writerSharedHandles.size(); i < sz; ++i)
+            {
+                if (i != writerNodeId)
+                {
+                    op(writerSharedHandles[i], (NodeId)i);
+                }
+            }
+        }
+        template <class _Operator> void foreachPendingRead(NodeId readerNodeId, _Operator &op)
+        {
+            if (_ScanAllPeers)
+            {
+                foreachRead(readerNodeId, op);
+                return;
+            }
+            for (size_t w = 0, endw = Doorbell::wordCount(readerSharedHandles.size()); w < endw; ++w)
+            {
+                for (Doorbell::word_type bits = doorbell.atomicFetchAndResetWord(w); bits != 0; bits &= bits - 1)
+                {
+                    size_t i = Doorbell::index(w, bits);
+                    op(readerSharedHandles[i], (NodeId)i);
+                }
+            }
+        }
+    };
+
+    const size_t size;
+    NodeHandle nodeHandle;
+
+    BenchNodesHandle(size_t psize) : size(psize), nodeHandle(psize) {}
+    NodeHandle &getNodeHandle(NodeId) { return nodeHandle; }
+    bool isNodeActive(NodeId) { return nodeHandle.isActive; }
+    bool activateNode(NodeId) { return nodeHandle.isActive ? false : (nodeHandle.isActive = true); }
+    void deactivateNode(NodeId) { nodeHandle.isActive = false; }
+};
+
+template <bool _ScanAllPeers> struct BenchParallel : simplx::Parallel<BenchNodesHandle<_ScanAllPeers> >
+{
+    BenchParallel(size_t size) : simplx::Parallel<BenchNodesHandle<_ScanAllPeers> >(size) {}
+    typename BenchNodesHandle<_ScanAllPeers>::NodeHandle &getNodeHandle()
+    {
+        return this->nodesHandle.getNodeHandle(0);
+    }
+};
+
+/**
+ * @return average synchronize() latency in nanoseconds
+ */
+template <bool _ScanAllPeers> double benchSynchronize(size_t nodeCount, size_t activeWriterCount)
+{
+    typedef BenchNodesHandle<_ScanAllPeers> NodesHandle;
+    BenchParallel<_ScanAllPeers> parallel(nodeCount);
+    typename BenchParallel<_ScanAllPeers>::Node node(parallel, 0);
+    typename NodesHandle::NodeHandle &nodeHandle = parallel.getNodeHandle();
+
+    simplx::Time start = simplx::HighResolutionTime()();
+    for (size_t i = 0; i < BENCH_LOOP_COUNT; ++i)
+    {
+        for (size_t j = 1; j <= activeWriterCount; ++j)
+        {
+            nodeHandle.getReaderSharedHandle((typename NodesHandle::NodeId)j).setIsWriteLocked(true);
+            nodeHandle.doorbell.atomicSet(j);
+        }
+        node.synchronize();
+    }
+    simplx::Time end = simplx::HighResolutionTime()();
+    for (size_t j = 1; j < nodeCount; ++j)
+    {
+        EXPECT_FALSE(nodeHandle.getReaderSharedHandle((typename NodesHandle::NodeId)j).getIsWriteLocked());
+    }
+    return (double)(end - start).toNanosecond() / BENCH_LOOP_COUNT;
+}
+
+void benchSynchronize()
+{
+    const size_t nodeCounts[] = {2, 4, 8, 16, 32, 64, 128, 255};
+    const size_t activeWriterCount = 1;
+    cout << "node-count  scan-all-peers(ns/loop)  doorbell(ns/loop)  [" << activeWriterCount << " active writer]"
+         << endl;
+    for (size_t i = 0; i < sizeof(nodeCounts) / sizeof(nodeCounts[0]); ++i)
+    {
+        double scanLatency = benchSynchronize<true>(nodeCounts[i], activeWriterCount);
+        double doorbellLatency = benchSynchronize<false>(nodeCounts[i], activeWriterCount);
+        cout << setw(10) << nodeCounts[i] << setw(25) << fixed << setprecision(1) << scanLatency << setw(19)
+             << doorbellLatency << endl;
+    }
+}
+}
+
+TEST(Parallel, benchSynchronize) { benchSynchronize(); }
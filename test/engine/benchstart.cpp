@@ -0,0 +1,73 @@
+/**
+ * @file benchstart.cpp
+ * @brief benchmark of engine time-to-ready versus start-sequence size, sequential versus parallel start
+ * @copyright 2019 Scalewatch (www.scalewatch.com). All rights reserved.
+ * Please see accompanying LICENSE file for licensing terms.
+ */
+
+#include "gtest/gtest.h"
+
+#include <iomanip>
+#include <iostream>
+
+#include "simplx_core/engine.h"
+
+using namespace std;
+using namespace simplx;
+
+// anonymous namespace to prevent link error due to multiple functions with same name
+namespace
+{
+
+const size_t BENCH_SERVICE_PERIOD = 1000; // one service actor every 1000 actors
+
+/**
+ * Touches 16KB of per-core allocated state at construction.
+ */
+struct StartActor : Actor
+{
+    std::vector<char, Allocator<char>> state;
+    StartActor() : state(16 * 1024, '\0', getAllocator()) {}
+};
+
+double benchStart(size_t actorCount, bool parallelStartFlag)
+{
+    Engine::CoreSet coreSet;
+    for (size_t i = 0, coreCount = cpuGetCount(); i < coreCount; ++i)
+    {
+        coreSet.set((Engine::CoreId)i);
+    }
+    Engine::StartSequence startSequence(coreSet);
+    startSequence.setParallelStartFlag(parallelStartFlag);
+    for (size_t i = 0; i < actorCount; ++i)
+    {
+        Engine::CoreId coreId = coreSet.at((Engine::CoreSet::NodeId)(i % coreSet.size()));
+        if (i % BENCH_SERVICE_PERIOD == 0)
+        {
+            startSequence.addServiceActor<Engine::StartSequence::AnonymousService, StartActor>(coreId);
+        }
+        else
+        {
+            startSequence.addActor<StartActor>(coreId);
+        }
+    }
+    Time start = HighResolutionTime()();
+    Engine engine(startSequence);
+    return (double)(HighResolutionTime()() - start).toNanosecond() / 1000000;
+}
+
+void benchStart()
+{
+    cout << "core-count " << cpuGetCount() << endl;
+    cout << "actor-count  time-to-ready(ms)  sequential  parallel" << endl;
+    for (size_t actorCount = 1000; actorCount <= 100000; actorCount *= 10)
+    {
+        double sequential = benchStart(actorCount, false);
+        double parallel = benchStart(actorCount, true);
+        cout << setw(11) << actorCount << setw(31) << fixed << setprecision(1) << sequential << setw(10) << parallel
+             << endl;
+    }
+}
+} // namespace
+
+TEST(Start, benchTimeToReady) { benchStart(); }
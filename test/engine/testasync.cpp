@@ -849,6 +849,320 @@ void testNoDestinationPipe()
     ASSERT_EQ(1u, counter);
 }
 
+struct TestPushForwarding : simplx::Actor
+{
+    struct MoveOnlyPayload
+    {
+        unsigned value;
+        MoveOnlyPayload(unsigned pvalue) : value(pvalue) {}
+        MoveOnlyPayload(MoveOnlyPayload &&other) : value(other.value) { other.value = 0; }
+        MoveOnlyPayload(const MoveOnlyPayload &) = delete;
+    };
+    struct CopyCountedPayload
+    {
+        static unsigned copyCount;
+        CopyCountedPayload() {}
+        CopyCountedPayload(CopyCountedPayload &&) {}
+        CopyCountedPayload(const CopyCountedPayload &) { ++copyCount; }
+    };
+    struct PayloadEvent : Event
+    {
+        const MoveOnlyPayload moveOnly;
+        const CopyCountedPayload copyCounted;
+        PayloadEvent(MoveOnlyPayload &&pmoveOnly, CopyCountedPayload pcopyCounted)
+            : moveOnly(std::move(pmoveOnly)), copyCounted(std::move(pcopyCounted))
+        {
+        }
+    };
+    unsigned eventCount;
+    unsigned valueSum;
+    TestPushForwarding() : eventCount(0), valueSum(0) { registerEventHandler<PayloadEvent>(*this); }
+    void onEvent(const PayloadEvent &event)
+    {
+        ++eventCount;
+        valueSum += event.moveOnly.value;
+    }
+};
+
+unsigned TestPushForwarding::CopyCountedPayload::copyCount = 0;
+
+void testPushForwarding()
+{
+    simplx::EngineCustomEventLoopFactory customEventLoopFactory;
+    simplx::AsyncNodeManager nodeManager(1024, TestCoreSet());
+    simplx::AsyncNode node(simplx::AsyncNode::Init(nodeManager, 0, customEventLoopFactory));
+    {
+        TestPushForwarding &handler = node.newActor<TestPushForwarding>();
+        simplx::Actor::Event::Pipe pipe(handler, handler.getActorId());
+        pipe.push<TestPushForwarding::PayloadEvent>(TestPushForwarding::MoveOnlyPayload(1),
+                                                    TestPushForwarding::CopyCountedPayload());
+        ASSERT_NE((void *)0, pipe.tryPush<TestPushForwarding::PayloadEvent>(
+                                 TestPushForwarding::MoveOnlyPayload(2), TestPushForwarding::CopyCountedPayload()));
+        ASSERT_EQ(0u, TestPushForwarding::CopyCountedPayload::copyCount);
+        simplx::Actor::Event::BufferedPipe bufferedPipe(handler, handler.getActorId());
+        TestPushForwarding::MoveOnlyPayload moveOnly(3);
+        const TestPushForwarding::CopyCountedPayload copyCounted;
+        bufferedPipe.push<TestPushForwarding::PayloadEvent>(std::move(moveOnly), copyCounted);
+        ASSERT_EQ(0u, moveOnly.value);
+        ASSERT_EQ(1u, TestPushForwarding::CopyCountedPayload::copyCount); // lvalue
+        bufferedPipe.flush();
+        node.synchronize();
+        ASSERT_EQ(3u, handler.eventCount);
+        ASSERT_EQ(6u, handler.valueSum);
+    }
+    TestEventLoop testEventLoop(node);
+}
+
+struct TestPushVar : simplx::Actor
+{
+    struct StringEvent : Event, Event::VarPayload<char>
+    {
+        const unsigned key;
+        StringEvent(unsigned pkey) noexcept : key(pkey) {}
+    };
+    struct ArrayEvent : Event, Event::VarPayload<uint64_t>
+    {
+    };
+    unsigned eventCount;
+    uint64_t valueSum;
+    std::string keyValues;
+    TestPushVar() : eventCount(0), valueSum(0)
+    {
+        registerEventHandler<StringEvent>(*this);
+        registerEventHandler<ArrayEvent>(*this);
+    }
+    void onEvent(const StringEvent &event)
+    {
+        ++eventCount;
+        keyValues += std::to_string(event.key) + '=' + std::string(event.begin(), event.end()) + ';';
+    }
+    void onEvent(const ArrayEvent &event)
+    {
+        ++eventCount;
+        ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(event.data()) % alignof(uint64_t));
+        for (uint64_t value : event)
+        {
+            valueSum += value;
+        }
+    }
+};
+
+void testPushVar()
+{
+    simplx::EngineCustomEventLoopFactory customEventLoopFactory;
+    simplx::AsyncNodeManager nodeManager(1024, TestCoreSet());
+    simplx::AsyncNode node(simplx::AsyncNode::Init(nodeManager, 0, customEventLoopFactory));
+    {
+        TestPushVar &handler = node.newActor<TestPushVar>();
+        simplx::Actor::Event::Pipe pipe(handler, handler.getActorId());
+        for (unsigned i = 0; i < 8; ++i)
+        { // odd-sized string events to misalign the next events in the event-page
+            std::string value(i, 'a' + i);
+            TestPushVar::StringEvent &event = pipe.pushVar<TestPushVar::StringEvent>(value.size(), i);
+            ASSERT_EQ(value.size(), event.size());
+            if (i != 0)
+            { // payload follows the event
+                ASSERT_LT((const void *)&event, (const void *)event.data());
+            }
+            std::memcpy(event.data(), value.data(), value.size());
+            TestPushVar::ArrayEvent &arrayEvent = pipe.pushVar<TestPushVar::ArrayEvent>(i + 1);
+            ASSERT_EQ(i + 1, arrayEvent.size());
+            std::fill(arrayEvent.begin(), arrayEvent.end(), (uint64_t)i);
+        }
+        ASSERT_THROW(pipe.pushVar<TestPushVar::ArrayEvent>(std::numeric_limits<size_t>::max()), std::bad_alloc);
+        node.synchronize();
+        ASSERT_EQ(16u, handler.eventCount);
+        ASSERT_EQ(0 + 2 + 6 + 12 + 20 + 30 + 42 + 56u, handler.valueSum);
+        ASSERT_EQ("0=;1=b;2=cc;3=ddd;4=eeee;5=fffff;6=gggggg;7=hhhhhhh;", handler.keyValues);
+    }
+    TestEventLoop testEventLoop(node);
+}
+
+struct TestDirectDelivery : simplx::Actor
+{
+    struct RelayEvent : Event
+    {
+    };
+    unsigned eventCount;
+    unsigned undeliveredEventCount;
+    bool returnToSenderFlag;
+    bool relayFlag;
+    Event::Pipe pipe;
+    TestDirectDelivery()
+        : eventCount(0), undeliveredEventCount(0), returnToSenderFlag(false), relayFlag(false), pipe(*this)
+    {
+        pipe.setDirectDeliveryFlag(true);
+        registerEventHandler<RelayEvent>(*this);
+        registerUndeliveredEventHandler<RelayEvent>(*this);
+    }
+    void relayTo(const TestDirectDelivery &next)
+    {
+        pipe.setDestinationActorId(next.getActorId());
+        relayFlag = true;
+    }
+    void onEvent(const RelayEvent &)
+    {
+        if (returnToSenderFlag)
+        {
+            throw ReturnToSenderException();
+        }
+        ++eventCount;
+        if (relayFlag)
+        {
+            pipe.push<RelayEvent>();
+        }
+    }
+    void onUndeliveredEvent(const RelayEvent &) { ++undeliveredEventCount; }
+};
+
+void testDirectDelivery()
+{
+    simplx::EngineCustomEventLoopFactory customEventLoopFactory;
+    simplx::AsyncNodeManager nodeManager(1024, TestCoreSet());
+    simplx::EnginePolicy policy;
+    policy.eventDirectDeliveryPolicy = simplx::EngineEventDirectDeliveryPolicy(2);
+    simplx::AsyncNode node(simplx::AsyncNode::Init(nodeManager, 0, customEventLoopFactory, policy));
+    {
+        TestDirectDelivery &a = node.newActor<TestDirectDelivery>();
+        TestDirectDelivery &b = node.newActor<TestDirectDelivery>();
+        TestDirectDelivery &c = node.newActor<TestDirectDelivery>();
+        TestDirectDelivery &d = node.newActor<TestDirectDelivery>();
+        a.relayTo(b);
+        b.relayTo(c);
+        c.relayTo(d);
+        ASSERT_TRUE(a.pipe.isDirectDelivery());
+        // a -> b and b -> c delivered from within the push, c -> d exceeds the depth limit and is queued
+        a.pipe.push<TestDirectDelivery::RelayEvent>();
+        ASSERT_EQ(1u, b.eventCount);
+        ASSERT_EQ(1u, c.eventCount);
+        ASSERT_EQ(0u, d.eventCount);
+        node.synchronize();
+        ASSERT_EQ(1u, d.eventCount);
+        // returned to sender from within the push
+        b.returnToSenderFlag = true;
+        a.pipe.push<TestDirectDelivery::RelayEvent>();
+        ASSERT_EQ(1u, a.undeliveredEventCount);
+        b.returnToSenderFlag = false;
+        // buffered pipes are always queued
+        simplx::Actor::Event::BufferedPipe bufferedPipe(a.pipe);
+        ASSERT_FALSE(bufferedPipe.isDirectDelivery());
+        bufferedPipe.push<TestDirectDelivery::RelayEvent>();
+        bufferedPipe.flush();
+        ASSERT_EQ(1u, b.eventCount);
+        node.synchronize();
+        ASSERT_EQ(2u, b.eventCount);
+        ASSERT_EQ(2u, c.eventCount);
+        ASSERT_EQ(2u, d.eventCount);
+        ASSERT_TRUE(a.pipe.isDirectDelivery());
+    }
+    TestEventLoop testEventLoop(node);
+}
+
+struct TestEventGrouping : simplx::Actor
+{
+    struct SeqEvent : Event
+    {
+        const unsigned seq;
+        SeqEvent(unsigned pseq) noexcept : seq(pseq) {}
+    };
+    std::vector<unsigned> &log;
+    TestEventGrouping(std::vector<unsigned> &plog) : log(plog) { registerEventHandler<SeqEvent>(*this); }
+    void onEvent(const SeqEvent &event) { log.push_back(event.seq); }
+};
+
+void testEventGrouping()
+{
+    simplx::EngineCustomEventLoopFactory customEventLoopFactory;
+    simplx::AsyncNodeManager nodeManager(1024, TestCoreSet());
+    simplx::EnginePolicy policy;
+    policy.eventGroupingPolicy = simplx::EngineEventGroupingPolicy(4);
+    simplx::AsyncNode node(simplx::AsyncNode::Init(nodeManager, 0, customEventLoopFactory, policy));
+    {
+        std::vector<unsigned> log;
+        TestEventGrouping &source = node.newActor<TestEventGrouping>(std::ref(log));
+        TestEventGrouping *destinations[3];
+        for (TestEventGrouping *&destination : destinations)
+        {
+            destination = &node.newActor<TestEventGrouping>(std::ref(log));
+        }
+        simplx::Actor::Event::Pipe pipe(source);
+        for (unsigned i = 0; i < 9; ++i)
+        {
+            pipe.setDestinationActorId(destinations[i % 3]->getActorId());
+            pipe.push<TestEventGrouping::SeqEvent>(i);
+        }
+        node.synchronize();
+        // grouped by destination, in the order of their first event, each in arrival order
+        ASSERT_EQ((std::vector<unsigned>{0, 3, 6, 1, 4, 7, 2, 5, 8}), log);
+        log.clear();
+        for (unsigned i = 0; i < 3; ++i)
+        { // below EngineEventGroupingPolicy::minEventCount: arrival order
+            pipe.setDestinationActorId(destinations[i % 2]->getActorId());
+            pipe.push<TestEventGrouping::SeqEvent>(i);
+        }
+        node.synchronize();
+        ASSERT_EQ((std::vector<unsigned>{0, 1, 2}), log);
+        log.clear();
+        simplx::Actor::Event::MulticastPipe multicastPipe(source);
+        for (TestEventGrouping *destination : destinations)
+        {
+            multicastPipe.addDestinationActorId(destination->getActorId());
+        }
+        const unsigned sequence[] = {0, 1, 0, 0, 1, 0, 1};
+        for (unsigned i = 0; i < 7; ++i)
+        { // multicast events are not moved
+            if (i == 3)
+            {
+                multicastPipe.push<TestEventGrouping::SeqEvent>(i);
+            }
+            else
+            {
+                pipe.setDestinationActorId(destinations[sequence[i]]->getActorId());
+                pipe.push<TestEventGrouping::SeqEvent>(i);
+            }
+        }
+        node.synchronize();
+        ASSERT_EQ((std::vector<unsigned>{0, 2, 1, 3, 3, 3, 4, 6, 5}), log);
+    }
+    TestEventLoop testEventLoop(node);
+}
+
+void testEventPrefetch()
+{
+    simplx::EngineCustomEventLoopFactory customEventLoopFactory;
+    simplx::AsyncNodeManager nodeManager(1024, TestCoreSet());
+    simplx::EnginePolicy policy;
+    policy.eventDeliveryBudgetPolicy = simplx::EngineEventDeliveryBudgetPolicy(5);
+    policy.eventPrefetchPolicy = simplx::EngineEventPrefetchPolicy(8);
+    simplx::AsyncNode node(simplx::AsyncNode::Init(nodeManager, 0, customEventLoopFactory, policy));
+    {
+        std::vector<unsigned> log;
+        TestEventGrouping &source = node.newActor<TestEventGrouping>(std::ref(log));
+        TestEventGrouping *destinations[3];
+        for (TestEventGrouping *&destination : destinations)
+        {
+            destination = &node.newActor<TestEventGrouping>(std::ref(log));
+        }
+        simplx::Actor::Event::Pipe pipe(source);
+        for (unsigned i = 0; i < 12; ++i)
+        {
+            pipe.setDestinationActorId(destinations[i % 3]->getActorId());
+            pipe.push<TestEventGrouping::SeqEvent>(i);
+        }
+        // prefetch runs ahead of the delivery budget, and past the end of the batch
+        for (size_t deliveredEventCount : {5, 10, 12})
+        {
+            node.synchronize();
+            ASSERT_EQ(deliveredEventCount, log.size());
+        }
+        for (unsigned i = 0; i < 12; ++i)
+        {
+            ASSERT_EQ(i, log[i]);
+        }
+    }
+    TestEventLoop testEventLoop(node);
+}
+
 TEST(Async, init) { testInit(); }
 TEST(Async, initRegisterEventHandler) { testInitRegisterEventHandler(); }
 TEST(Async, uniNodeEvent) { testUniNodeEvent(); }
@@ -857,3 +1171,8 @@ TEST(Async, actorReference) { testActorReference(); }
 TEST(Async, DISABLED_staticActorReference) { testStaticActorCircularReference(); }      // disabled because release doesn't check circular references
 TEST(Async, onEventException) { testOnEventException(); }
 TEST(Async, noDestinationPipe) { testNoDestinationPipe(); }
+TEST(Async, pushForwarding) { testPushForwarding(); }
+TEST(Async, pushVar) { testPushVar(); }
+TEST(Async, directDelivery) { testDirectDelivery(); }
+TEST(Async, eventGrouping) { testEventGrouping(); }
+TEST(Async, eventPrefetch) { testEventPrefetch(); }
@@ -372,6 +372,1178 @@ void testAnonymousService()
     Engine engine(startSequence);
 }
 
+struct TestIdlePolicy
+{
+    struct PingEvent : Actor::Event
+    {
+    };
+    struct PongEvent : Actor::Event
+    {
+        const uint64_t idleParkCount;
+        PongEvent(uint64_t pidleParkCount) : idleParkCount(pidleParkCount) {}
+    };
+    struct Shared
+    {
+        Actor::ActorId pongActorId;
+        volatile bool doneFlag;
+        uint64_t idleParkCount;
+        Shared() : doneFlag(false), idleParkCount(0) {}
+    };
+    struct PongActor : Actor
+    {
+        PongActor(Shared *shared)
+        {
+            shared->pongActorId = getActorId();
+            registerEventHandler<PingEvent>(*this);
+        }
+        void onEvent(const PingEvent &event)
+        {
+            Event::Pipe(*this, event.getSourceActorId()).push<PongEvent>(getCorePerformanceCounters().getIdleParkCount());
+        }
+    };
+    /**
+     * Keeps its own core busy, while leaving the pong core idle long enough to be parked before each ping.
+     */
+    struct PingActor : Actor, Actor::Callback
+    {
+        static const unsigned PING_COUNT = 3;
+        Shared &shared;
+        unsigned pongCount;
+        Time pingTime;
+        PingActor(Shared *pshared) : shared(*pshared), pongCount(0)
+        {
+            registerEventHandler<PongEvent>(*this);
+            schedulePing();
+        }
+        void schedulePing()
+        {
+            pingTime = HighResolutionTime()() + Time::Millisecond(20);
+            registerCallback(*this);
+        }
+        void onCallback() noexcept
+        {
+            if (HighResolutionTime()() < pingTime)
+            {
+                registerCallback(*this);
+            }
+            else
+            {
+                Event::Pipe(*this, shared.pongActorId).push<PingEvent>();
+            }
+        }
+        void onEvent(const PongEvent &event)
+        {
+            shared.idleParkCount = event.idleParkCount;
+            if (++pongCount < PING_COUNT)
+            {
+                schedulePing();
+            }
+            else
+            {
+                memoryBarrier();
+                shared.doneFlag = true;
+            }
+        }
+    };
+};
+
+void testIdlePolicy()
+{
+    // park time-out is longer than the test deadline: pong core must be woken-up by ping writes and engine shutdown
+    const Time deadline = HighResolutionTime()() + Time::Second(5);
+    TestIdlePolicy::Shared shared;
+    {
+        TestStartSequence startSequence;
+        startSequence.setIdlePolicy(EngineIdlePolicy(100, 100, Time::Second(10)));
+        ASSERT_EQ(100u, startSequence.getIdlePolicy().spinLoopCount);
+        ASSERT_FALSE(startSequence.getIdlePolicy().isSpinning());
+        startSequence.addActor<TestIdlePolicy::PongActor>(1, &shared);
+        startSequence.addActor<TestIdlePolicy::PingActor>(0, &shared);
+        Engine engine(startSequence);
+        for (; !shared.doneFlag && HighResolutionTime()() < deadline; threadSleep())
+        {
+        }
+    }
+    ASSERT_TRUE(shared.doneFlag);
+    ASSERT_LT(0u, shared.idleParkCount);
+    ASSERT_LT(HighResolutionTime()(), deadline);
+    ASSERT_TRUE(EngineIdlePolicy().isSpinning());
+}
+
+void testNumaPlacement()
+{
+    TestStartSequence startSequence;
+    startSequence.addActor<Actor>(0);
+    startSequence.addActor<Actor>(1);
+    Engine engine(startSequence);
+    for (Engine::CoreId writerCoreId = 0; writerCoreId < 2; ++writerCoreId)
+    {
+        Engine::NumaPlacement numaPlacement = engine.getNumaPlacement(writerCoreId, 1 - writerCoreId);
+        ASSERT_EQ(cpuGetNumaNode(writerCoreId), numaPlacement.writerCoreNumaNode);
+        ASSERT_EQ(cpuGetNumaNode(1 - writerCoreId), numaPlacement.readerCoreNumaNode);
+        ASSERT_LE(2u, numaPlacement.eventPageCount);
+        ASSERT_GE(numaPlacement.eventPageCount, numaPlacement.writerEventPageCount);
+        if (numaPlacement.writerCoreNumaNode != -1 && numaPlacement.writerSharedNumaNode != -1)
+        {
+            ASSERT_EQ(numaPlacement.writerCoreNumaNode, numaPlacement.writerSharedNumaNode);
+            ASSERT_EQ(numaPlacement.eventPageCount, numaPlacement.writerEventPageCount);
+        }
+        if (numaPlacement.readerCoreNumaNode != -1 && numaPlacement.readerSharedNumaNode != -1)
+        {
+            ASSERT_EQ(numaPlacement.readerCoreNumaNode, numaPlacement.readerSharedNumaNode);
+        }
+    }
+    ASSERT_THROW(engine.getNumaPlacement(0, (Engine::CoreId)Actor::MAX_NODE_COUNT),
+                 Engine::CoreSet::UndefinedCoreException);
+}
+
+struct TestEventAllocatorHugePage
+{
+    struct PayloadEvent : Actor::Event
+    {
+        char payload[400];
+    };
+    struct Shared
+    {
+        Actor::ActorId receiverActorId;
+        volatile bool doneFlag;
+        Shared() : doneFlag(false) {}
+    };
+    static const unsigned EVENT_COUNT = 1000;
+    struct ReceiverActor : Actor
+    {
+        Shared &shared;
+        unsigned eventCount;
+        ReceiverActor(Shared *pshared) : shared(*pshared), eventCount(0)
+        {
+            shared.receiverActorId = getActorId();
+            registerEventHandler<PayloadEvent>(*this);
+        }
+        void onEvent(const PayloadEvent &)
+        {
+            if (++eventCount == EVENT_COUNT)
+            {
+                memoryBarrier();
+                shared.doneFlag = true;
+            }
+        }
+    };
+    /**
+     * Pushes events by bursts spanning several event pages.
+     */
+    struct SenderActor : Actor, Actor::Callback
+    {
+        Shared &shared;
+        unsigned eventCount;
+        SenderActor(Shared *pshared) : shared(*pshared), eventCount(0) { registerCallback(*this); }
+        void onCallback() noexcept
+        {
+            Event::Pipe pipe(*this, shared.receiverActorId);
+            for (unsigned i = 0; i < 50 && eventCount < EVENT_COUNT; ++i, ++eventCount)
+            {
+                pipe.push<PayloadEvent>();
+            }
+            if (eventCount < EVENT_COUNT)
+            {
+                registerCallback(*this);
+            }
+        }
+    };
+};
+
+void testEventAllocatorHugePage()
+{
+    const Time deadline = HighResolutionTime()() + Time::Second(5);
+    TestEventAllocatorHugePage::Shared shared;
+    TestStartSequence startSequence;
+    ASSERT_FALSE(startSequence.getEventAllocatorHugePageFlag());
+    startSequence.setEventAllocatorHugePageFlag(true);
+    startSequence.setEventAllocatorPageSizeByte(1024);
+    startSequence.addActor<TestEventAllocatorHugePage::ReceiverActor>(1, &shared);
+    startSequence.addActor<TestEventAllocatorHugePage::SenderActor>(0, &shared);
+    Engine engine(startSequence);
+    for (; !shared.doneFlag && HighResolutionTime()() < deadline; threadSleep())
+    {
+    }
+    ASSERT_TRUE(shared.doneFlag);
+    ASSERT_LT(2u, engine.getNumaPlacement(0, 1).eventPageCount);
+}
+
+struct TestLargeEvent
+{
+    static const size_t EVENT_PAGE_SIZE = 1024;
+    static const unsigned BURST_COUNT = 100;
+    struct LargeEvent : Actor::Event
+    {
+        const unsigned seed;
+        char payload[3 * EVENT_PAGE_SIZE];
+        LargeEvent(unsigned pseed) : seed(pseed)
+        {
+            for (size_t i = 0; i < sizeof(payload); ++i)
+            {
+                payload[i] = (char)(seed + i);
+            }
+        }
+        bool check() const
+        {
+            size_t i = 0;
+            for (; i < sizeof(payload) && payload[i] == (char)(seed + i); ++i)
+            {
+            }
+            return i == sizeof(payload);
+        }
+    };
+    struct SmallEvent : Actor::Event
+    {
+    };
+    struct Shared
+    {
+        Actor::ActorId remoteReceiverActorId;
+        volatile unsigned doneCount;
+        volatile bool errorFlag;
+        Shared() : doneCount(0), errorFlag(false) {}
+    };
+    struct ReceiverActor : Actor
+    {
+        Shared &shared;
+        unsigned largeEventCount;
+        unsigned smallEventCount;
+        ReceiverActor(Shared *pshared) : shared(*pshared), largeEventCount(0), smallEventCount(0)
+        {
+            shared.remoteReceiverActorId = getActorId(); // overwritten by the local receiver, created last
+            registerEventHandler<LargeEvent>(*this);
+            registerEventHandler<SmallEvent>(*this);
+        }
+        void onEvent(const LargeEvent &event)
+        {
+            if (!event.check())
+            {
+                shared.errorFlag = true;
+            }
+            if (++largeEventCount == 2 * BURST_COUNT)
+            {
+                if (smallEventCount != BURST_COUNT)
+                {
+                    shared.errorFlag = true;
+                }
+                atomicAddAndFetch(&shared.doneCount, 1);
+            }
+        }
+        void onEvent(const SmallEvent &) { ++smallEventCount; }
+    };
+    /**
+     * Pushes bursts mixing small and larger than page size events, to a remote and to a local receiver.
+     * Bursts are paced for the previous one to be acknowledged, so that large pages get recycled.
+     */
+    struct SenderActor : Actor, Actor::Callback
+    {
+        const ActorId remoteReceiverActorId;
+        ActorReference<ReceiverActor> localReceiver;
+        unsigned burstCount;
+        Time burstTime;
+        SenderActor(Shared *shared)
+            : remoteReceiverActorId(shared->remoteReceiverActorId),
+              localReceiver(newReferencedActor<ReceiverActor>(shared)), burstCount(0)
+        {
+            registerCallback(*this);
+        }
+        void onCallback() noexcept
+        {
+            if (HighResolutionTime()() < burstTime)
+            {
+                registerCallback(*this);
+                return;
+            }
+            burstTime = HighResolutionTime()() + Time::Millisecond(1);
+            pushBurst(remoteReceiverActorId);
+            pushBurst(localReceiver->getActorId());
+            if (++burstCount < BURST_COUNT)
+            {
+                registerCallback(*this);
+            }
+        }
+        void pushBurst(const ActorId &actorId)
+        {
+            Event::Pipe pipe(*this, actorId);
+            pipe.push<LargeEvent>(2 * burstCount);
+            pipe.push<SmallEvent>();
+            pipe.push<LargeEvent>(2 * burstCount + 1);
+        }
+    };
+};
+
+void testLargeEvent()
+{
+    const Time deadline = HighResolutionTime()() + Time::Second(5);
+    TestLargeEvent::Shared shared;
+    TestStartSequence startSequence;
+    startSequence.setEventAllocatorPageSizeByte(TestLargeEvent::EVENT_PAGE_SIZE);
+    startSequence.addActor<TestLargeEvent::ReceiverActor>(1, &shared);
+    startSequence.addActor<TestLargeEvent::SenderActor>(0, &shared);
+    Engine engine(startSequence);
+    for (; shared.doneCount < 2 && HighResolutionTime()() < deadline; threadSleep())
+    {
+    }
+    ASSERT_EQ(2u, shared.doneCount);
+    ASSERT_FALSE(shared.errorFlag);
+    // large pages are recycled with their batch
+    ASSERT_GT(20u, engine.getNumaPlacement(0, 1).eventPageCount);
+}
+
+struct TestEventPageTrim
+{
+    static const unsigned BURST_EVENT_COUNT = 100;
+    struct PayloadEvent : Actor::Event
+    {
+        const unsigned seed;
+        char payload[2000];
+        PayloadEvent(unsigned pseed) : seed(pseed) { memset(payload, (int)seed, sizeof(payload)); }
+        bool check() const { return payload[0] == (char)seed && payload[sizeof(payload) - 1] == (char)seed; }
+    };
+    struct Shared
+    {
+        Actor::ActorId receiverActorId;
+        volatile unsigned step;
+        volatile unsigned eventCount;
+        volatile bool errorFlag;
+        Shared() : step(1), eventCount(0), errorFlag(false) {}
+    };
+    struct ReceiverActor : Actor
+    {
+        Shared &shared;
+        ReceiverActor(Shared *pshared) : shared(*pshared)
+        {
+            shared.receiverActorId = getActorId();
+            registerEventHandler<PayloadEvent>(*this);
+        }
+        void onEvent(const PayloadEvent &event)
+        {
+            if (!event.check())
+            {
+                shared.errorFlag = true;
+            }
+            memoryBarrier();
+            ++shared.eventCount;
+        }
+    };
+    /**
+     * Steps are driven by the test: 1) burst, 2) single event (the burst pages are freed by this next write),
+     * 3) burst.
+     * Performance-neutral callbacks let the core count as idle, hence trim, between steps.
+     */
+    struct SenderActor : Actor, Actor::Callback
+    {
+        Shared &shared;
+        unsigned doneStep;
+        SenderActor(Shared *pshared) : shared(*pshared), doneStep(0) { registerPerformanceNeutralCallback(*this); }
+        void onCallback() noexcept
+        {
+            if (doneStep < shared.step)
+            {
+                ++doneStep;
+                Event::Pipe pipe(*this, shared.receiverActorId);
+                for (unsigned i = 0, n = doneStep == 2 ? 1 : BURST_EVENT_COUNT; i < n; ++i)
+                {
+                    pipe.push<PayloadEvent>(doneStep * BURST_EVENT_COUNT + i);
+                }
+            }
+            if (doneStep < 3)
+            {
+                registerPerformanceNeutralCallback(*this);
+            }
+        }
+    };
+    static void wait(const Shared &shared, unsigned eventCount, const Time &deadline)
+    {
+        for (; shared.eventCount < eventCount && HighResolutionTime()() < deadline; threadSleep())
+        {
+        }
+    }
+};
+
+void testEventPageTrim()
+{
+    const Time deadline = HighResolutionTime()() + Time::Second(5);
+    TestEventPageTrim::Shared shared;
+    TestStartSequence startSequence;
+    startSequence.setEventAllocatorPageSizeByte(16 * 1024);
+    startSequence.setEventPageTrimPolicy(EngineEventPageTrimPolicy(2, 100));
+    ASSERT_EQ(2u, startSequence.getEventPageTrimPolicy().freePageHighWatermark);
+    startSequence.addActor<TestEventPageTrim::ReceiverActor>(1, &shared);
+    startSequence.addActor<TestEventPageTrim::SenderActor>(0, &shared);
+    Engine engine(startSequence);
+    TestEventPageTrim::wait(shared, TestEventPageTrim::BURST_EVENT_COUNT, deadline);
+    shared.step = 2;
+    TestEventPageTrim::wait(shared, TestEventPageTrim::BURST_EVENT_COUNT + 1, deadline);
+    Engine::EventPageCount eventPageCount;
+    for (; eventPageCount.trimmedPageCount == 0 && HighResolutionTime()() < deadline; threadSleep())
+    {
+        eventPageCount = engine.getEventPageCount(0, 1);
+    }
+    ASSERT_LT(0u, eventPageCount.trimmedPageCount);
+    ASSERT_GE(2u, eventPageCount.freePageCount);
+    const size_t pageCount =
+        eventPageCount.usedPageCount + eventPageCount.freePageCount + eventPageCount.trimmedPageCount;
+    // the second burst reuses trimmed pages
+    shared.step = 3;
+    TestEventPageTrim::wait(shared, 2 * TestEventPageTrim::BURST_EVENT_COUNT + 1, deadline);
+    ASSERT_EQ(2 * TestEventPageTrim::BURST_EVENT_COUNT + 1, shared.eventCount);
+    ASSERT_FALSE(shared.errorFlag);
+    eventPageCount = engine.getEventPageCount(0, 1);
+    ASSERT_EQ(pageCount, eventPageCount.usedPageCount + eventPageCount.freePageCount + eventPageCount.trimmedPageCount);
+    ASSERT_EQ(std::numeric_limits<size_t>::max(), EngineEventPageTrimPolicy().freePageHighWatermark);
+}
+
+/**
+ * Huge page backed event pages are never trimmed: free pages beyond the high watermark are kept.
+ */
+void testEventPageTrimHugePage()
+{
+    const Time deadline = HighResolutionTime()() + Time::Second(5);
+    TestEventPageTrim::Shared shared;
+    TestStartSequence startSequence;
+    startSequence.setEventAllocatorPageSizeByte(16 * 1024);
+    startSequence.setEventAllocatorHugePageFlag(true);
+    startSequence.setEventPageTrimPolicy(EngineEventPageTrimPolicy(2, 100));
+    startSequence.addActor<TestEventPageTrim::ReceiverActor>(1, &shared);
+    startSequence.addActor<TestEventPageTrim::SenderActor>(0, &shared);
+    Engine engine(startSequence);
+    TestEventPageTrim::wait(shared, TestEventPageTrim::BURST_EVENT_COUNT, deadline);
+    shared.step = 2;
+    TestEventPageTrim::wait(shared, TestEventPageTrim::BURST_EVENT_COUNT + 1, deadline);
+    Engine::EventPageCount eventPageCount;
+    for (; eventPageCount.freePageCount <= 2 && HighResolutionTime()() < deadline; threadSleep())
+    {
+        eventPageCount = engine.getEventPageCount(0, 1);
+    }
+    ASSERT_LT(2u, eventPageCount.freePageCount);
+    ASSERT_EQ(0u, eventPageCount.trimmedPageCount);
+    shared.step = 3;
+    TestEventPageTrim::wait(shared, 2 * TestEventPageTrim::BURST_EVENT_COUNT + 1, deadline);
+    ASSERT_FALSE(shared.errorFlag);
+}
+
+struct TestEventFlowControl
+{
+    static const unsigned MAX_OUTSTANDING_EVENT_COUNT = 10;
+    static const unsigned EVENT_COUNT = 1000;
+    struct SeedEvent : Actor::Event
+    {
+        const unsigned seed;
+        SeedEvent(unsigned pseed) : seed(pseed) {}
+    };
+    struct Shared
+    {
+        Actor::ActorId receiverActorId;
+        volatile unsigned eventCount;
+        volatile unsigned maxRoundEventCount;
+        volatile unsigned roundCount;
+        volatile bool errorFlag;
+        Shared() : eventCount(0), maxRoundEventCount(0), roundCount(0), errorFlag(false) {}
+    };
+    struct ReceiverActor : Actor
+    {
+        Shared &shared;
+        ReceiverActor(Shared *pshared) : shared(*pshared)
+        {
+            shared.receiverActorId = getActorId();
+            registerEventHandler<SeedEvent>(*this);
+        }
+        void onEvent(const SeedEvent &event)
+        {
+            if (event.seed != shared.eventCount)
+            {
+                shared.errorFlag = true;
+            }
+            memoryBarrier();
+            ++shared.eventCount;
+        }
+    };
+    /**
+     * Pushes until the pipe is no more writable, then waits for the receiver to drain.
+     */
+    struct SenderActor : Actor, Actor::Callback
+    {
+        Shared &shared;
+        unsigned seed;
+        SenderActor(Shared *pshared) : shared(*pshared), seed(0) { registerCallback(*this); }
+        void onCallback() noexcept
+        {
+            Event::Pipe pipe(*this, shared.receiverActorId);
+            unsigned roundEventCount = 0;
+            for (; seed < EVENT_COUNT && pipe.tryPush<SeedEvent>(seed) != 0; ++seed, ++roundEventCount)
+            {
+            }
+            if (roundEventCount > shared.maxRoundEventCount)
+            {
+                shared.maxRoundEventCount = roundEventCount;
+            }
+            ++shared.roundCount;
+            if (seed < EVENT_COUNT)
+            {
+                if (pipe.isWritable())
+                {
+                    shared.errorFlag = true;
+                }
+                pipe.registerOnWritableCallback(*this);
+            }
+        }
+    };
+};
+
+const unsigned TestEventFlowControl::MAX_OUTSTANDING_EVENT_COUNT;
+const unsigned TestEventFlowControl::EVENT_COUNT;
+
+void testEventFlowControl()
+{
+    const Time deadline = HighResolutionTime()() + Time::Second(5);
+    TestEventFlowControl::Shared shared;
+    TestStartSequence startSequence;
+    startSequence.setEventFlowControlPolicy(
+        EngineEventFlowControlPolicy(TestEventFlowControl::MAX_OUTSTANDING_EVENT_COUNT));
+    ASSERT_EQ(TestEventFlowControl::MAX_OUTSTANDING_EVENT_COUNT,
+              startSequence.getEventFlowControlPolicy().maxOutstandingEventCount);
+    startSequence.addActor<TestEventFlowControl::ReceiverActor>(1, &shared);
+    startSequence.addActor<TestEventFlowControl::SenderActor>(0, &shared);
+    Engine engine(startSequence);
+    for (; shared.eventCount < TestEventFlowControl::EVENT_COUNT && HighResolutionTime()() < deadline; threadSleep())
+    {
+    }
+    ASSERT_EQ(TestEventFlowControl::EVENT_COUNT, shared.eventCount);
+    ASSERT_FALSE(shared.errorFlag);
+    ASSERT_EQ(TestEventFlowControl::MAX_OUTSTANDING_EVENT_COUNT, shared.maxRoundEventCount);
+    ASSERT_LE(TestEventFlowControl::EVENT_COUNT / TestEventFlowControl::MAX_OUTSTANDING_EVENT_COUNT,
+              shared.roundCount);
+}
+
+struct TestPriorityLane
+{
+    static const unsigned NORMAL_EVENT_COUNT = 10000;
+    static const unsigned ROUND_COUNT = 10;
+    struct NormalEvent : Actor::Event
+    {
+    };
+    struct PriorityEvent : Actor::Event
+    {
+        const unsigned round;
+        PriorityEvent(unsigned pround) : round(pround) {}
+    };
+    struct Shared
+    {
+        Actor::ActorId receiverActorId;
+        volatile unsigned normalEventCount;
+        volatile unsigned priorityEventCount;
+        volatile unsigned maxNormalEventCountBeforePriority; // within the same round
+        volatile bool errorFlag;
+        Shared() : normalEventCount(0), priorityEventCount(0), maxNormalEventCountBeforePriority(0), errorFlag(false)
+        {
+        }
+    };
+    struct ReceiverActor : Actor
+    {
+        Shared &shared;
+        ReceiverActor(Shared *pshared) : shared(*pshared)
+        {
+            shared.receiverActorId = getActorId();
+            registerEventHandler<NormalEvent>(*this);
+            registerEventHandler<PriorityEvent>(*this);
+        }
+        void onEvent(const NormalEvent &)
+        {
+            memoryBarrier();
+            ++shared.normalEventCount;
+        }
+        void onEvent(const PriorityEvent &event)
+        {
+            if (event.round != shared.priorityEventCount)
+            {
+                shared.errorFlag = true;
+            }
+            unsigned normalEventCountBeforePriority = shared.normalEventCount - event.round * NORMAL_EVENT_COUNT;
+            if (normalEventCountBeforePriority > shared.maxNormalEventCountBeforePriority)
+            {
+                shared.maxNormalEventCountBeforePriority = normalEventCountBeforePriority;
+            }
+            memoryBarrier();
+            ++shared.priorityEventCount;
+        }
+    };
+    /**
+     * Each round saturates the normal lane, then pushes one priority event which must overtake the round's backlog.
+     */
+    struct SenderActor : Actor, Actor::Callback
+    {
+        Shared &shared;
+        unsigned round;
+        SenderActor(Shared *pshared) : shared(*pshared), round(0) { registerCallback(*this); }
+        void onCallback() noexcept
+        {
+            if (shared.normalEventCount == round * NORMAL_EVENT_COUNT && shared.priorityEventCount == round)
+            {
+                Event::Pipe pipe(*this, shared.receiverActorId);
+                Event::Pipe priorityPipe(*this, shared.receiverActorId);
+                priorityPipe.setPriorityLaneFlag(true);
+                for (unsigned i = 0; i < NORMAL_EVENT_COUNT; ++i)
+                {
+                    pipe.push<NormalEvent>();
+                }
+                priorityPipe.push<PriorityEvent>(round);
+                ++round;
+            }
+            if (round < ROUND_COUNT)
+            {
+                registerCallback(*this);
+            }
+        }
+    };
+};
+
+const unsigned TestPriorityLane::NORMAL_EVENT_COUNT;
+const unsigned TestPriorityLane::ROUND_COUNT;
+
+void testPriorityLane()
+{
+    const Time deadline = HighResolutionTime()() + Time::Second(5);
+    TestPriorityLane::Shared shared;
+    TestStartSequence startSequence;
+    startSequence.addActor<TestPriorityLane::ReceiverActor>(1, &shared);
+    startSequence.addActor<TestPriorityLane::SenderActor>(0, &shared);
+    Engine engine(startSequence);
+    for (; shared.normalEventCount < TestPriorityLane::ROUND_COUNT * TestPriorityLane::NORMAL_EVENT_COUNT &&
+           HighResolutionTime()() < deadline;
+         threadSleep())
+    {
+    }
+    ASSERT_EQ(TestPriorityLane::ROUND_COUNT * TestPriorityLane::NORMAL_EVENT_COUNT, shared.normalEventCount);
+    ASSERT_EQ(TestPriorityLane::ROUND_COUNT, shared.priorityEventCount);
+    ASSERT_FALSE(shared.errorFlag);
+    ASSERT_EQ(0u, shared.maxNormalEventCountBeforePriority);
+}
+
+struct TestEventDeliveryBudget
+{
+    static const unsigned EVENT_COUNT = 10000;
+    static const uint64_t MAX_EVENT_COUNT = 100;
+    struct PayloadEvent : Actor::Event
+    {
+        const unsigned index;
+        PayloadEvent(unsigned pindex) : index(pindex) {}
+    };
+    struct Shared
+    {
+        struct Receiver
+        {
+            Actor::ActorId actorId;
+            volatile unsigned eventCount;
+            volatile unsigned interleavedCallbackCount; // callbacks run while the batch was being delivered
+            volatile uint64_t deliveryBudgetHitCount;
+            volatile bool errorFlag;
+            Receiver() : eventCount(0), interleavedCallbackCount(0), deliveryBudgetHitCount(0), errorFlag(false) {}
+        };
+        Receiver receivers[2]; // local, remote
+    };
+    struct ReceiverActor : Actor, Actor::Callback
+    {
+        Shared::Receiver &receiver;
+        ReceiverActor(Shared::Receiver *preceiver) : receiver(*preceiver)
+        {
+            receiver.actorId = getActorId();
+            registerEventHandler<PayloadEvent>(*this);
+            registerCallback(*this);
+        }
+        void onEvent(const PayloadEvent &event)
+        {
+            if (event.index != receiver.eventCount)
+            {
+                receiver.errorFlag = true;
+            }
+            if (event.index + 1 == EVENT_COUNT)
+            {
+                receiver.deliveryBudgetHitCount = getCorePerformanceCounters().getDeliveryBudgetHitCountFrom(0);
+            }
+            memoryBarrier();
+            ++receiver.eventCount;
+        }
+        void onCallback() noexcept
+        {
+            if (receiver.eventCount != 0 && receiver.eventCount != EVENT_COUNT)
+            {
+                ++receiver.interleavedCallbackCount;
+            }
+            if (receiver.eventCount != EVENT_COUNT)
+            {
+                registerCallback(*this);
+            }
+        }
+    };
+    /**
+     * Pushes the whole backlog in a single batch, which the budget splits over the receiver event-loop iterations.
+     */
+    struct SenderActor : Actor, Actor::Callback
+    {
+        Shared &shared;
+        SenderActor(Shared *pshared) : shared(*pshared) { registerCallback(*this); }
+        void onCallback() noexcept
+        {
+            for (unsigned r = 0; r < 2; ++r)
+            {
+                Event::Pipe pipe(*this, shared.receivers[r].actorId);
+                for (unsigned i = 0; i < EVENT_COUNT; ++i)
+                {
+                    pipe.push<PayloadEvent>(i);
+                }
+            }
+        }
+    };
+};
+
+const unsigned TestEventDeliveryBudget::EVENT_COUNT;
+const uint64_t TestEventDeliveryBudget::MAX_EVENT_COUNT;
+
+void testEventDeliveryBudget()
+{
+    const Time deadline = HighResolutionTime()() + Time::Second(5);
+    TestEventDeliveryBudget::Shared shared;
+    TestStartSequence startSequence;
+    startSequence.setEventDeliveryBudgetPolicy(
+        EngineEventDeliveryBudgetPolicy(TestEventDeliveryBudget::MAX_EVENT_COUNT));
+    ASSERT_EQ(TestEventDeliveryBudget::MAX_EVENT_COUNT, startSequence.getEventDeliveryBudgetPolicy().maxEventCount);
+    startSequence.addActor<TestEventDeliveryBudget::ReceiverActor>(0, &shared.receivers[0]);
+    startSequence.addActor<TestEventDeliveryBudget::ReceiverActor>(1, &shared.receivers[1]);
+    startSequence.addActor<TestEventDeliveryBudget::SenderActor>(0, &shared);
+    Engine engine(startSequence);
+    for (unsigned r = 0; r < 2; ++r)
+    {
+        const TestEventDeliveryBudget::Shared::Receiver &receiver = shared.receivers[r];
+        for (; receiver.eventCount < TestEventDeliveryBudget::EVENT_COUNT && HighResolutionTime()() < deadline;
+             threadSleep())
+        {
+        }
+        ASSERT_EQ(TestEventDeliveryBudget::EVENT_COUNT, receiver.eventCount);
+        ASSERT_FALSE(receiver.errorFlag);
+        ASSERT_LE(TestEventDeliveryBudget::EVENT_COUNT / TestEventDeliveryBudget::MAX_EVENT_COUNT - 1,
+                  receiver.deliveryBudgetHitCount);
+        ASSERT_LT(0u, receiver.interleavedCallbackCount);
+    }
+}
+
+struct TestEventDeliveryBudgetSharedByPeers
+{
+    static const unsigned EVENT_COUNT = 10000;
+    static const uint64_t MAX_EVENT_COUNT = 100;
+    static const unsigned SENDER_COUNT = 2;
+    struct PayloadEvent : Actor::Event
+    {
+    };
+    struct Shared
+    {
+        Actor::ActorId receiverActorId;
+        volatile unsigned eventCount;
+        volatile unsigned maxIterationEventCount; // events delivered between two callbacks
+        Shared() : eventCount(0), maxIterationEventCount(0) {}
+    };
+    struct ReceiverActor : Actor, Actor::Callback
+    {
+        Shared &shared;
+        unsigned callbackEventCount;
+        ReceiverActor(Shared *pshared) : shared(*pshared), callbackEventCount(0)
+        {
+            shared.receiverActorId = getActorId();
+            registerEventHandler<PayloadEvent>(*this);
+            registerCallback(*this);
+        }
+        void onEvent(const PayloadEvent &)
+        {
+            memoryBarrier();
+            ++shared.eventCount;
+        }
+        void onCallback() noexcept
+        {
+            shared.maxIterationEventCount =
+                std::max((unsigned)shared.maxIterationEventCount, shared.eventCount - callbackEventCount);
+            callbackEventCount = shared.eventCount;
+            if (shared.eventCount != SENDER_COUNT * EVENT_COUNT)
+            {
+                registerCallback(*this);
+            }
+        }
+    };
+    struct SenderActor : Actor, Actor::Callback
+    {
+        Shared &shared;
+        SenderActor(Shared *pshared) : shared(*pshared) { registerCallback(*this); }
+        void onCallback() noexcept
+        {
+            Event::Pipe pipe(*this, shared.receiverActorId);
+            for (unsigned i = 0; i < EVENT_COUNT; ++i)
+            {
+                pipe.push<PayloadEvent>();
+            }
+        }
+    };
+};
+
+const unsigned TestEventDeliveryBudgetSharedByPeers::EVENT_COUNT;
+const uint64_t TestEventDeliveryBudgetSharedByPeers::MAX_EVENT_COUNT;
+const unsigned TestEventDeliveryBudgetSharedByPeers::SENDER_COUNT;
+
+void testEventDeliveryBudgetSharedByPeers()
+{
+    const Time deadline = HighResolutionTime()() + Time::Second(5);
+    TestEventDeliveryBudgetSharedByPeers::Shared shared;
+    TestStartSequence startSequence;
+    startSequence.setEventDeliveryBudgetPolicy(
+        EngineEventDeliveryBudgetPolicy(TestEventDeliveryBudgetSharedByPeers::MAX_EVENT_COUNT));
+    startSequence.addActor<TestEventDeliveryBudgetSharedByPeers::ReceiverActor>(0, &shared);
+    for (unsigned i = 0; i < TestEventDeliveryBudgetSharedByPeers::SENDER_COUNT; ++i)
+    {
+        startSequence.addActor<TestEventDeliveryBudgetSharedByPeers::SenderActor>(1 + i, &shared);
+    }
+    Engine engine(startSequence);
+    for (; shared.eventCount < TestEventDeliveryBudgetSharedByPeers::SENDER_COUNT *
+                                   TestEventDeliveryBudgetSharedByPeers::EVENT_COUNT &&
+           HighResolutionTime()() < deadline;
+         threadSleep())
+    {
+    }
+    ASSERT_EQ(TestEventDeliveryBudgetSharedByPeers::SENDER_COUNT * TestEventDeliveryBudgetSharedByPeers::EVENT_COUNT,
+              shared.eventCount);
+    // the budget is shared by all peers, except for the first event of each batch
+    ASSERT_GE(TestEventDeliveryBudgetSharedByPeers::MAX_EVENT_COUNT + TestEventDeliveryBudgetSharedByPeers::SENDER_COUNT,
+              shared.maxIterationEventCount);
+}
+
+void testEventDeliveryBudgetZero()
+{
+    const Time deadline = HighResolutionTime()() + Time::Second(5);
+    TestEventDeliveryBudget::Shared shared;
+    TestStartSequence startSequence;
+    startSequence.setEventDeliveryBudgetPolicy(EngineEventDeliveryBudgetPolicy(0));
+    startSequence.addActor<TestEventDeliveryBudget::ReceiverActor>(0, &shared.receivers[0]);
+    startSequence.addActor<TestEventDeliveryBudget::ReceiverActor>(1, &shared.receivers[1]);
+    startSequence.addActor<TestEventDeliveryBudget::SenderActor>(0, &shared);
+    Engine engine(startSequence);
+    for (unsigned r = 0; r < 2; ++r)
+    {
+        const TestEventDeliveryBudget::Shared::Receiver &receiver = shared.receivers[r];
+        for (; receiver.eventCount < TestEventDeliveryBudget::EVENT_COUNT && HighResolutionTime()() < deadline;
+             threadSleep())
+        {
+        }
+        ASSERT_EQ(TestEventDeliveryBudget::EVENT_COUNT, receiver.eventCount);
+        ASSERT_FALSE(receiver.errorFlag);
+        ASSERT_EQ(0u, receiver.deliveryBudgetHitCount); // no limit
+    }
+}
+
+struct TestMulticastPipe
+{
+    static const unsigned EVENT_COUNT = 100;
+    static const unsigned RECEIVER_COUNT = 5;
+    struct PayloadEvent : Actor::Event
+    {
+        const unsigned index;
+        PayloadEvent(unsigned pindex) : index(pindex) {}
+    };
+    struct Shared
+    {
+        struct Receiver
+        {
+            Actor::ActorId actorId;
+            volatile unsigned eventCount;
+            const void *volatile lastEvent;
+            volatile bool errorFlag;
+            bool returnToSenderFlag;
+            Receiver() : eventCount(0), lastEvent(0), errorFlag(false), returnToSenderFlag(false) {}
+        };
+        Receiver receivers[RECEIVER_COUNT]; // 2 on core 0, 3 on core 1, the last one returns events to sender
+        volatile unsigned undeliveredEventCount;
+        volatile bool errorFlag;
+        Shared() : undeliveredEventCount(0), errorFlag(false) { receivers[RECEIVER_COUNT - 1].returnToSenderFlag = true; }
+    };
+    struct ReceiverActor : Actor
+    {
+        Shared::Receiver &receiver;
+        ReceiverActor(Shared::Receiver *preceiver) : receiver(*preceiver)
+        {
+            receiver.actorId = getActorId();
+            registerEventHandler<PayloadEvent>(*this);
+        }
+        void onEvent(const PayloadEvent &event)
+        {
+            if (event.index != receiver.eventCount || event.getDestinationActorId() != getActorId())
+            {
+                receiver.errorFlag = true;
+            }
+            receiver.lastEvent = &event;
+            memoryBarrier();
+            ++receiver.eventCount;
+            if (receiver.returnToSenderFlag)
+            {
+                throw ReturnToSenderException();
+            }
+        }
+    };
+    struct SenderActor : Actor, Actor::Callback
+    {
+        Shared &shared;
+        SenderActor(Shared *pshared) : shared(*pshared)
+        {
+            registerUndeliveredEventHandler<PayloadEvent>(*this);
+            registerCallback(*this);
+        }
+        void onCallback() noexcept
+        {
+            Event::MulticastPipe pipe(*this);
+            for (unsigned r = 0; r < RECEIVER_COUNT; ++r)
+            {
+                pipe.addDestinationActorId(shared.receivers[RECEIVER_COUNT - 1 - r].actorId);
+                pipe.addDestinationActorId(shared.receivers[RECEIVER_COUNT - 1 - r].actorId);
+            }
+            if (pipe.getDestinationActorIdCount() != RECEIVER_COUNT)
+            {
+                shared.errorFlag = true;
+            }
+            for (unsigned i = 0; i < EVENT_COUNT; ++i)
+            {
+                pipe.push<PayloadEvent>(i);
+            }
+        }
+        void onUndeliveredEvent(const PayloadEvent &event)
+        {
+            if (event.index != shared.undeliveredEventCount ||
+                event.getDestinationActorId() != shared.receivers[RECEIVER_COUNT - 1].actorId)
+            {
+                shared.errorFlag = true;
+            }
+            memoryBarrier();
+            ++shared.undeliveredEventCount;
+        }
+    };
+};
+
+const unsigned TestMulticastPipe::EVENT_COUNT;
+const unsigned TestMulticastPipe::RECEIVER_COUNT;
+
+void testMulticastPipe()
+{
+    const Time deadline = HighResolutionTime()() + Time::Second(5);
+    TestMulticastPipe::Shared shared;
+    TestStartSequence startSequence;
+    startSequence.addActor<TestMulticastPipe::ReceiverActor>(0, &shared.receivers[0]);
+    startSequence.addActor<TestMulticastPipe::ReceiverActor>(0, &shared.receivers[1]);
+    startSequence.addActor<TestMulticastPipe::ReceiverActor>(1, &shared.receivers[2]);
+    startSequence.addActor<TestMulticastPipe::ReceiverActor>(1, &shared.receivers[3]);
+    startSequence.addActor<TestMulticastPipe::ReceiverActor>(1, &shared.receivers[4]);
+    startSequence.addActor<TestMulticastPipe::SenderActor>(0, &shared);
+    Engine engine(startSequence);
+    for (; shared.undeliveredEventCount < TestMulticastPipe::EVENT_COUNT && HighResolutionTime()() < deadline;
+         threadSleep())
+    {
+    }
+    ASSERT_EQ(TestMulticastPipe::EVENT_COUNT, shared.undeliveredEventCount);
+    ASSERT_FALSE(shared.errorFlag);
+    for (unsigned r = 0; r < TestMulticastPipe::RECEIVER_COUNT; ++r)
+    {
+        for (; shared.receivers[r].eventCount < TestMulticastPipe::EVENT_COUNT && HighResolutionTime()() < deadline;
+             threadSleep())
+        {
+        }
+        ASSERT_EQ(TestMulticastPipe::EVENT_COUNT, shared.receivers[r].eventCount);
+        ASSERT_FALSE(shared.receivers[r].errorFlag);
+    }
+    // one event instance per destination core
+    ASSERT_EQ(shared.receivers[0].lastEvent, shared.receivers[1].lastEvent);
+    ASSERT_EQ(shared.receivers[2].lastEvent, shared.receivers[3].lastEvent);
+    ASSERT_EQ(shared.receivers[2].lastEvent, shared.receivers[4].lastEvent);
+    ASSERT_NE(shared.receivers[0].lastEvent, shared.receivers[2].lastEvent);
+}
+
+struct TestEventHandlerPlacement
+{
+    static const unsigned HANDLER_COUNT = 10; // more than the high-frequency part of an event-table holds
+    static const unsigned EVENT_COUNT = 1000;
+    static const uint64_t PLACEMENT_EVENT_COUNT = 100;
+    template <unsigned I> struct PayloadEvent : Actor::Event
+    {
+    };
+    struct Shared
+    {
+        volatile unsigned eventCount[HANDLER_COUNT];
+        volatile bool initialHighFrequencyFlag; // of the last registered handler, before any event
+        volatile bool promotedFlag;             // of the last registered handler, after its events were dispatched
+        volatile uint64_t promotionCount;
+        volatile uint64_t demotionCount;
+        volatile bool doneFlag;
+        Shared() : eventCount(), initialHighFrequencyFlag(true), promotedFlag(false), promotionCount(0),
+                   demotionCount(0), doneFlag(false)
+        {
+        }
+    };
+    /**
+     * Only dispatches events to the last registered handler, which must get promoted, and then to the first one,
+     * which must still be dispatched if it was demoted meanwhile.
+     */
+    struct PlacementActor : Actor
+    {
+        Shared &shared;
+        PlacementActor(Shared *pshared) : shared(*pshared)
+        {
+            Register<HANDLER_COUNT>::run(*this);
+            shared.initialHighFrequencyFlag = isHighFrequencyEventHandler<PayloadEvent<HANDLER_COUNT - 1>>();
+            push<HANDLER_COUNT - 1>();
+        }
+        template <unsigned I> void push()
+        {
+            Event::Pipe pipe(*this, getActorId());
+            for (unsigned i = 0; i < EVENT_COUNT; ++i)
+            {
+                pipe.push<PayloadEvent<I>>();
+            }
+        }
+        template <unsigned I> void onEvent(const PayloadEvent<I> &)
+        {
+            if (++shared.eventCount[I] != EVENT_COUNT)
+            {
+                return;
+            }
+            if (I == HANDLER_COUNT - 1)
+            {
+                push<0>();
+            }
+            else
+            { // placement runs between event-loop iterations, i.e. after the previous batch
+                shared.promotedFlag = isHighFrequencyEventHandler<PayloadEvent<HANDLER_COUNT - 1>>();
+                shared.promotionCount = getCorePerformanceCounters().getEventHandlerPromotionCount();
+                shared.demotionCount = getCorePerformanceCounters().getEventHandlerDemotionCount();
+                memoryBarrier();
+                shared.doneFlag = true;
+            }
+        }
+        template <unsigned I> struct Register
+        {
+            static void run(PlacementActor &actor)
+            {
+                Register<I - 1>::run(actor);
+                actor.registerEventHandler<PayloadEvent<I - 1>>(actor);
+            }
+        };
+    };
+};
+
+template <> struct TestEventHandlerPlacement::PlacementActor::Register<0>
+{
+    static void run(PlacementActor &) {}
+};
+
+const unsigned TestEventHandlerPlacement::EVENT_COUNT;
+const uint64_t TestEventHandlerPlacement::PLACEMENT_EVENT_COUNT;
+
+void testEventHandlerPlacement()
+{
+    const Time deadline = HighResolutionTime()() + Time::Second(5);
+    TestEventHandlerPlacement::Shared shared;
+    TestStartSequence startSequence;
+    startSequence.setEventHandlerPlacementPolicy(
+        EngineEventHandlerPlacementPolicy(TestEventHandlerPlacement::PLACEMENT_EVENT_COUNT));
+    ASSERT_EQ(TestEventHandlerPlacement::PLACEMENT_EVENT_COUNT,
+              startSequence.getEventHandlerPlacementPolicy().eventCount);
+    startSequence.addActor<TestEventHandlerPlacement::PlacementActor>(0, &shared);
+    Engine engine(startSequence);
+    for (; !shared.doneFlag && HighResolutionTime()() < deadline; threadSleep())
+    {
+    }
+    ASSERT_TRUE(shared.doneFlag);
+    ASSERT_FALSE(shared.initialHighFrequencyFlag);
+    ASSERT_TRUE(shared.promotedFlag);
+    ASSERT_EQ(TestEventHandlerPlacement::EVENT_COUNT, shared.eventCount[0]);
+    ASSERT_EQ(TestEventHandlerPlacement::EVENT_COUNT,
+              shared.eventCount[TestEventHandlerPlacement::HANDLER_COUNT - 1]);
+    ASSERT_LE(1u, shared.promotionCount);
+    ASSERT_LE(1u, shared.demotionCount);
+}
+
+struct TestParallelStart
+{
+    static const unsigned ACTOR_COUNT = 64;
+    static const unsigned SERVICE_PERIOD = 16;
+    struct Shared
+    {
+        volatile unsigned constructedCount;
+        unsigned lastIndex[2];   // per core, index + 1 of last constructed actor
+        unsigned lastServiceIndex; // index + 1 of last constructed service actor
+        Shared() : constructedCount(0), lastIndex(), lastServiceIndex(0) {}
+    };
+    struct Init
+    {
+        Shared *shared;
+        unsigned index;
+        Init(Shared *pshared, unsigned pindex) : shared(pshared), index(pindex) {}
+    };
+    struct StartActor : Actor
+    {
+        StartActor(const Init &init)
+        {
+            Shared &shared = *init.shared;
+            EXPECT_EQ(2u, getEngine().getCoreSet().size());
+            EXPECT_LT(shared.lastIndex[getCore()], init.index + 1);
+            EXPECT_LT(shared.lastServiceIndex, init.index + 1);
+            EXPECT_EQ(init.index / SERVICE_PERIOD * SERVICE_PERIOD + 1, shared.lastServiceIndex);
+            shared.lastIndex[getCore()] = init.index + 1;
+            atomicAddAndFetch(&shared.constructedCount, 1);
+        }
+    };
+    struct ServiceActor : Actor
+    {
+        ServiceActor(const Init &init)
+        {
+            Shared &shared = *init.shared;
+            EXPECT_EQ(init.index, shared.constructedCount); // all preceding actors constructed
+            shared.lastIndex[getCore()] = shared.lastServiceIndex = init.index + 1;
+            atomicAddAndFetch(&shared.constructedCount, 1);
+        }
+    };
+};
+
+const unsigned TestParallelStart::ACTOR_COUNT;
+const unsigned TestParallelStart::SERVICE_PERIOD;
+
+void testParallelStart()
+{
+    Engine::CoreSet coreSet;
+    coreSet.set(0);
+    coreSet.set(1);
+    {
+        TestParallelStart::Shared shared;
+        TestStartSequence startSequence(coreSet);
+        ASSERT_FALSE(startSequence.getParallelStartFlag());
+        startSequence.setParallelStartFlag(true);
+        ASSERT_TRUE(startSequence.getParallelStartFlag());
+        for (unsigned i = 0; i < TestParallelStart::ACTOR_COUNT; ++i)
+        {
+            if (i % TestParallelStart::SERVICE_PERIOD == 0)
+            {
+                startSequence.addServiceActor<Engine::StartSequence::AnonymousService, TestParallelStart::ServiceActor>(
+                    (i / TestParallelStart::SERVICE_PERIOD) % 2, TestParallelStart::Init(&shared, i));
+            }
+            else
+            {
+                startSequence.addActor<TestParallelStart::StartActor>(i % 2, TestParallelStart::Init(&shared, i));
+            }
+        }
+        Engine engine(startSequence);
+        ASSERT_EQ(TestParallelStart::ACTOR_COUNT, shared.constructedCount);
+    }
+    {
+        TestStartSequence startSequence(coreSet);
+        startSequence.setParallelStartFlag(true);
+        startSequence.addActor<Actor>(0);
+        startSequence.addActor<Actor>(1);
+        startSequence.addActor<TestInitExceptionActor>(0);
+        ASSERT_THROW(Engine engine(startSequence), TestInitException);
+    }
+}
+
 void testInvalidCore()
 {
     TestStartSequence startSequence;
@@ -398,5 +1570,19 @@ TEST(Engine, allocator) { testAllocator(); }
 TEST(Engine, coreInUseException) { testCoreInUseException(); }
 TEST(Engine, basicService) { testBasicService(); }
 TEST(Engine, anonymousService) { testAnonymousService(); }
+TEST(Engine, parallelStart) { testParallelStart(); }
 TEST(Engine, invalidCore) { testInvalidCore(); }
+TEST(Engine, idlePolicy) { testIdlePolicy(); }
+TEST(Engine, numaPlacement) { testNumaPlacement(); }
+TEST(Engine, eventAllocatorHugePage) { testEventAllocatorHugePage(); }
+TEST(Engine, largeEvent) { testLargeEvent(); }
+TEST(Engine, eventPageTrim) { testEventPageTrim(); }
+TEST(Engine, eventPageTrimHugePage) { testEventPageTrimHugePage(); }
+TEST(Engine, eventFlowControl) { testEventFlowControl(); }
+TEST(Engine, priorityLane) { testPriorityLane(); }
+TEST(Engine, eventDeliveryBudget) { testEventDeliveryBudget(); }
+TEST(Engine, eventDeliveryBudgetSharedByPeers) { testEventDeliveryBudgetSharedByPeers(); }
+TEST(Engine, eventDeliveryBudgetZero) { testEventDeliveryBudgetZero(); }
+TEST(Engine, multicastPipe) { testMulticastPipe(); }
+TEST(Engine, eventHandlerPlacement) { testEventHandlerPlacement(); }
 TEST(Engine, DISABLED_unreleasedMemory) { testUnreleasedMemory(); }
\ No newline at end of file
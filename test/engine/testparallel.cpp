@@ -46,9 +46,11 @@ struct TestNodesHandler
         bool isReaderActive;
         sig_atomic_t readerCAS;
         bool isWriterActive;
+        bool isDoorbellRung;
         Shared shared;
         SharedHandleData()
-            : isWriteLocked(false), isReaderActive(false), readerCAS(READER_CAS_IDLE), isWriterActive(false)
+            : isWriteLocked(false), isReaderActive(false), readerCAS(READER_CAS_IDLE), isWriterActive(false),
+              isDoorbellRung(false)
         {
         }
     };
@@ -89,6 +91,7 @@ struct TestNodesHandler
             ASSERT_EQ(isReaderActive, controlData.isReaderActive);
             ASSERT_EQ(readerCAS, controlData.readerCAS);
             ASSERT_EQ(isWriterActive, controlData.isWriterActive);
+            ASSERT_EQ(isDoorbellRung, controlData.isDoorbellRung);
             ASSERT_TRUE(!controlData.readCallToggle);
             ;
             ASSERT_TRUE(!controlData.writeCallToggle);
@@ -101,6 +104,7 @@ struct TestNodesHandler
         sig_atomic_t &getReferenceToReaderCAS() { return readerCAS; }
         bool getIsWriteLocked() { return isWriteLocked; }
         void setIsWriteLocked(bool pisWriteLocked) { isWriteLocked = pisWriteLocked; }
+        void ringReaderDoorbell(NodeId) { isDoorbellRung = true; }
         Shared &getReferenceToShared() { return shared; }
     };
 
@@ -152,6 +156,20 @@ struct TestNodesHandler
                 op(testNodesHandler.sharedHandle[i * MAX_SIZE + id], (NodeId)i);
             }
         }
+        template <class _Operator> void foreachPendingRead(NodeId readerNodeId, _Operator &op)
+        {
+            ASSERT_EQ(readerNodeId, id);
+            for (int i = 0; i < (int)testNodesHandler.size; ++i)
+            {
+                SharedHandle &sharedHandle = testNodesHandler.sharedHandle[i * MAX_SIZE + id];
+                if (sharedHandle.isDoorbellRung)
+                {
+                    ASSERT_NE(i, (int)id);
+                    sharedHandle.isDoorbellRung = false;
+                    op(sharedHandle, (NodeId)i);
+                }
+            }
+        }
         template <class _Operator> void foreachWrite(NodeId writerNodeId, _Operator &op)
         {
             ASSERT_EQ(writerNodeId, id);
@@ -365,6 +383,7 @@ void testRead(TestParallelNode &writerNode, TestParallelNode &readerNode, int va
     writerNode.setWriteSignal(readerNode.id, true);
     TestNodesHandler::instance->getSharedHandle(writerNode.id, readerNode.id).controlData.writeCallToggle = true;
     TestNodesHandler::instance->getSharedHandle(writerNode.id, readerNode.id).controlData.isWriteLocked = true;
+    TestNodesHandler::instance->getSharedHandle(writerNode.id, readerNode.id).controlData.isDoorbellRung = true;
 
     writerNode.synchronize();
 
@@ -373,6 +392,7 @@ void testRead(TestParallelNode &writerNode, TestParallelNode &readerNode, int va
     TestNodesHandler::instance->getSharedHandle(writerNode.id, readerNode.id).controlData.readValue = value;
     TestNodesHandler::instance->getSharedHandle(writerNode.id, readerNode.id).controlData.readCallToggle = true;
     TestNodesHandler::instance->getSharedHandle(writerNode.id, readerNode.id).controlData.isWriteLocked = false;
+    TestNodesHandler::instance->getSharedHandle(writerNode.id, readerNode.id).controlData.isDoorbellRung = false;
 
     readerNode.synchronize();
 
@@ -448,6 +468,7 @@ void testWriteFailed(TestParallel &testParallel)
             testNodeA.setWriteSignal(testNodeB.id, true);
             TestNodesHandler::instance->getSharedHandle(testNodeA.id, testNodeB.id).controlData.writeCallToggle = true;
             TestNodesHandler::instance->getSharedHandle(testNodeA.id, testNodeB.id).controlData.isWriteLocked = true;
+            TestNodesHandler::instance->getSharedHandle(testNodeA.id, testNodeB.id).controlData.isDoorbellRung = true;
 
             testNodeA.synchronize();
 
@@ -492,10 +513,51 @@ void testAll()
     testRead(testParallel);
     testWriteFailed(testParallel);
 }
+
+void testNodeBitSet()
+{
+    typedef simplx::NodeBitSet<200> TestNodeBitSet;
+    TestNodeBitSet bitSet;
+    ASSERT_EQ(4u, TestNodeBitSet::WORD_COUNT);
+    ASSERT_EQ(2u, TestNodeBitSet::wordCount(65));
+    ASSERT_FALSE(bitSet.any());
+
+    const size_t expected[] = {0, 1, 63, 64, 127, 199};
+    const size_t expectedCount = sizeof(expected) / sizeof(expected[0]);
+    for (size_t i = 0; i < expectedCount; ++i)
+    {
+        bitSet.set(expected[i]);
+    }
+    ASSERT_TRUE(bitSet.any());
+    ASSERT_TRUE(bitSet[63]);
+    ASSERT_FALSE(bitSet[62]);
+    size_t n = 0;
+    for (size_t w = 0; w < TestNodeBitSet::WORD_COUNT; ++w)
+    {
+        for (TestNodeBitSet::word_type bits = bitSet.getWord(w); bits != 0; bits &= bits - 1)
+        {
+            ASSERT_LT(n, expectedCount);
+            ASSERT_EQ(expected[n++], TestNodeBitSet::index(w, bits));
+        }
+    }
+    ASSERT_EQ(expectedCount, n);
+    bitSet.set(63, false);
+    ASSERT_FALSE(bitSet.test(63));
+    bitSet.reset();
+    ASSERT_FALSE(bitSet.any());
+
+    bitSet.atomicSet(3);
+    bitSet.atomicSet(70);
+    ASSERT_EQ((TestNodeBitSet::word_type)1 << 3, bitSet.atomicFetchAndResetWord(0));
+    ASSERT_EQ(0u, bitSet.atomicFetchAndResetWord(0));
+    ASSERT_EQ((TestNodeBitSet::word_type)1 << 6, bitSet.atomicFetchAndResetWord(1));
+    ASSERT_FALSE(bitSet.any());
+}
 }
 
 TEST(Parallel, init) { testInit(); }
 TEST(Parallel, write) { testWrite(); }
 TEST(Parallel, read) { testRead(); }
 TEST(Parallel, writeFailed) { testWriteFailed(); }
-TEST(Parallel, all) { testAll(); }
\ No newline at end of file
+TEST(Parallel, all) { testAll(); }
+TEST(Parallel, nodeBitSet) { testNodeBitSet(); }
\ No newline at end of file
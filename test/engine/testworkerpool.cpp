@@ -0,0 +1,228 @@
+/**
+ * @file testworkerpool.cpp
+ * @brief test worker-pool least-loaded and key-affinity routing
+ * @copyright 2019 Scalewatch (www.scalewatch.com). All rights reserved.
+ * Please see accompanying LICENSE file for licensing terms.
+ */
+
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+
+#include "simplx_core/engine.h"
+#include "pattern/workerpool.h"
+
+using namespace std;
+using namespace simplx;
+using namespace simplx::workerpool;
+
+// anonymous namespace to prevent link error due to multiple functions with same name
+namespace
+{
+
+const size_t TEST_JOB_COUNT = 1000;
+const uint64_t TEST_KEY_COUNT = 10;
+const size_t TEST_WORKER_COUNT = 2;
+
+struct TestJob
+{
+    uint64_t key;
+    uint64_t value;
+};
+
+struct TestPool : Service
+{
+    typedef TestJob Job;
+    typedef TestJob Result;
+};
+
+struct TestWorker : Worker<TestWorker, TestPool>
+{
+    TestJob onJob(const TestJob &job) noexcept
+    {
+        TestJob ret = {job.key, job.value * 2};
+        return ret;
+    }
+};
+
+struct ThrowPool : Service
+{
+    typedef uint64_t Job;
+    typedef uint64_t Result;
+};
+
+struct ThrowWorker : Worker<ThrowWorker, ThrowPool>
+{
+    uint64_t onJob(uint64_t job)
+    {
+        if (job % 2 != 0)
+        {
+            throw std::runtime_error("odd job");
+        }
+        return job;
+    }
+};
+
+struct TestResult
+{
+    size_t leastLoadedCounts[TEST_WORKER_COUNT];
+    size_t keyWorkerIndexes[TEST_KEY_COUNT];
+    size_t completionCount;
+    uint64_t resultSum;
+    bool keyAffinityFlag;
+};
+
+/**
+ * Pushes TEST_JOB_COUNT least-loaded jobs, then TEST_JOB_COUNT keyed jobs.
+ */
+struct TestClient : Actor, Actor::Callback
+{
+    TestResult &result;
+    volatile bool &doneFlag;
+    Proxy<TestPool> pool;
+    TestClient(std::pair<TestResult *, volatile bool *> p) : result(*p.first), doneFlag(*p.second), pool(*this)
+    {
+        registerEventHandler<CompletionEvent<TestPool>>(*this);
+        registerCallback(*this);
+    }
+    void onCallback() noexcept
+    {
+        if (!pool.isReady())
+        {
+            registerCallback(*this);
+            return;
+        }
+        EXPECT_EQ(TEST_WORKER_COUNT, pool.getWorkerCount());
+        for (size_t i = 0; i < TEST_JOB_COUNT; ++i)
+        {
+            TestJob job = {TEST_KEY_COUNT, i};
+            pool.push(job);
+        }
+        for (size_t i = 0; i < TEST_JOB_COUNT; ++i)
+        {
+            TestJob job = {i % TEST_KEY_COUNT, i};
+            pool.push(job.key, job);
+        }
+    }
+    void onEvent(const CompletionEvent<TestPool> &event)
+    {
+        ASSERT_GT(TEST_WORKER_COUNT, event.workerIndex);
+        ++result.completionCount;
+        result.resultSum += event.result.value;
+        if (event.result.key == TEST_KEY_COUNT)
+        {
+            ++result.leastLoadedCounts[event.workerIndex];
+        }
+        else
+        {
+            size_t &keyWorkerIndex = result.keyWorkerIndexes[event.result.key];
+            if (keyWorkerIndex == TEST_WORKER_COUNT)
+            {
+                keyWorkerIndex = event.workerIndex;
+            }
+            result.keyAffinityFlag &= keyWorkerIndex == event.workerIndex;
+        }
+        if (result.completionCount == 2 * TEST_JOB_COUNT)
+        {
+            memoryBarrier();
+            doneFlag = true;
+        }
+    }
+};
+
+/**
+ * Pushes a job before the pool is ready, then TEST_JOB_COUNT jobs, every other one throwing from onJob().
+ */
+struct ThrowClient : Actor, Actor::Callback
+{
+    volatile bool &doneFlag;
+    Proxy<ThrowPool> pool;
+    size_t completionCount;
+    size_t exceptionCount;
+    ThrowClient(volatile bool *pdoneFlag) : doneFlag(*pdoneFlag), pool(*this), completionCount(0), exceptionCount(0)
+    {
+        registerEventHandler<CompletionEvent<ThrowPool>>(*this);
+        registerCallback(*this);
+        EXPECT_FALSE(pool.isReady());
+        EXPECT_THROW(pool.push(0), NotReadyException);
+        EXPECT_THROW(pool.push(0, 0), NotReadyException);
+    }
+    void onCallback() noexcept
+    {
+        if (!pool.isReady())
+        {
+            registerCallback(*this);
+            return;
+        }
+        for (uint64_t i = 0; i < TEST_JOB_COUNT; ++i)
+        {
+            pool.push(i, i);
+        }
+    }
+    void onEvent(const CompletionEvent<ThrowPool> &event)
+    {
+        if (event.exception != 0)
+        {
+            EXPECT_STREQ("odd job", event.exception);
+            ++exceptionCount;
+        }
+        if (++completionCount == TEST_JOB_COUNT)
+        {
+            EXPECT_EQ(TEST_JOB_COUNT / 2, exceptionCount);
+            memoryBarrier();
+            doneFlag = true;
+        }
+    }
+};
+
+void testWorkerPool(TestResult &result)
+{
+    volatile bool doneFlag = false;
+    Engine::CoreSet coreSet;
+    coreSet.set(0);
+    coreSet.set(1);
+    Engine::StartSequence startSequence(coreSet);
+    addWorkerPool<TestPool, TestWorker>(startSequence, 0, coreSet);
+    startSequence.addActor<TestClient>(0, std::make_pair(&result, &doneFlag));
+    Engine engine(startSequence);
+    for (Time deadline = HighResolutionTime()() + Time::Second(10); !doneFlag && HighResolutionTime()() < deadline;
+         threadSleep())
+    {
+    }
+    EXPECT_TRUE(doneFlag);
+}
+} // namespace
+
+TEST(WorkerPool, routing)
+{
+    TestResult result = {};
+    result.keyAffinityFlag = true;
+    for (uint64_t i = 0; i < TEST_KEY_COUNT; ++i)
+    {
+        result.keyWorkerIndexes[i] = TEST_WORKER_COUNT;
+    }
+    testWorkerPool(result);
+    EXPECT_EQ(2 * TEST_JOB_COUNT, result.completionCount);
+    EXPECT_EQ(2 * TEST_JOB_COUNT * (TEST_JOB_COUNT - 1), result.resultSum); // 2 * sum of 2 * [0, TEST_JOB_COUNT)
+    EXPECT_EQ(TEST_JOB_COUNT, result.leastLoadedCounts[0] + result.leastLoadedCounts[1]);
+    EXPECT_LT(0u, result.leastLoadedCounts[0]);
+    EXPECT_LT(0u, result.leastLoadedCounts[1]);
+    EXPECT_TRUE(result.keyAffinityFlag);
+}
+
+TEST(WorkerPool, exception)
+{
+    volatile bool doneFlag = false;
+    Engine::CoreSet coreSet;
+    coreSet.set(0);
+    coreSet.set(1);
+    Engine::StartSequence startSequence(coreSet);
+    addWorkerPool<ThrowPool, ThrowWorker>(startSequence, 0, coreSet);
+    startSequence.addActor<ThrowClient>(0, &doneFlag);
+    Engine engine(startSequence);
+    for (Time deadline = HighResolutionTime()() + Time::Second(10); !doneFlag && HighResolutionTime()() < deadline;
+         threadSleep())
+    {
+    }
+    EXPECT_TRUE(doneFlag);
+}
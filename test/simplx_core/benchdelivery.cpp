@@ -0,0 +1,161 @@
+/**
+ * @file benchdelivery.cpp
+ * @brief benchmark of event dispatch throughput, in arrival order versus grouped by destination actor, and versus
+ * software prefetch distance
+ * @copyright 2019 Scalewatch (www.scalewatch.com). All rights reserved.
+ * Please see accompanying LICENSE file for licensing terms.
+ */
+
+#include "gtest/gtest.h"
+
+#include <iomanip>
+#include <iostream>
+
+#include "simplx_core/engine.h"
+
+using namespace std;
+using namespace simplx;
+
+// anonymous namespace to prevent link error due to multiple functions with same name
+namespace
+{
+
+const size_t BENCH_ACTOR_COUNT = 1024;
+const size_t BENCH_BATCH_EVENT_COUNT = 8192;
+const size_t BENCH_BATCH_COUNT = 200;
+
+template <int I> struct BenchEvent : Actor::Event
+{
+    uint64_t value;
+    BenchEvent(uint64_t pvalue) noexcept : value(pvalue) {}
+};
+
+/**
+ * Handles 8 event types, each updating the actor state (2KB, 8 cache-lines touched per event).
+ */
+struct DestinationActor : Actor
+{
+    uint64_t &eventCount;
+    uint64_t state[8][32];
+    DestinationActor(uint64_t &peventCount) : eventCount(peventCount), state()
+    {
+        registerEventHandler<BenchEvent<0>>(*this);
+        registerEventHandler<BenchEvent<1>>(*this);
+        registerEventHandler<BenchEvent<2>>(*this);
+        registerEventHandler<BenchEvent<3>>(*this);
+        registerEventHandler<BenchEvent<4>>(*this);
+        registerEventHandler<BenchEvent<5>>(*this);
+        registerEventHandler<BenchEvent<6>>(*this);
+        registerEventHandler<BenchEvent<7>>(*this);
+    }
+    template <int I> void onEvent(const BenchEvent<I> &event)
+    {
+        ++eventCount;
+        for (uint64_t(&s)[32] : state)
+        {
+            s[I] = s[I] * 31 + event.value;
+        }
+    }
+};
+
+/**
+ * Pushes one batch of events per event-loop iteration (callbacks are one-shot), each destination actor receiving
+ * the 8 event types interleaved with the events to the other actors, and times the delivery of all batches.
+ */
+struct SourceActor : Actor, Actor::Callback
+{
+    double &result; // ns per event
+    volatile bool &doneFlag;
+    uint64_t eventCount;
+    size_t batchCount;
+    Time startTime;
+    vector<ActorReference<DestinationActor>> destinations;
+    SourceActor(std::pair<double *, volatile bool *> presult)
+        : result(*presult.first), doneFlag(*presult.second), eventCount(0), batchCount(0)
+    {
+        for (size_t i = 0; i < BENCH_ACTOR_COUNT; ++i)
+        {
+            destinations.push_back(newReferencedActor<DestinationActor>(std::ref(eventCount)));
+        }
+        registerCallback(*this);
+        startTime = HighResolutionTime()();
+    }
+    void onCallback() noexcept
+    {
+        if (batchCount == BENCH_BATCH_COUNT)
+        {
+            if (eventCount == BENCH_BATCH_COUNT * BENCH_BATCH_EVENT_COUNT)
+            {
+                result = (double)(HighResolutionTime()() - startTime).toNanosecond() / eventCount;
+                memoryBarrier();
+                doneFlag = true;
+                return;
+            }
+        }
+        else
+        {
+            pushBatch();
+        }
+        registerCallback(*this);
+    }
+    void pushBatch()
+    {
+        Event::Pipe pipe(*this);
+        for (size_t i = 0; i < BENCH_BATCH_EVENT_COUNT; ++i)
+        {
+            pipe.setDestinationActorId(destinations[(i * 7) % BENCH_ACTOR_COUNT]->getActorId());
+            switch ((i / BENCH_ACTOR_COUNT) % 8)
+            {
+            case 0: pipe.push<BenchEvent<0>>(i); break;
+            case 1: pipe.push<BenchEvent<1>>(i); break;
+            case 2: pipe.push<BenchEvent<2>>(i); break;
+            case 3: pipe.push<BenchEvent<3>>(i); break;
+            case 4: pipe.push<BenchEvent<4>>(i); break;
+            case 5: pipe.push<BenchEvent<5>>(i); break;
+            case 6: pipe.push<BenchEvent<6>>(i); break;
+            default: pipe.push<BenchEvent<7>>(i); break;
+            }
+        }
+        ++batchCount;
+    }
+};
+
+double benchDelivery(const EngineEventGroupingPolicy &eventGroupingPolicy,
+                     const EngineEventPrefetchPolicy &eventPrefetchPolicy = EngineEventPrefetchPolicy())
+{
+    double result = 0;
+    volatile bool doneFlag = false;
+    Engine::CoreSet coreSet;
+    coreSet.set(0);
+    Engine::StartSequence startSequence(coreSet);
+    startSequence.setEventGroupingPolicy(eventGroupingPolicy);
+    startSequence.setEventPrefetchPolicy(eventPrefetchPolicy);
+    startSequence.addActor<SourceActor>(0, std::make_pair(&result, &doneFlag));
+    Engine engine(startSequence);
+    for (; !doneFlag; threadSleep())
+    {
+    }
+    return result;
+}
+
+void benchGrouping()
+{
+    double arrivalOrder = benchDelivery(EngineEventGroupingPolicy());
+    double grouped = benchDelivery(EngineEventGroupingPolicy(64));
+    cout << "dispatch(ns/event)  arrival-order  grouped" << endl;
+    cout << setw(33) << fixed << setprecision(1) << arrivalOrder << setw(9) << grouped << endl;
+}
+
+void benchPrefetch()
+{
+    cout << "prefetch-distance  dispatch(ns/event)" << endl;
+    for (size_t distance = 0; distance <= 32; distance = (distance == 0 ? 2 : 2 * distance))
+    {
+        double result = benchDelivery(EngineEventGroupingPolicy(), EngineEventPrefetchPolicy(distance));
+        cout << setw(17) << distance << setw(20) << fixed << setprecision(1) << result << endl;
+    }
+}
+} // namespace
+
+TEST(Delivery, benchGrouping) { benchGrouping(); }
+TEST(Delivery, benchPrefetch) { benchPrefetch(); }
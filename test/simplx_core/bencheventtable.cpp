@@ -0,0 +1,185 @@
+/**
+ * @file bencheventtable.cpp
+ * @brief benchmark of event-handler lookup latency versus registered event-handler count
+ * @copyright 2019 Scalewatch (www.scalewatch.com). All rights reserved.
+ * Please see accompanying LICENSE file for licensing terms.
+ */
+
+#include "gtest/gtest.h"
+
+#include <iomanip>
+#include <iostream>
+
+#include "simplx_core/engine.h"
+#include "simplx_core/typedactor.h"
+#include "simplx_core/internal/node.h"
+
+using namespace std;
+using namespace simplx;
+
+// anonymous namespace to prevent link error due to multiple functions with same name
+namespace
+{
+
+const size_t BENCH_LOOP_COUNT = 100000;
+const int MAX_HANDLER_COUNT = 64;
+
+template <int I> struct BenchEvent : Actor::Event
+{
+};
+
+template <int I> double benchDispatch(Actor &actor)
+{
+    Actor::Event::Pipe pipe(actor, actor.getActorId());
+    const Actor::Event &event = pipe.push<BenchEvent<I>>();
+    const Actor::EventTable &eventTable = *actor.getActorId().getEventTable();
+    uint64_t performanceCounter = 0;
+    Time start = HighResolutionTime()();
+    for (size_t i = 0; i < BENCH_LOOP_COUNT; ++i)
+    {
+        eventTable.onEvent(event, performanceCounter, false);
+    }
+    Time end = HighResolutionTime()();
+    EXPECT_EQ(BENCH_LOOP_COUNT, performanceCounter);
+    return (double)(end - start).toNanosecond() / BENCH_LOOP_COUNT;
+}
+
+struct BenchResult
+{
+    int handlerCount;
+    double lookupLatency; // ns per dispatch
+};
+
+/**
+ * Registers one more event-handler at each step, and times the dispatch of the last registered event
+ * (worst case for a linear lookup) directly through the actor event-table.
+ */
+struct BenchActor : Actor, Actor::Callback
+{
+    BenchResult *const results;
+    volatile bool &doneFlag;
+    uint64_t handlerCallCount;
+    BenchActor(std::pair<BenchResult *, volatile bool *> presults)
+        : results(presults.first), doneFlag(*presults.second), handlerCallCount(0)
+    {
+        registerCallback(*this);
+    }
+    template <int I> void onEvent(const BenchEvent<I> &) { ++handlerCallCount; }
+    template <int I> double bench()
+    {
+        registerEventHandler<BenchEvent<I>>(*this);
+        return benchDispatch<I>(*this);
+    }
+    template <int I> struct Bench
+    {
+        static void run(BenchActor &actor)
+        {
+            Bench<I - 1>::run(actor);
+            double lookupLatency = actor.bench<I - 1>();
+            if ((I & (I - 1)) == 0)
+            { // power of 2
+                BenchResult *result = actor.results;
+                for (; result->handlerCount != 0; ++result)
+                {
+                }
+                result->handlerCount = I;
+                result->lookupLatency = lookupLatency;
+            }
+        }
+    };
+    void onCallback() noexcept
+    {
+        Bench<MAX_HANDLER_COUNT>::run(*this);
+        memoryBarrier();
+        doneFlag = true;
+    }
+};
+
+template <> struct BenchActor::Bench<0>
+{
+    static void run(BenchActor &) {}
+};
+
+void benchEventTableLookup()
+{
+    BenchResult results[MAX_HANDLER_COUNT + 1] = {};
+    volatile bool doneFlag = false;
+    Engine::CoreSet coreSet;
+    coreSet.set(0);
+    Engine::StartSequence startSequence(coreSet);
+    startSequence.addActor<BenchActor>(0, std::make_pair(results, &doneFlag));
+    Engine engine(startSequence);
+    for (; !doneFlag; threadSleep())
+    {
+    }
+    cout << "handler-count  lookup(ns/dispatch)" << endl;
+    for (BenchResult *result = results; result->handlerCount != 0; ++result)
+    {
+        cout << setw(13) << result->handlerCount << setw(21) << fixed << setprecision(1) << result->lookupLatency
+             << endl;
+    }
+}
+/**
+ * Times the dispatch of the first and last of 8 events, declared by a TypedActor versus registered.
+ */
+struct TypedBenchActor : TypedActor<TypedBenchActor, BenchEvent<0>, BenchEvent<1>, BenchEvent<2>, BenchEvent<3>,
+                                    BenchEvent<4>, BenchEvent<5>, BenchEvent<6>, BenchEvent<7>>,
+                         Actor::Callback
+{
+    double *const results; // first typed, last typed, first registered, last registered
+    volatile bool &doneFlag;
+    uint64_t handlerCallCount;
+    TypedBenchActor(std::pair<double *, volatile bool *> presults)
+        : results(presults.first), doneFlag(*presults.second), handlerCallCount(0)
+    {
+        registerCallback(*this);
+    }
+    template <int I> void onEvent(const BenchEvent<I> &) { ++handlerCallCount; }
+    struct RegisteredActor : Actor
+    {
+        uint64_t handlerCallCount;
+        RegisteredActor() : handlerCallCount(0)
+        {
+            registerEventHandler<BenchEvent<0>>(*this);
+            registerEventHandler<BenchEvent<1>>(*this);
+            registerEventHandler<BenchEvent<2>>(*this);
+            registerEventHandler<BenchEvent<3>>(*this);
+            registerEventHandler<BenchEvent<4>>(*this);
+            registerEventHandler<BenchEvent<5>>(*this);
+            registerEventHandler<BenchEvent<6>>(*this);
+            registerEventHandler<BenchEvent<7>>(*this);
+        }
+        template <int I> void onEvent(const BenchEvent<I> &) { ++handlerCallCount; }
+    };
+    void onCallback() noexcept
+    {
+        results[0] = benchDispatch<0>(*this);
+        results[1] = benchDispatch<7>(*this);
+        ActorReference<RegisteredActor> registeredActor = newReferencedActor<RegisteredActor>();
+        results[2] = benchDispatch<0>(*registeredActor);
+        results[3] = benchDispatch<7>(*registeredActor);
+        memoryBarrier();
+        doneFlag = true;
+    }
+};
+
+void benchTypedDispatch()
+{
+    double results[4] = {};
+    volatile bool doneFlag = false;
+    Engine::CoreSet coreSet;
+    coreSet.set(0);
+    Engine::StartSequence startSequence(coreSet);
+    startSequence.addActor<TypedBenchActor>(0, std::make_pair(results, &doneFlag));
+    Engine engine(startSequence);
+    for (; !doneFlag; threadSleep())
+    {
+    }
+    cout << "dispatch(ns)  first-event  last-event" << endl;
+    cout << "typed       " << setw(13) << fixed << setprecision(1) << results[0] << setw(12) << results[1] << endl;
+    cout << "registered  " << setw(13) << results[2] << setw(12) << results[3] << endl;
+}
+}
+
+TEST(EventTable, benchLookup) { benchEventTableLookup(); }
+TEST(EventTable, benchTypedDispatch) { benchTypedDispatch(); }
@@ -0,0 +1,144 @@
+/**
+ * @file benchworkerpool.cpp
+ * @brief benchmark of worker-pool throughput with skewed job sizes, least-loaded versus key-affinity routing
+ * @copyright 2019 Scalewatch (www.scalewatch.com). All rights reserved.
+ * Please see accompanying LICENSE file for licensing terms.
+ */
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+#include "simplx_core/engine.h"
+#include "pattern/workerpool.h"
+
+using namespace std;
+using namespace simplx;
+using namespace simplx::workerpool;
+
+// anonymous namespace to prevent link error due to multiple functions with same name
+namespace
+{
+
+const size_t BENCH_JOB_COUNT = 20000;
+const size_t BENCH_WINDOW_SIZE = 256; // jobs in-flight
+const uint32_t BENCH_SMALL_JOB_SIZE = 1000;
+const size_t BENCH_LARGE_JOB_PERIOD = 16; // one large job every 16 jobs
+const uint32_t BENCH_LARGE_JOB_SIZE = 64 * BENCH_SMALL_JOB_SIZE;
+
+struct BenchJob
+{
+    uint32_t size;
+};
+
+struct BenchPool : Service
+{
+    typedef BenchJob Job;
+    typedef uint64_t Result;
+};
+
+struct BenchWorker : Worker<BenchWorker, BenchPool>
+{
+    uint64_t onJob(const BenchJob &job) noexcept
+    {
+        volatile uint64_t ret = 0;
+        for (uint32_t i = 0; i < job.size; ++i)
+        {
+            ret = ret + i;
+        }
+        return ret;
+    }
+};
+
+/**
+ * Keeps BENCH_WINDOW_SIZE jobs in-flight until BENCH_JOB_COUNT jobs completed.
+ */
+struct BenchClient : Actor, Actor::Callback
+{
+    double &result; // jobs per second
+    volatile bool &doneFlag;
+    const bool leastLoadedFlag;
+    Proxy<BenchPool> pool;
+    size_t pushCount;
+    size_t completionCount;
+    Time startTime;
+    BenchClient(std::tuple<double *, volatile bool *, bool> p)
+        : result(*std::get<0>(p)), doneFlag(*std::get<1>(p)), leastLoadedFlag(std::get<2>(p)), pool(*this),
+          pushCount(0), completionCount(0)
+    {
+        registerEventHandler<CompletionEvent<BenchPool>>(*this);
+        registerCallback(*this);
+    }
+    void onCallback() noexcept
+    {
+        if (!pool.isReady())
+        {
+            registerCallback(*this);
+            return;
+        }
+        startTime = HighResolutionTime()();
+        for (size_t i = 0; i < BENCH_WINDOW_SIZE; ++i)
+        {
+            push();
+        }
+    }
+    void onEvent(const CompletionEvent<BenchPool> &)
+    {
+        if (++completionCount == BENCH_JOB_COUNT)
+        {
+            result = (double)BENCH_JOB_COUNT * 1000000000 / (double)(HighResolutionTime()() - startTime).toNanosecond();
+            memoryBarrier();
+            doneFlag = true;
+        }
+        else if (pushCount < BENCH_JOB_COUNT)
+        {
+            push();
+        }
+    }
+    void push()
+    {
+        BenchJob job = {pushCount % BENCH_LARGE_JOB_PERIOD == 0 ? BENCH_LARGE_JOB_SIZE : BENCH_SMALL_JOB_SIZE};
+        if (leastLoadedFlag)
+        {
+            pool.push(job);
+        }
+        else
+        {
+            pool.push(pushCount, job);
+        }
+        ++pushCount;
+    }
+};
+
+double benchWorkerPool(const Engine::CoreSet &coreSet, bool leastLoadedFlag)
+{
+    double result = 0;
+    volatile bool doneFlag = false;
+    Engine::StartSequence startSequence(coreSet);
+    addWorkerPool<BenchPool, BenchWorker>(startSequence, coreSet.at(0), coreSet);
+    startSequence.addActor<BenchClient>(coreSet.at(0), std::make_tuple(&result, &doneFlag, leastLoadedFlag));
+    Engine engine(startSequence);
+    for (; !doneFlag; threadSleep())
+    {
+    }
+    return result;
+}
+
+void benchWorkerPool()
+{
+    Engine::CoreSet coreSet;
+    for (size_t i = 0, coreCount = std::max<size_t>(2, cpuGetCount()); i < coreCount; ++i)
+    {
+        coreSet.set((Engine::CoreId)i);
+    }
+    double keyAffinity = benchWorkerPool(coreSet, false);
+    double leastLoaded = benchWorkerPool(coreSet, true);
+    cout << "worker-count " << coreSet.size() << " cpu-count " << cpuGetCount() << endl;
+    cout << "skewed jobs(jobs/s)  key-affinity  least-loaded" << endl;
+    cout << setw(34) << fixed << setprecision(0) << keyAffinity << setw(14) << leastLoaded << endl;
+}
+} // namespace
+
+TEST(WorkerPool, benchSkewedJobs) { benchWorkerPool(); }
@@ -0,0 +1,114 @@
+/**
+ * @file testactorpool.cpp
+ * @brief test ActorPool acquire/release/recycle
+ * @copyright 2019 Scalewatch (www.scalewatch.com). All rights reserved.
+ * Please see accompanying LICENSE file for licensing terms.
+ */
+
+#include "gtest/gtest.h"
+
+#include "simplx_core/engine.h"
+#include "pattern/actorpool.h"
+
+using namespace std;
+using namespace simplx;
+
+// anonymous namespace to prevent link error due to multiple functions with same name
+namespace
+{
+
+struct PoolCounters
+{
+    size_t constructCount;
+    size_t destroyCount;
+    size_t recycleCount;
+};
+
+struct PooledActor : Actor
+{
+    PoolCounters &counters;
+    int value;
+    PooledActor(PoolCounters *pcounters) : counters(*pcounters), value(0) { ++counters.constructCount; }
+    ~PooledActor() noexcept { ++counters.destroyCount; }
+    void onRecycle() noexcept
+    {
+        ++counters.recycleCount;
+        value = 0;
+    }
+};
+
+static_assert(IsRecyclableActor<PooledActor>::value, "PooledActor implements onRecycle()");
+static_assert(!IsRecyclableActor<Actor>::value, "Actor does not implement onRecycle()");
+
+struct TestActorPool : Actor, Actor::Callback
+{
+    PoolCounters &counters;
+    volatile bool &doneFlag;
+    ActorPool<PooledActor> pool;
+    TestActorPool(std::pair<PoolCounters *, volatile bool *> p)
+        : counters(*p.first), doneFlag(*p.second), pool(*this, 2)
+    {
+        registerCallback(*this);
+    }
+    void onCallback() noexcept
+    {
+        EXPECT_EQ(2u, pool.getCapacity());
+        pool.reserve(1, &counters);
+        EXPECT_EQ(1u, pool.getIdleCount());
+        EXPECT_EQ(1u, pool.getNewCount());
+
+        ActorPool<PooledActor>::ActorReference actor1 = pool.acquire(&counters);
+        ActorPool<PooledActor>::ActorReference actor2 = pool.acquire(&counters);
+        ActorPool<PooledActor>::ActorReference actor3 = pool.acquire(&counters);
+        EXPECT_EQ(0u, pool.getIdleCount());
+        EXPECT_EQ(3u, pool.getNewCount());
+        actor1->value = 1;
+        actor2->value = 2;
+        ActorId actorId2 = actor2->getActorId();
+
+        EXPECT_TRUE(pool.release(actor1));
+        EXPECT_TRUE(pool.release(actor2));
+        EXPECT_FALSE(pool.release(actor3)); // full
+        EXPECT_EQ(2u, pool.getIdleCount());
+        EXPECT_EQ(2u, pool.getRecycleCount());
+        EXPECT_EQ(2u, counters.recycleCount);
+        actor3.reset(); // unreferenced: destroyed
+
+        actor2 = pool.acquire(&counters); // last released
+        EXPECT_EQ(actorId2, actor2->getActorId());
+        EXPECT_EQ(0, actor2->value);
+        EXPECT_EQ(3u, pool.getNewCount());
+
+        pool.setCapacity(0); // remaining idle actor destroyed
+        EXPECT_EQ(0u, pool.getCapacity());
+        EXPECT_EQ(0u, pool.getIdleCount());
+        EXPECT_FALSE(pool.release(actor2));
+        actor2.reset();
+        actor1.reset();
+
+        memoryBarrier();
+        doneFlag = true;
+    }
+};
+
+void testActorPool()
+{
+    PoolCounters counters = {};
+    volatile bool doneFlag = false;
+    {
+        Engine::CoreSet coreSet;
+        coreSet.set(0);
+        Engine::StartSequence startSequence(coreSet);
+        startSequence.addActor<TestActorPool>(0, std::make_pair(&counters, &doneFlag));
+        Engine engine(startSequence);
+        for (; !doneFlag; threadSleep())
+        {
+        }
+    }
+    EXPECT_EQ(3u, counters.constructCount);
+    EXPECT_EQ(3u, counters.destroyCount);
+    EXPECT_EQ(2u, counters.recycleCount);
+}
+} // namespace
+
+TEST(ActorPool, acquireRelease) { testActorPool(); }
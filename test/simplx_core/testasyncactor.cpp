@@ -11,6 +11,8 @@
 
 #include "testutil.h"
 
+#include "simplx_core/typedactor.h"
+
 using namespace std;
 using namespace simplx;
 
@@ -802,6 +804,162 @@ void testLoopPerformanceCounter()
         TestLoopPerformanceNeutralActor::PerformanceCounters(1, 0, 0));
 }
 
+struct TestTypedActor
+{
+    struct EventA : Actor::Event
+    {
+    };
+    struct EventB : Actor::Event
+    {
+        const unsigned value;
+        EventB(unsigned pvalue) : value(pvalue) {}
+    };
+    struct EventC : Actor::Event
+    {
+    };
+    struct Shared
+    {
+        Actor::ActorId receiverActorId;
+        volatile unsigned eventACount;
+        volatile unsigned eventBValueSum;
+        volatile unsigned eventCCount;
+        volatile bool registeredFlag; // isRegisteredEventHandler<EventA>()
+        Shared() : eventACount(0), eventBValueSum(0), eventCCount(0), registeredFlag(true) {}
+    };
+    /**
+     * Declares EventA and EventB, and registers EventC at run time.
+     */
+    struct ReceiverActor : TypedActor<ReceiverActor, EventA, EventB>
+    {
+        Shared &shared;
+        ReceiverActor(Shared *pshared) : shared(*pshared)
+        {
+            shared.receiverActorId = getActorId();
+            shared.registeredFlag = isRegisteredEventHandler<EventA>();
+            registerEventHandler<EventC>(*this);
+        }
+        void onEvent(const EventA &) { ++shared.eventACount; }
+        void onEvent(const EventB &event) { shared.eventBValueSum += event.value; }
+        void onEvent(const EventC &) { ++shared.eventCCount; }
+    };
+    struct SenderActor : Actor, Actor::Callback
+    {
+        Shared &shared;
+        SenderActor(Shared *pshared) : shared(*pshared) { registerCallback(*this); }
+        void onCallback() noexcept
+        {
+            Event::Pipe pipe(*this, shared.receiverActorId);
+            pipe.push<EventA>();
+            pipe.push<EventB>(2u);
+            pipe.push<EventC>();
+            pipe.push<EventB>(3u);
+        }
+    };
+};
+
+void testTypedActor()
+{
+    for (Engine::CoreId senderCoreId = 0; senderCoreId < 2; ++senderCoreId)
+    {
+        const Time deadline = HighResolutionTime()() + Time::Second(5);
+        TestTypedActor::Shared shared;
+        Engine::StartSequence startSequence;
+        startSequence.addActor<TestTypedActor::ReceiverActor>(0, &shared);
+        startSequence.addActor<TestTypedActor::SenderActor>(senderCoreId, &shared);
+        Engine engine(startSequence);
+        for (; shared.eventCCount == 0 && HighResolutionTime()() < deadline; threadSleep())
+        {
+        }
+        ASSERT_FALSE(shared.registeredFlag);
+        ASSERT_EQ(1u, shared.eventACount);
+        ASSERT_EQ(5u, shared.eventBValueSum);
+        ASSERT_EQ(1u, shared.eventCCount);
+    }
+}
+
+struct TestEventHeader
+{
+    /**
+     * Copies its own header from within its constructors.
+     */
+    struct HeaderEvent : Actor::Event
+    {
+        const Actor::ActorId constructorSourceActorId;
+        const Actor::ActorId constructorDestinationActorId;
+        const Actor::EventId constructorClassId;
+        HeaderEvent()
+            : constructorSourceActorId(getSourceActorId()), constructorDestinationActorId(getDestinationActorId()),
+              constructorClassId(getClassId())
+        {
+        }
+        HeaderEvent(const HeaderEvent &other)
+            : Actor::Event(other), constructorSourceActorId(getSourceActorId()),
+              constructorDestinationActorId(getDestinationActorId()), constructorClassId(getClassId())
+        {
+        }
+    };
+    struct Shared
+    {
+        Actor::ActorId receiverActorId;
+        Actor::ActorId senderActorId;
+        volatile unsigned eventCount;
+        volatile unsigned validHeaderCount;
+        Shared() : eventCount(0), validHeaderCount(0) {}
+    };
+    struct ReceiverActor : Actor
+    {
+        Shared &shared;
+        ReceiverActor(Shared *pshared) : shared(*pshared)
+        {
+            shared.receiverActorId = getActorId();
+            registerEventHandler<HeaderEvent>(*this);
+        }
+        void onEvent(const HeaderEvent &event)
+        {
+            if (event.constructorSourceActorId == shared.senderActorId &&
+                event.constructorDestinationActorId == getActorId() &&
+                event.constructorClassId == Actor::Event::getClassId<HeaderEvent>())
+            {
+                ++shared.validHeaderCount;
+            }
+            ++shared.eventCount;
+        }
+    };
+    struct SenderActor : Actor, Actor::Callback
+    {
+        Shared &shared;
+        SenderActor(Shared *pshared) : shared(*pshared)
+        {
+            shared.senderActorId = getActorId();
+            registerCallback(*this);
+        }
+        void onCallback() noexcept
+        {
+            Event::Pipe pipe(*this, shared.receiverActorId);
+            const HeaderEvent &event = pipe.push<HeaderEvent>();
+            pipe.push<HeaderEvent>(event);
+        }
+    };
+};
+
+void testEventHeader()
+{
+    for (Engine::CoreId senderCoreId = 0; senderCoreId < 2; ++senderCoreId)
+    {
+        const Time deadline = HighResolutionTime()() + Time::Second(5);
+        TestEventHeader::Shared shared;
+        Engine::StartSequence startSequence;
+        startSequence.addActor<TestEventHeader::ReceiverActor>(0, &shared);
+        startSequence.addActor<TestEventHeader::SenderActor>(senderCoreId, &shared);
+        Engine engine(startSequence);
+        for (; shared.eventCount < 2 && HighResolutionTime()() < deadline; threadSleep())
+        {
+        }
+        ASSERT_EQ(2u, shared.eventCount);
+        ASSERT_EQ(2u, shared.validHeaderCount);
+    }
+}
+
 } // namespace anonymous
 
 TEST(Actor, undelivered) { testUndelivered(); }
@@ -809,3 +967,5 @@ TEST(Actor, actorReference) { testActorReference(); }
 TEST(Actor, actorMultipleReference) { testActorMultipleReference(); }
 TEST(Actor, detectionOfEventLoopEnd) { testDetectionOfEventLoopEnd(); }
 TEST(Actor, loopPerformanceCounter) { testLoopPerformanceCounter(); }
+TEST(Actor, typedActor) { testTypedActor(); }
+TEST(Actor, eventHeader) { testEventHeader(); }
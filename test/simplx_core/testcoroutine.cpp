@@ -0,0 +1,220 @@
+/**
+ * @file testcoroutine.cpp
+ * @brief test C++20 coroutine request/response between actors
+ * @copyright 2019 Scalewatch (www.scalewatch.com). All rights reserved.
+ * Please see accompanying LICENSE file for licensing terms.
+ */
+
+#include "gtest/gtest.h"
+
+#include "simplx_core/engine.h"
+#include "pattern/coroutine.h"
+#include "pattern/timer/timeractor.h"
+
+using namespace std;
+using namespace simplx;
+using namespace simplx::coroutine;
+
+// anonymous namespace to prevent link error due to multiple functions with same name
+namespace
+{
+
+const int TEST_COROUTINE_COUNT = 10;
+const int TEST_REQUEST_COUNT = 10;
+
+struct SquareRequestEvent : RequestEvent
+{
+    const int value;
+    SquareRequestEvent(RequestId requestId, int pvalue) noexcept : RequestEvent(requestId), value(pvalue) {}
+};
+
+struct SquareResponseEvent : ResponseEvent
+{
+    const int value;
+    SquareResponseEvent(RequestId requestId, int pvalue) noexcept : ResponseEvent(requestId), value(pvalue) {}
+};
+
+struct SquareServer : Actor
+{
+    const bool silentFlag;
+    SquareServer(bool psilentFlag = false) : silentFlag(psilentFlag)
+    {
+        registerEventHandler<SquareRequestEvent>(*this);
+    }
+    void onEvent(const SquareRequestEvent &event)
+    {
+        if (!silentFlag)
+        {
+            reply<SquareResponseEvent>(*this, event, event.value * event.value);
+        }
+    }
+};
+
+struct DestroyedServer : SquareServer
+{
+    bool &destroyedFlag;
+    DestroyedServer(bool *pdestroyedFlag) : destroyedFlag(*pdestroyedFlag) { requestDestroy(); }
+    ~DestroyedServer() noexcept { destroyedFlag = true; }
+};
+
+struct TestResult
+{
+    int resultSum;
+    int completionCount;
+    bool undeliveredFlag;
+    bool timeoutFlag;
+};
+
+/**
+ * Runs TEST_COROUTINE_COUNT concurrent coroutines, each one awaiting TEST_REQUEST_COUNT sequential requests.
+ */
+struct TestRequester : Requester
+{
+    TestResult &result;
+    volatile bool &doneFlag;
+    ActorReference<SquareServer> server;
+    TestRequester(std::pair<TestResult *, volatile bool *> p)
+        : result(*p.first), doneFlag(*p.second), server(newReferencedActor<SquareServer>())
+    {
+        for (int i = 0; i < TEST_COROUTINE_COUNT; ++i)
+        {
+            spawn(run(i));
+        }
+    }
+    Task run(int index)
+    {
+        RequestPipe pipe(*this, server->getActorId());
+        for (int i = 0; i < TEST_REQUEST_COUNT; ++i)
+        {
+            int value = index * TEST_REQUEST_COUNT + i;
+            const SquareResponseEvent &response = co_await pipe.request<SquareRequestEvent, SquareResponseEvent>(value);
+            EXPECT_EQ(value * value, response.value);
+            result.resultSum += response.value;
+        }
+        if (++result.completionCount == TEST_COROUTINE_COUNT)
+        {
+            memoryBarrier();
+            doneFlag = true;
+        }
+    }
+};
+
+/**
+ * Requests a destroyed actor, once it is destroyed.
+ */
+struct TestUndeliveredRequester : Requester, Actor::Callback
+{
+    TestResult &result;
+    volatile bool &doneFlag;
+    bool destroyedFlag;
+    const ActorId destroyedServerId;
+    TestUndeliveredRequester(std::pair<TestResult *, volatile bool *> p)
+        : result(*p.first), doneFlag(*p.second), destroyedFlag(false),
+          destroyedServerId(newReferencedActor<DestroyedServer>(&destroyedFlag)->getActorId())
+    {
+        registerCallback(*this);
+    }
+    void onCallback() noexcept
+    {
+        if (!destroyedFlag)
+        {
+            registerCallback(*this);
+        }
+        else
+        {
+            spawn(run());
+        }
+    }
+    Task run()
+    {
+        RequestPipe pipe(*this, destroyedServerId);
+        try
+        {
+            co_await pipe.request<SquareRequestEvent, SquareResponseEvent>(1);
+        }
+        catch (const UndeliveredException &)
+        {
+            result.undeliveredFlag = true;
+        }
+        memoryBarrier();
+        doneFlag = true;
+    }
+};
+
+struct TestTimeoutRequester : Requester
+{
+    TestResult &result;
+    volatile bool &doneFlag;
+    ActorReference<SquareServer> server;
+    TestTimeoutRequester(std::pair<TestResult *, volatile bool *> p)
+        : result(*p.first), doneFlag(*p.second), server(newReferencedActor<SquareServer>(true))
+    {
+        spawn(run());
+    }
+    Task run()
+    {
+        RequestPipe pipe(*this, server->getActorId());
+        pipe.setTimeout(Time::Millisecond(10));
+        try
+        {
+            co_await pipe.request<SquareRequestEvent, SquareResponseEvent>(1);
+        }
+        catch (const TimeoutException &)
+        {
+            result.timeoutFlag = true;
+        }
+        memoryBarrier();
+        doneFlag = true;
+    }
+};
+
+void waitDone(volatile bool &doneFlag)
+{
+    for (Time deadline = HighResolutionTime()() + Time::Second(10); !doneFlag && HighResolutionTime()() < deadline;
+         threadSleep())
+    {
+    }
+    EXPECT_TRUE(doneFlag);
+}
+} // namespace
+
+TEST(Coroutine, response)
+{
+    TestResult result = {0, 0, false, false};
+    volatile bool doneFlag = false;
+    Engine::CoreSet coreSet;
+    coreSet.set(0);
+    Engine::StartSequence startSequence(coreSet);
+    startSequence.addActor<TestRequester>(0, std::make_pair(&result, &doneFlag));
+    Engine engine(startSequence);
+    waitDone(doneFlag);
+    const int n = TEST_COROUTINE_COUNT * TEST_REQUEST_COUNT;
+    EXPECT_EQ(n * (n - 1) * (2 * n - 1) / 6, result.resultSum);
+}
+
+TEST(Coroutine, undelivered)
+{
+    TestResult result = {0, 0, false, false};
+    volatile bool doneFlag = false;
+    Engine::CoreSet coreSet;
+    coreSet.set(0);
+    Engine::StartSequence startSequence(coreSet);
+    startSequence.addActor<TestUndeliveredRequester>(0, std::make_pair(&result, &doneFlag));
+    Engine engine(startSequence);
+    waitDone(doneFlag);
+    EXPECT_TRUE(result.undeliveredFlag);
+}
+
+TEST(Coroutine, timeout)
+{
+    TestResult result = {0, 0, false, false};
+    volatile bool doneFlag = false;
+    Engine::CoreSet coreSet;
+    coreSet.set(0);
+    Engine::StartSequence startSequence(coreSet);
+    startSequence.addServiceActor<service::Timer, timer::TimerActor>(0);
+    startSequence.addActor<TestTimeoutRequester>(0, std::make_pair(&result, &doneFlag));
+    Engine engine(startSequence);
+    waitDone(doneFlag);
+    EXPECT_TRUE(result.timeoutFlag);
+}
@@ -0,0 +1,321 @@
+/**
+ * @file testmigration.cpp
+ * @brief test actor migration between cores, requested or balanced
+ * @copyright 2019 Scalewatch (www.scalewatch.com). All rights reserved.
+ * Please see accompanying LICENSE file for licensing terms.
+ */
+
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+
+#include "simplx_core/engine.h"
+#include "pattern/migration.h"
+
+using namespace std;
+using namespace simplx;
+using namespace simplx::migration;
+
+// anonymous namespace to prevent link error due to multiple functions with same name
+namespace
+{
+
+const uint64_t TEST_INCREMENT_COUNT = 10000;
+const uint64_t TEST_INCREMENT_BURST = 10;
+
+struct IncrementEvent : Actor::Event
+{
+};
+struct ReadEvent : Actor::Event
+{
+};
+struct StopEvent : Actor::Event
+{
+};
+struct ValueEvent : Actor::Event
+{
+    const uint64_t value;
+    const Actor::CoreId coreId;
+    ValueEvent(uint64_t pvalue, Actor::CoreId pcoreId) noexcept : value(pvalue), coreId(pcoreId) {}
+};
+
+struct CounterState
+{
+    uint64_t value;
+    bool failRestoreFlag; // restoring on another core than 0 throws
+    CounterState(bool pfailRestoreFlag = false) noexcept : value(0), failRestoreFlag(pfailRestoreFlag) {}
+};
+
+struct Counter : Migratable<Counter, CounterState>
+{
+    uint64_t value;
+    const bool failRestoreFlag;
+    Counter(const CounterState &state) : value(state.value), failRestoreFlag(state.failRestoreFlag)
+    {
+        if (failRestoreFlag && getCore() != 0)
+        {
+            throw std::runtime_error("Counter restore failure");
+        }
+        registerEventHandler<IncrementEvent>(*this);
+        registerEventHandler<ReadEvent>(*this);
+        registerEventHandler<StopEvent>(*this);
+    }
+    void onMigrationSerialize(CounterState &state) const noexcept
+    {
+        state.value = value;
+        state.failRestoreFlag = failRestoreFlag;
+    }
+    void onEvent(const IncrementEvent &) { ++value; }
+    void onEvent(const ReadEvent &event)
+    {
+        Event::Pipe(*this, event.getSourceActorId()).push<ValueEvent>(value, getCore());
+    }
+    void onEvent(const StopEvent &) { requestDestroy(); }
+};
+
+struct TestResult
+{
+    uint64_t value;
+    Actor::CoreId coreId;
+    bool migratedFlag;
+};
+
+/**
+ * Keeps incrementing a counter while it migrates from core 0 to core 1: returned increments are resent to the
+ * migrated counter, none must be lost.
+ */
+struct TestRequestedMigration : Actor, Actor::Callback
+{
+    TestResult &result;
+    volatile bool &doneFlag;
+    ActorId counterId;
+    uint64_t sentCount;
+    uint64_t pendingCount;
+    bool pendingReadFlag;
+    TestRequestedMigration(std::pair<TestResult *, volatile bool *> p)
+        : result(*p.first), doneFlag(*p.second), counterId(newUnreferencedActor<Counter>(CounterState())), sentCount(0),
+          pendingCount(0), pendingReadFlag(false)
+    {
+        referenceLocalActor<Counter>(counterId)->registerMigrationNotification(getActorId());
+        registerEventHandler<MigratedEvent>(*this);
+        registerEventHandler<ValueEvent>(*this);
+        registerUndeliveredEventHandler<IncrementEvent>(*this);
+        registerUndeliveredEventHandler<ReadEvent>(*this);
+        registerCallback(*this);
+    }
+    void onCallback() noexcept
+    {
+        Event::Pipe pipe(*this, counterId);
+        if (sentCount == TEST_INCREMENT_COUNT)
+        {
+            if (result.migratedFlag)
+            {
+                pipe.push<ReadEvent>();
+            }
+            else
+            {
+                registerCallback(*this); // wait for migration
+            }
+            return;
+        }
+        for (uint64_t i = 0; i < TEST_INCREMENT_BURST; ++i)
+        {
+            pipe.push<IncrementEvent>();
+        }
+        sentCount += TEST_INCREMENT_BURST;
+        if (sentCount == TEST_INCREMENT_COUNT / 2)
+        {
+            referenceLocalActor<Counter>(counterId)->migrate(1);
+        }
+        registerCallback(*this);
+    }
+    void onUndeliveredEvent(const IncrementEvent &event)
+    {
+        if (event.getDestinationActorId() == counterId)
+        {
+            ++pendingCount; // not yet notified
+        }
+        else
+        {
+            Event::Pipe(*this, counterId).push<IncrementEvent>();
+        }
+    }
+    void onUndeliveredEvent(const ReadEvent &event)
+    {
+        if (event.getDestinationActorId() == counterId)
+        {
+            pendingReadFlag = true;
+        }
+        else
+        {
+            Event::Pipe(*this, counterId).push<ReadEvent>();
+        }
+    }
+    void onEvent(const MigratedEvent &event)
+    {
+        ASSERT_EQ(counterId, event.previousActorId);
+        ASSERT_TRUE(event.actorId != null);
+        result.migratedFlag = true;
+        counterId = event.actorId;
+        Event::Pipe pipe(*this, counterId);
+        for (; pendingCount != 0; --pendingCount)
+        {
+            pipe.push<IncrementEvent>();
+        }
+        if (pendingReadFlag)
+        {
+            pipe.push<ReadEvent>();
+        }
+    }
+    void onEvent(const ValueEvent &event)
+    {
+        if (event.value < TEST_INCREMENT_COUNT)
+        {
+            Event::Pipe(*this, counterId).push<ReadEvent>(); // returned increments still in flight
+            return;
+        }
+        result.value = event.value;
+        result.coreId = event.coreId;
+        Event::Pipe(*this, counterId).push<StopEvent>();
+        memoryBarrier();
+        doneFlag = true;
+    }
+};
+
+/**
+ * Keeps core 0 busy incrementing 2 counters, until the balancer migrates one to idle core 1.
+ */
+struct TestBalancedMigration : Actor, Actor::Callback
+{
+    TestResult &result;
+    volatile bool &doneFlag;
+    ActorId counterIds[2];
+    TestBalancedMigration(std::pair<TestResult *, volatile bool *> p) : result(*p.first), doneFlag(*p.second)
+    {
+        for (int i = 0; i < 2; ++i)
+        {
+            counterIds[i] = newUnreferencedActor<Counter>(CounterState());
+            referenceLocalActor<Counter>(counterIds[i])->registerMigrationNotification(getActorId());
+        }
+        referenceLocalActor<Counter>(counterIds[1])->setMigrationWeight(2);
+        registerEventHandler<MigratedEvent>(*this);
+        registerCallback(*this);
+    }
+    void onCallback() noexcept
+    {
+        if (result.migratedFlag)
+        {
+            return;
+        }
+        Event::Pipe pipe(*this);
+        for (int i = 0; i < 2; ++i)
+        {
+            pipe.setDestinationActorId(counterIds[i]);
+            pipe.push<IncrementEvent>(); // silently dropped when returned
+        }
+        registerCallback(*this);
+    }
+    void onEvent(const MigratedEvent &event)
+    {
+        ASSERT_EQ(counterIds[1], event.previousActorId); // heaviest
+        ASSERT_TRUE(event.actorId != null);
+        result.migratedFlag = true;
+        result.coreId = event.actorId.getCore();
+        counterIds[1] = event.actorId;
+        Event::Pipe pipe(*this);
+        for (int i = 0; i < 2; ++i)
+        {
+            pipe.setDestinationActorId(counterIds[i]);
+            pipe.push<StopEvent>();
+        }
+        memoryBarrier();
+        doneFlag = true;
+    }
+};
+
+/**
+ * Requests a migration which fails: the counter must keep its actor-id, core and value, and handle events again.
+ */
+template <bool failRestoreFlag, Actor::CoreId targetCoreId> struct TestFailedMigration : Actor
+{
+    TestResult &result;
+    volatile bool &doneFlag;
+    ActorId counterId;
+    TestFailedMigration(std::pair<TestResult *, volatile bool *> p)
+        : result(*p.first), doneFlag(*p.second), counterId(newUnreferencedActor<Counter>(CounterState(failRestoreFlag)))
+    {
+        referenceLocalActor<Counter>(counterId)->registerMigrationNotification(getActorId());
+        registerEventHandler<MigratedEvent>(*this);
+        registerEventHandler<ValueEvent>(*this);
+        Event::Pipe(*this, counterId).push<IncrementEvent>();
+        referenceLocalActor<Counter>(counterId)->migrate(targetCoreId);
+    }
+    void onEvent(const MigratedEvent &event)
+    {
+        ASSERT_EQ(counterId, event.previousActorId);
+        ASSERT_EQ(counterId, event.actorId);
+        result.migratedFlag = true;
+        Event::Pipe pipe(*this, counterId);
+        pipe.push<IncrementEvent>();
+        pipe.push<ReadEvent>();
+    }
+    void onEvent(const ValueEvent &event)
+    {
+        result.value = event.value;
+        result.coreId = event.coreId;
+        Event::Pipe(*this, counterId).push<StopEvent>();
+        memoryBarrier();
+        doneFlag = true;
+    }
+};
+
+template <class _TestActor> TestResult testMigration(const BalancerPolicy &policy)
+{
+    TestResult result = {0, 0, false};
+    volatile bool doneFlag = false;
+    Engine::CoreSet coreSet;
+    coreSet.set(0);
+    coreSet.set(1);
+    Engine::StartSequence startSequence(coreSet);
+    addBalancer(startSequence, 0, coreSet, policy);
+    startSequence.addActor<_TestActor>(0, std::make_pair(&result, &doneFlag));
+    Engine engine(startSequence);
+    for (Time deadline = HighResolutionTime()() + Time::Second(10); !doneFlag && HighResolutionTime()() < deadline;
+         threadSleep())
+    {
+    }
+    EXPECT_TRUE(doneFlag);
+    return result;
+}
+} // namespace
+
+TEST(Migration, requested)
+{
+    TestResult result = testMigration<TestRequestedMigration>(BalancerPolicy());
+    EXPECT_TRUE(result.migratedFlag);
+    EXPECT_EQ(TEST_INCREMENT_COUNT, result.value);
+    EXPECT_EQ(1u, result.coreId);
+}
+
+TEST(Migration, balanced)
+{
+    TestResult result = testMigration<TestBalancedMigration>(BalancerPolicy(Time::Millisecond(20)));
+    EXPECT_TRUE(result.migratedFlag);
+    EXPECT_EQ(1u, result.coreId);
+}
+
+TEST(Migration, restoreFailure)
+{
+    TestResult result = testMigration<TestFailedMigration<true, 1>>(BalancerPolicy());
+    EXPECT_TRUE(result.migratedFlag);
+    EXPECT_EQ(2u, result.value);
+    EXPECT_EQ(0u, result.coreId);
+}
+
+TEST(Migration, undefinedCore)
+{
+    TestResult result = testMigration<TestFailedMigration<false, 5>>(BalancerPolicy());
+    EXPECT_TRUE(result.migratedFlag);
+    EXPECT_EQ(2u, result.value);
+    EXPECT_EQ(0u, result.coreId);
+}
@@ -0,0 +1,303 @@
+/**
+ * @file testoffload.cpp
+ * @brief test blocking tasks offloaded to the engine executor
+ * @copyright 2019 Scalewatch (www.scalewatch.com). All rights reserved.
+ * Please see accompanying LICENSE file for licensing terms.
+ */
+
+#include "gtest/gtest.h"
+
+#include <stdexcept>
+
+#include "simplx_core/engine.h"
+
+using namespace std;
+using namespace simplx;
+
+// anonymous namespace to prevent link error due to multiple functions with same name
+namespace
+{
+
+const int TEST_TASK_COUNT = 100;
+
+struct SquareTask
+{
+    int value;
+    int operator()() const
+    {
+        threadSleep(Time::Millisecond(1)); // blocking
+        return value * value;
+    }
+};
+
+struct ThrowTask
+{
+    int operator()() const { throw std::runtime_error("offload error"); }
+};
+
+struct WaitTask
+{
+    volatile bool *releaseFlag;
+    void operator()() const
+    {
+        for (; !*releaseFlag; threadSleep())
+        {
+        }
+    }
+};
+
+/**
+ * Result whose copy into the completion event throws while throwCount is not 0.
+ */
+struct ThrowOnCopyResult
+{
+    static int throwCount;
+    int value;
+    ThrowOnCopyResult() : value(0) {}
+    ThrowOnCopyResult(int pvalue) : value(pvalue) {}
+    ThrowOnCopyResult(const ThrowOnCopyResult &other) : value(other.value)
+    {
+        if (throwCount != 0)
+        {
+            --throwCount;
+            throw std::bad_alloc();
+        }
+    }
+    ThrowOnCopyResult &operator=(const ThrowOnCopyResult &) = default;
+};
+
+int ThrowOnCopyResult::throwCount = 0;
+
+struct ThrowOnCopyTask
+{
+    int value;
+    ThrowOnCopyResult operator()() const { return ThrowOnCopyResult(value); }
+};
+
+struct TestExceptionHandler : AsyncExceptionHandler
+{
+    volatile int callbackExceptionCount;
+    TestExceptionHandler() : callbackExceptionCount(0) {}
+    virtual void onCallbackException(Actor *, const std::type_info &, const char *, const char *) noexcept
+    {
+        ++callbackExceptionCount;
+    }
+};
+
+struct TestResult
+{
+    int resultSum;
+    int completionCount;
+    bool tokenFlag;
+    bool exceptionFlag;
+};
+
+/**
+ * Offloads TEST_TASK_COUNT tasks computing a square, plus one throwing an exception.
+ */
+struct TestOffload : Actor
+{
+    TestResult &result;
+    volatile bool &doneFlag;
+    Actor::OffloadToken throwToken;
+    bool usedTokens[TEST_TASK_COUNT + 2];
+    TestOffload(std::pair<TestResult *, volatile bool *> p) : result(*p.first), doneFlag(*p.second), usedTokens()
+    {
+        registerEventHandler<OffloadEvent<int>>(*this);
+        for (int i = 0; i < TEST_TASK_COUNT; ++i)
+        {
+            SquareTask task = {i};
+            OffloadToken token = offload(task);
+            result.tokenFlag &= token != 0 && token <= TEST_TASK_COUNT + 1 && !usedTokens[token];
+            usedTokens[token] = true;
+        }
+        throwToken = offload(ThrowTask());
+    }
+    void onEvent(const OffloadEvent<int> &event)
+    {
+        if (event.token == throwToken)
+        {
+            result.exceptionFlag = event.exception != 0 && strcmp(event.exception, "offload error") == 0;
+        }
+        else
+        {
+            ASSERT_TRUE(event.exception == 0);
+            result.resultSum += event.result;
+        }
+        if (++result.completionCount == TEST_TASK_COUNT + 1)
+        {
+            memoryBarrier();
+            doneFlag = true;
+        }
+    }
+};
+
+/**
+ * Fills the queue of a single thread executor blocked by a task, until a submission is rejected.
+ */
+struct TestOffloadQueueFull : Actor
+{
+    volatile bool &doneFlag;
+    volatile bool releaseFlag;
+    int completionCount;
+    int rejectCount;
+    TestOffloadQueueFull(volatile bool *pdoneFlag)
+        : doneFlag(*pdoneFlag), releaseFlag(false), completionCount(0), rejectCount(0)
+    {
+        registerEventHandler<OffloadEvent<void>>(*this);
+        WaitTask task = {&releaseFlag};
+        offload(task);
+        for (; getEngine().getOffloadCounters().queueSize != 0; threadSleep())
+        {
+        } // blocking task executing
+        offload(task);
+        offload(task);
+        try
+        {
+            offload(task);
+        }
+        catch (const OffloadException &e)
+        {
+            EXPECT_TRUE(e.queueFullFlag);
+            ++rejectCount;
+        }
+        EXPECT_EQ(1, rejectCount);
+        releaseFlag = true;
+    }
+    void onEvent(const OffloadEvent<void> &event)
+    {
+        ASSERT_TRUE(event.exception == 0);
+        if (++completionCount == 3)
+        {
+            memoryBarrier();
+            doneFlag = true;
+        }
+    }
+};
+
+/**
+ * Offloads tasks whose first completion event cannot be pushed.
+ */
+struct TestOffloadCompletionException : Actor
+{
+    static const int TASK_COUNT = 3;
+    volatile bool &doneFlag;
+    int resultSum;
+    int completionCount;
+    TestOffloadCompletionException(volatile bool *pdoneFlag) : doneFlag(*pdoneFlag), resultSum(0), completionCount(0)
+    {
+        registerEventHandler<OffloadEvent<ThrowOnCopyResult>>(*this);
+        for (int i = 1; i <= TASK_COUNT; ++i)
+        {
+            ThrowOnCopyTask task = {i};
+            offload(task);
+        }
+    }
+    void onEvent(const OffloadEvent<ThrowOnCopyResult> &event)
+    {
+        ASSERT_TRUE(event.exception == 0);
+        resultSum += event.result.value;
+        if (++completionCount == TASK_COUNT)
+        {
+            EXPECT_EQ(TASK_COUNT * (TASK_COUNT + 1) / 2, resultSum);
+            memoryBarrier();
+            doneFlag = true;
+        }
+    }
+};
+
+struct TestOffloadDisabled : Actor
+{
+    TestOffloadDisabled(volatile bool *doneFlag)
+    {
+        try
+        {
+            offload(SquareTask());
+        }
+        catch (const OffloadException &e)
+        {
+            EXPECT_FALSE(e.queueFullFlag);
+            *doneFlag = true;
+        }
+    }
+};
+
+void waitDone(volatile bool &doneFlag)
+{
+    for (Time deadline = HighResolutionTime()() + Time::Second(10); !doneFlag && HighResolutionTime()() < deadline;
+         threadSleep())
+    {
+    }
+    EXPECT_TRUE(doneFlag);
+}
+} // namespace
+
+TEST(Offload, completion)
+{
+    TestResult result = {0, 0, true, false};
+    volatile bool doneFlag = false;
+    Engine::CoreSet coreSet;
+    coreSet.set(0);
+    Engine::StartSequence startSequence(coreSet);
+    startSequence.setOffloadPolicy(EngineOffloadPolicy(2));
+    startSequence.addActor<TestOffload>(0, std::make_pair(&result, &doneFlag));
+    Engine engine(startSequence);
+    waitDone(doneFlag);
+    EXPECT_EQ(TEST_TASK_COUNT, result.completionCount - 1);
+    EXPECT_EQ(TEST_TASK_COUNT * (TEST_TASK_COUNT - 1) * (2 * TEST_TASK_COUNT - 1) / 6, result.resultSum);
+    EXPECT_TRUE(result.tokenFlag);
+    EXPECT_TRUE(result.exceptionFlag);
+    Engine::OffloadCounters counters = engine.getOffloadCounters();
+    EXPECT_EQ((uint64_t)TEST_TASK_COUNT + 1, counters.submitCount);
+    EXPECT_EQ((uint64_t)TEST_TASK_COUNT + 1, counters.executeCount);
+    EXPECT_EQ(0u, counters.rejectCount);
+    EXPECT_EQ(0u, counters.queueSize);
+    EXPECT_LT(0u, counters.queueHighWatermark);
+    EXPECT_LT(0, counters.executeTime.toNanosecond());
+}
+
+TEST(Offload, queueFull)
+{
+    volatile bool doneFlag = false;
+    Engine::CoreSet coreSet;
+    coreSet.set(0);
+    Engine::StartSequence startSequence(coreSet);
+    startSequence.setOffloadPolicy(EngineOffloadPolicy(1, 2));
+    startSequence.addActor<TestOffloadQueueFull>(0, &doneFlag);
+    Engine engine(startSequence);
+    waitDone(doneFlag);
+    Engine::OffloadCounters counters = engine.getOffloadCounters();
+    EXPECT_EQ(3u, counters.submitCount);
+    EXPECT_EQ(1u, counters.rejectCount);
+    EXPECT_EQ(2u, counters.queueHighWatermark);
+}
+
+TEST(Offload, completionException)
+{
+    volatile bool doneFlag = false;
+    TestExceptionHandler exceptionHandler;
+    ThrowOnCopyResult::throwCount = 1;
+    Engine::CoreSet coreSet;
+    coreSet.set(0);
+    Engine::StartSequence startSequence(coreSet);
+    startSequence.setExceptionHandler(exceptionHandler);
+    startSequence.setOffloadPolicy(EngineOffloadPolicy(2));
+    startSequence.addActor<TestOffloadCompletionException>(0, &doneFlag);
+    Engine engine(startSequence);
+    waitDone(doneFlag);
+    EXPECT_EQ(0, ThrowOnCopyResult::throwCount);
+    EXPECT_EQ(1, exceptionHandler.callbackExceptionCount);
+    EXPECT_EQ((uint64_t)TestOffloadCompletionException::TASK_COUNT, engine.getOffloadCounters().executeCount);
+}
+
+TEST(Offload, disabled)
+{
+    volatile bool doneFlag = false;
+    Engine::CoreSet coreSet;
+    coreSet.set(0);
+    Engine::StartSequence startSequence(coreSet);
+    startSequence.addActor<TestOffloadDisabled>(0, &doneFlag);
+    Engine engine(startSequence);
+    EXPECT_TRUE(doneFlag);
+    EXPECT_EQ(0u, engine.getOffloadCounters().submitCount);
+}